@@ -16,7 +16,8 @@
  *
  * This file contains a circularly linked list implementation.
  *
- * clist_insert(), clist_remove_head() and clist_advance() take constant time.
+ * clist_insert(), clist_lpush(), clist_remove_head() and clist_advance() take
+ * constant time, clist_remove() takes linear time.
  *
  * Each list is represented as a "clist_node_t". It's only member, the "next"
  * pointer, points to the last entry in the list, whose "next" pointer points to
@@ -68,6 +69,25 @@ static inline void clist_insert(clist_node_t *list, clist_node_t *new_node)
     list->next = new_node;
 }
 
+/**
+ * @brief inserts *new_node* as the first element of *list*
+ *
+ * @param[in,out]   list        Ptr to clist
+ * @param[in,out]   new_node    Node which gets inserted.
+ *                              Must not be NULL.
+ */
+static inline void clist_lpush(clist_node_t *list, clist_node_t *new_node)
+{
+    if (list->next) {
+        new_node->next = list->next->next;
+        list->next->next = new_node;
+    }
+    else {
+        new_node->next = new_node;
+        list->next = new_node;
+    }
+}
+
 /**
  * @brief Removes and returns first element from list
  *
@@ -91,6 +111,39 @@ static inline clist_node_t *clist_remove_head(clist_node_t *list)
     }
 }
 
+/**
+ * @brief Removes *node* from *list*
+ *
+ * @param[in,out]   list        Pointer to the *list* to remove *node* from.
+ * @param[in]       node        Node to remove.
+ *
+ * @return  *node*, or NULL if it was not in *list*
+ */
+static inline clist_node_t *clist_remove(clist_node_t *list, clist_node_t *node)
+{
+    if (list->next) {
+        clist_node_t *prev = list->next;
+
+        do {
+            if (prev->next == node) {
+                if (prev == node) {
+                    /* the only element */
+                    list->next = NULL;
+                }
+                else {
+                    prev->next = node->next;
+                    if (list->next == node) {
+                        list->next = prev;
+                    }
+                }
+                return node;
+            }
+            prev = prev->next;
+        } while (prev != list->next);
+    }
+    return NULL;
+}
+
 /**
  * @brief Advances the circle list.
  *
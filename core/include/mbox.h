@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_mbox  Mailboxes
+ * @ingroup     core
+ * @brief       Message queues that are not bound to a thread
+ *
+ * A mailbox is a queue of messages, just like the message queue of a thread
+ * (see @ref msg_init_queue()), but not owned by any thread: any number of
+ * threads can take messages out of it, and any thread or ISR can put messages
+ * into it. A pool of worker threads can thus share one work queue, every
+ * message is handled by the next worker that becomes idle.
+ *
+ * Threads waiting for a message are woken in order of their priority, as are
+ * threads waiting for space in a full mailbox. A mailbox of size 0 has no
+ * queue: a message is handed over directly from the putting to the getting
+ * thread.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static msg_t _queue[8];
+ * static mbox_t _work = MBOX_INIT(_queue, 8);
+ *
+ * static void *_worker(void *arg)
+ * {
+ *     msg_t m;
+ *
+ *     while (1) {
+ *         mbox_get(&_work, &m);
+ *         handle(&m);
+ *     }
+ *     return NULL;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The messages are copied into and out of the mailbox, @ref msg_t::sender_pid
+ * is set to the putting thread (or @ref KERNEL_PID_ISR).
+ *
+ * @{
+ *
+ * @file
+ * @brief       Mailbox API
+ */
+
+#ifndef MBOX_H
+#define MBOX_H
+
+#include "list.h"
+#include "cib.h"
+#include "msg.h"
+#include "sched.h"  /* for thread_t typedef */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Mailbox struct definition
+ */
+typedef struct {
+    list_node_t readers;    /**< threads waiting for a message          */
+    list_node_t writers;    /**< threads waiting for space in the queue */
+    cib_t cib;              /**< cib for the message queue              */
+    msg_t *msg_array;       /**< the message queue                      */
+} mbox_t;
+
+/**
+ * @brief   Static initializer for mbox_t
+ *
+ * @param[in]   queue       array of msg_t used as queue
+ * @param[in]   queue_size  number of msg_t objects in queue, must be a power
+ *                          of two or 0
+ */
+#define MBOX_INIT(queue, queue_size) { { NULL }, { NULL }, CIB_INIT(queue_size), queue }
+
+/**
+ * @brief   Initialize mbox object
+ *
+ * @param[out]  mbox        mbox object to initialize
+ * @param[in]   queue       array of msg_t used as queue
+ * @param[in]   queue_size  number of msg_t objects in queue, must be a power
+ *                          of two or 0
+ */
+static inline void mbox_init(mbox_t *mbox, msg_t *queue, unsigned int queue_size)
+{
+    mbox_t m = MBOX_INIT(queue, queue_size);
+    *mbox = m;
+}
+
+/**
+ * @brief   Add message to mailbox
+ *
+ * If the mailbox is full and @p blocking is set, the calling thread waits
+ * until there is space or a thread takes the message. Must not block in an
+ * ISR.
+ *
+ * @internal
+ *
+ * @param[in]   mbox        ptr to mailbox to operate on
+ * @param[in]   msg         ptr to message that will be copied into mailbox
+ * @param[in]   blocking    block if 1, don't block if 0
+ *
+ * @return  1   if msg could be delivered
+ * @return  0   otherwise
+ */
+int _mbox_put(mbox_t *mbox, msg_t *msg, int blocking);
+
+/**
+ * @brief   Get message from mailbox
+ *
+ * If the mailbox is empty and @p blocking is set, the calling thread waits
+ * until a message is available.
+ *
+ * @internal
+ *
+ * @param[in]   mbox        ptr to mailbox to operate on
+ * @param[out]  msg         ptr to storage for retrieved message
+ * @param[in]   blocking    block if 1, don't block if 0
+ *
+ * @return  1   if msg could be retrieved
+ * @return  0   otherwise
+ */
+int _mbox_get(mbox_t *mbox, msg_t *msg, int blocking);
+
+/**
+ * @brief   Add message to mailbox
+ *
+ * If the mailbox is full, this function will block until space becomes
+ * available. Must not be called from an ISR, use mbox_try_put() there.
+ *
+ * @param[in]   mbox    ptr to mailbox to operate on
+ * @param[in]   msg     ptr to message that will be copied into mailbox
+ */
+static inline void mbox_put(mbox_t *mbox, msg_t *msg)
+{
+    _mbox_put(mbox, msg, 1);
+}
+
+/**
+ * @brief   Add message to mailbox
+ *
+ * If the mailbox is full, this function will return right away. Can be
+ * called from an ISR.
+ *
+ * @param[in]   mbox    ptr to mailbox to operate on
+ * @param[in]   msg     ptr to message that will be copied into mailbox
+ *
+ * @return  1   if msg could be delivered
+ * @return  0   otherwise
+ */
+static inline int mbox_try_put(mbox_t *mbox, msg_t *msg)
+{
+    return _mbox_put(mbox, msg, 0);
+}
+
+/**
+ * @brief   Get message from mailbox
+ *
+ * If the mailbox is empty, this function will block until a message becomes
+ * available.
+ *
+ * @param[in]   mbox    ptr to mailbox to operate on
+ * @param[out]  msg     ptr to storage for retrieved message
+ */
+static inline void mbox_get(mbox_t *mbox, msg_t *msg)
+{
+    _mbox_get(mbox, msg, 1);
+}
+
+/**
+ * @brief   Get message from mailbox
+ *
+ * If the mailbox is empty, this function will return right away. Can be
+ * called from an ISR.
+ *
+ * @param[in]   mbox    ptr to mailbox to operate on
+ * @param[out]  msg     ptr to storage for retrieved message
+ *
+ * @return  1   if msg could be retrieved
+ * @return  0   otherwise
+ */
+static inline int mbox_try_get(mbox_t *mbox, msg_t *msg)
+{
+    return _mbox_get(mbox, msg, 0);
+}
+
+/**
+ * @brief   Get message from mailbox, unless aborted
+ *
+ * Blocks like mbox_get(), but returns without a message if @p *abort is set
+ * before the calling thread waits, or if mbox_abort_get() is called for it
+ * while it waits. Used to implement timeouts, e.g. xtimer_mbox_get_timeout().
+ *
+ * @param[in]   mbox    ptr to mailbox to operate on
+ * @param[out]  msg     ptr to storage for retrieved message
+ * @param[in]   abort   ptr to flag set by the aborting context
+ *
+ * @return  1   if msg could be retrieved
+ * @return  0   if aborted
+ */
+int mbox_get_abortable(mbox_t *mbox, msg_t *msg, volatile int *abort);
+
+/**
+ * @brief   Wakes @p thread waiting in mbox_get_abortable() without a message
+ *
+ * Does nothing if @p thread does not wait for a message of @p mbox. Can be
+ * called from an ISR.
+ *
+ * @param[in]   mbox    ptr to mailbox @p thread waits for
+ * @param[in]   thread  the waiting thread
+ */
+void mbox_abort_get(mbox_t *mbox, thread_t *thread);
+
+/**
+ * @brief   Get number of messages available in mailbox
+ *
+ * Messages of threads waiting for space in the mailbox are not counted.
+ *
+ * @param[in]   mbox    ptr to mailbox to operate on
+ *
+ * @return  number of messages in mailbox
+ */
+static inline unsigned mbox_avail(mbox_t *mbox)
+{
+    return cib_avail(&mbox->cib);
+}
+
+/**
+ * @brief   Get mbox queue size (capacity)
+ *
+ * @param[in]   mbox    ptr to mailbox to operate on
+ *
+ * @return  size of mbox queue (or 0 if there's no queue)
+ */
+static inline unsigned mbox_size(mbox_t *mbox)
+{
+    return mbox->cib.mask + 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* MBOX_H */
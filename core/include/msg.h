@@ -231,6 +231,25 @@ int msg_send(msg_t *m, kernel_pid_t target_pid);
  */
 int msg_try_send(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send a number of messages (non-blocking).
+ *
+ * This function sends the messages in @p m to another thread in one critical
+ * section: the first one is delivered directly if the receiver is waiting,
+ * the others go to its message queue. Sending stops at the first message that
+ * does not fit. This function will never block and can be called from an
+ * interrupt.
+ *
+ * @param[in] m             Array of @p num preallocated ``msg_t`` structures,
+ *                          must not be NULL.
+ * @param[in] num           Number of messages in @p m
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return number of messages sent, starting at the first one in @p m
+ * @return -1, on error (invalid PID)
+ */
+int msg_try_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
 
 /**
  * @brief Send a message to the current thread.
@@ -309,6 +328,21 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive a number of messages.
+ *
+ * This function blocks until a message was received. The queued messages
+ * and the ones of blocked senders are then taken in one critical section, up
+ * to @p max of them, in the order msg_receive() would return them.
+ *
+ * @param[out] m    Array of @p max preallocated ``msg_t`` structures, must
+ *                  not be NULL.
+ * @param[in] max   Maximum number of messages to receive, must not be 0.
+ *
+ * @return  number of messages received, at least 1.
+ */
+int msg_receive_bulk(msg_t *m, unsigned max);
+
 /**
  * @brief Send a message, block until reply received.
  *
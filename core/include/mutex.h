@@ -11,6 +11,17 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * With the `core_mutex_priority_inheritance` module, a thread that blocks on
+ * a mutex lends its priority to the thread holding the mutex, and on to the
+ * holder of the mutex that thread waits for, if any. A holder keeps the
+ * highest priority of the waiters of all mutexes it holds and gets back its
+ * own priority when it has unlocked them. A higher priority thread then
+ * waits for a lower priority one no longer than the latter's critical
+ * sections take, instead of for all threads of priorities in between.
+ * Mutexes unlocked by another thread or in an ISR, as used for signalling,
+ * keep working: the priority of the thread that locked the mutex last is
+ * adjusted.
  * @{
  *
  * @file
@@ -26,6 +37,7 @@
 
 #include "list.h"
 #include "atomic.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -41,13 +53,25 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The thread that locked the mutex last. **Must never be changed
+     *          by the user.**
+     * @internal
+     */
+    kernel_pid_t owner;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Initializes a mutex object.
@@ -58,6 +82,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
@@ -39,6 +39,16 @@
  * happens, threads with the same priority will only switch due to
  * voluntary or implicit context switches.
  *
+ * ## Time slicing:
+ *
+ * With the pseudomodule `sched_round_robin`, threads of the same
+ * priority take turns: a thread that runs for @ref SCHED_RR_QUANTUM
+ * microseconds while others of its priority are runnable is moved to the
+ * end of its run queue. The slices are timed with xtimer, which is only
+ * set while the running priority level has more than one runnable thread,
+ * so the scheduler stays tickless otherwise. @ref SCHED_RR_MASK selects
+ * the priority levels that are sliced.
+ *
  * ## Interrupts:
  *
  * When an interrupt occurs, e.g. because a timer fired or a network
@@ -104,6 +114,25 @@ typedef struct _thread thread_t;
 #define SCHED_PRIO_LEVELS 16
 #endif
 
+#if defined(MODULE_SCHED_ROUND_ROBIN) || defined(DOXYGEN)
+/**
+ * @brief   Time slice of threads of equal priority in microseconds
+ */
+#ifndef SCHED_RR_QUANTUM
+#define SCHED_RR_QUANTUM    (10000U)
+#endif
+
+/**
+ * @brief   Bitmask of the priority levels with time slicing
+ *
+ * Bit n set enables time slicing for threads of priority n, all levels are
+ * sliced by default.
+ */
+#ifndef SCHED_RR_MASK
+#define SCHED_RR_MASK       (0xffffffffU)
+#endif
+#endif
+
 /**
  * @brief   Triggers the scheduler to schedule the next thread
  * @returns 1 if sched_active_thread/sched_active_pid was changed, 0 otherwise.
@@ -119,6 +148,19 @@ int sched_run(void);
  */
 void sched_set_status(thread_t *process, unsigned int status);
 
+/**
+ * @brief   Change the priority of a thread
+ *
+ * A thread on a run queue is moved to the run queue of its new priority, the
+ * active thread stays the head of its run queue. Must be called with
+ * interrupts disabled, the caller has to call sched_switch() if needed.
+ *
+ * @param[in]   thread      Pointer to the thread control block of the
+ *                          targeted thread
+ * @param[in]   priority    The new priority of the thread
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
@@ -175,14 +217,38 @@ extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 NORETURN void sched_task_exit(void);
 
 #ifdef MODULE_SCHEDSTATISTICS
+#include "cpu_conf.h"
+
+#ifndef HAVE_SCHEDSTAT_CLOCK
+/**
+ * @brief   Frequency of the clock used for the scheduler statistics
+ *
+ * CPUs with a clock that is cheaper to read or finer grained than xtimer
+ * (e.g. a cycle counter) define `HAVE_SCHEDSTAT_CLOCK` and this frequency
+ * in their cpu_conf.h and implement schedstat_clock(). Otherwise xtimer is
+ * used.
+ */
+#define SCHEDSTAT_CLOCK_HZ  (1000000LU)
+#endif
+
 /**
  *  Scheduler statistics
  */
 typedef struct {
-    unsigned int laststart;         /**< Time stamp of the last time this thread was
+    uint64_t laststart;             /**< Time stamp of the last time this thread was
                                          scheduled to run */
+    uint64_t runnable_since;        /**< Time stamp of the last time this thread
+                                         was put on the run queue, 0 if it was
+                                         scheduled since */
+    uint64_t runtime_ticks;         /**< The total runtime of this thread in ticks */
+    uint64_t irq_off_ticks;         /**< Ticks this thread ran with interrupts
+                                         disabled, if supported by the CPU */
     unsigned int schedules;         /**< How often the thread was scheduled to run */
-    unsigned long runtime_ticks;    /**< The total runtime of this thread in ticks */
+    unsigned int voluntary;         /**< How often the thread blocked or slept */
+    unsigned int involuntary;       /**< How often the thread was preempted or
+                                         yielded while still runnable */
+    uint32_t max_latency;           /**< Maximum ticks the thread waited on the
+                                         run queue before it was scheduled */
 } schedstat;
 
 /**
@@ -190,6 +256,13 @@ typedef struct {
  */
 extern schedstat sched_pidlist[KERNEL_PID_LAST + 1];
 
+/**
+ * @brief   Returns the current time of the scheduler statistics clock
+ *
+ * @return  ticks of @ref SCHEDSTAT_CLOCK_HZ since an arbitrary point in time
+ */
+uint64_t schedstat_clock(void);
+
 /**
  *  @brief  Register a callback that will be called on every scheduler run
  *
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_mbox
+ * @{
+ *
+ * @file
+ * @brief       mailbox implementation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <assert.h>
+
+#include "mbox.h"
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#ifdef MODULE_CORE_MBOX
+
+static thread_t *_pop_waiter(list_node_t *list)
+{
+    list_node_t *next = list_remove_head(list);
+
+    if (next == NULL) {
+        return NULL;
+    }
+    return container_of((clist_node_t*)next, thread_t, rq_entry);
+}
+
+static void _wake_waiter(thread_t *thread, unsigned irqstate)
+{
+    DEBUG("mbox: Thread %" PRIkernel_pid ": _wake_waiter(): waking up "
+          "waiting thread %" PRIkernel_pid "\n", sched_active_pid, thread->pid);
+
+    uint16_t process_priority = thread->priority;
+    sched_set_status(thread, STATUS_PENDING);
+
+    irq_restore(irqstate);
+    sched_switch(process_priority);
+}
+
+static void _wait(list_node_t *wait_list, msg_t *msg, unsigned irqstate)
+{
+    thread_t *me = (thread_t*) sched_active_thread;
+
+    DEBUG("mbox: Thread %" PRIkernel_pid " _wait(): going blocked.\n",
+          me->pid);
+
+    me->wait_data = (void *) msg;
+    sched_set_status(me, STATUS_MBOX_BLOCKED);
+    thread_add_to_list(wait_list, me);
+
+    irq_restore(irqstate);
+    thread_yield_higher();
+}
+
+int _mbox_put(mbox_t *mbox, msg_t *msg, int blocking)
+{
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned irqstate = irq_disable();
+
+    msg->sender_pid = sender_pid;
+
+    /* readers only wait if the queue is empty: hand the message over */
+    thread_t *reader = _pop_waiter(&mbox->readers);
+    if (reader) {
+        *((msg_t *) reader->wait_data) = *msg;
+        _wake_waiter(reader, irqstate);
+        return 1;
+    }
+
+    int index = cib_put(&mbox->cib);
+    if (index >= 0) {
+        mbox->msg_array[index] = *msg;
+        irq_restore(irqstate);
+        return 1;
+    }
+
+    if (!blocking) {
+        irq_restore(irqstate);
+        return 0;
+    }
+
+    assert(!irq_is_in());
+    _wait(&mbox->writers, msg, irqstate);
+
+    /* a reader took the message, see _get() */
+    return 1;
+}
+
+static int _get(mbox_t *mbox, msg_t *msg, int blocking, volatile int *abort)
+{
+    unsigned irqstate = irq_disable();
+    thread_t *writer;
+
+    int index = cib_get(&mbox->cib);
+    if (index >= 0) {
+        *msg = mbox->msg_array[index];
+
+        /* writers only wait if the queue is full: move the message of the
+         * first one into the freed space */
+        writer = _pop_waiter(&mbox->writers);
+        if (writer) {
+            index = cib_put(&mbox->cib);
+            mbox->msg_array[index] = *((msg_t *) writer->wait_data);
+            _wake_waiter(writer, irqstate);
+        }
+        else {
+            irq_restore(irqstate);
+        }
+        return 1;
+    }
+
+    /* mailbox without queue: take the message of a waiting writer */
+    writer = _pop_waiter(&mbox->writers);
+    if (writer) {
+        *msg = *((msg_t *) writer->wait_data);
+        _wake_waiter(writer, irqstate);
+        return 1;
+    }
+
+    if (!blocking || (abort && *abort)) {
+        irq_restore(irqstate);
+        return 0;
+    }
+
+    _wait(&mbox->readers, msg, irqstate);
+
+    /* mbox_abort_get() clears wait_data, a writer copies the message */
+    return (sched_active_thread->wait_data != NULL);
+}
+
+int _mbox_get(mbox_t *mbox, msg_t *msg, int blocking)
+{
+    return _get(mbox, msg, blocking, NULL);
+}
+
+int mbox_get_abortable(mbox_t *mbox, msg_t *msg, volatile int *abort)
+{
+    return _get(mbox, msg, 1, abort);
+}
+
+void mbox_abort_get(mbox_t *mbox, thread_t *thread)
+{
+    unsigned irqstate = irq_disable();
+
+    if ((thread->status == STATUS_MBOX_BLOCKED) &&
+        list_remove(&mbox->readers, (list_node_t *) &thread->rq_entry)) {
+        thread->wait_data = NULL;
+        _wake_waiter(thread, irqstate);
+        return;
+    }
+
+    irq_restore(irqstate);
+}
+
+#endif /* MODULE_CORE_MBOX */
@@ -75,6 +75,50 @@ int msg_try_send(msg_t *m, kernel_pid_t target_pid)
     return _msg_send(m, target_pid, false, irq_disable());
 }
 
+int msg_try_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_try_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t*) sched_threads[target_pid];
+    unsigned n = 0;
+    int woken = 0;
+
+    if (target == NULL) {
+        DEBUG("msg_try_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_try_send_bulk: Direct msg copy from %" PRIkernel_pid " to %"
+              PRIkernel_pid ".\n", sender_pid, target_pid);
+        m[0].sender_pid = sender_pid;
+        *((msg_t*) target->wait_data) = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        woken = 1;
+        n++;
+    }
+    for (; n < num; n++) {
+        m[n].sender_pid = sender_pid;
+        if (!queue_msg(target, &m[n])) {
+            break;
+        }
+    }
+
+    uint16_t target_prio = target->priority;
+    irq_restore(state);
+    if (woken) {
+        sched_switch(target_prio);
+    }
+    return n;
+}
+
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state)
 {
 #ifdef DEVELHELP
@@ -360,6 +404,73 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_receive_bulk(msg_t *m, unsigned max)
+{
+    assert(max > 0);
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t*) sched_active_thread;
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+    int queue_index;
+
+    DEBUG("msg_receive_bulk: %" PRIkernel_pid ": up to %u messages.\n",
+          me->pid, max);
+
+    /* queued messages are older than the ones of blocked senders */
+    while ((n < max) && me->msg_array &&
+           ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+        m[n++] = me->msg_array[queue_index];
+    }
+
+    /* senders that don't fit into m get the just freed queue space */
+    while (me->msg_waiters.next) {
+        thread_t *sender = container_of((clist_node_t*)me->msg_waiters.next,
+                                        thread_t, rq_entry);
+        msg_t *dest;
+
+        if (n < max) {
+            dest = &m[n++];
+        }
+        else if (me->msg_array &&
+                 ((queue_index = cib_put(&(me->msg_queue))) >= 0)) {
+            dest = &me->msg_array[queue_index];
+        }
+        else {
+            break;
+        }
+        list_remove_head(&me->msg_waiters);
+        *dest = *((msg_t*) sender->wait_data);
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    if (n == 0) {
+        DEBUG("msg_receive_bulk(): %" PRIkernel_pid ": No msg. Going blocked.\n",
+              me->pid);
+        me->wait_data = (void *) m;
+        sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+
+        irq_restore(state);
+        thread_yield_higher();
+
+        /* sender copied message */
+        return 1;
+    }
+
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return n;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
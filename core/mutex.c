@@ -37,6 +37,101 @@
 
 #define MUTEX_LOCKED ((void*)-1)
 
+static void _enqueue(mutex_t *mutex, thread_t *thread)
+{
+    if (mutex->queue.next == MUTEX_LOCKED) {
+        mutex->queue.next = (list_node_t*)&thread->rq_entry;
+        mutex->queue.next->next = NULL;
+    }
+    else {
+        thread_add_to_list(&mutex->queue, thread);
+    }
+}
+
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static void _set_priority(thread_t *thread, uint8_t priority)
+{
+    if (thread->priority == priority) {
+        return;
+    }
+    if (thread->status == STATUS_MUTEX_BLOCKED) {
+        /* keep the queue of the mutex the thread waits for sorted */
+        mutex_t *mutex = thread->wait_data;
+
+        list_remove(&mutex->queue, (list_node_t*)&thread->rq_entry);
+        if (!mutex->queue.next) {
+            mutex->queue.next = MUTEX_LOCKED;
+        }
+        thread->priority = priority;
+        _enqueue(mutex, thread);
+    }
+    else {
+        sched_change_priority(thread, priority);
+    }
+}
+
+/* lends priority to the owner of mutex and on along the chain of mutexes
+ * the owners wait for */
+static void _inherit(mutex_t *mutex, uint8_t priority)
+{
+    thread_t *owner;
+
+    while (((owner = (thread_t*)thread_get(mutex->owner)) != NULL) &&
+           (priority < owner->priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: lending priority %" PRIu16 " to %"
+              PRIkernel_pid "\n", sched_active_pid, priority, owner->pid);
+        _set_priority(owner, priority);
+        if (owner->status != STATUS_MUTEX_BLOCKED) {
+            return;
+        }
+        mutex = owner->wait_data;
+    }
+}
+
+/* gives thread the highest priority of its own and of the threads waiting
+ * for mutexes it holds */
+static void _restore(thread_t *thread)
+{
+    uint8_t priority = thread->base_priority;
+
+    /* the waiters are found through the threads: a thread can hold any
+     * number of mutexes, some of them (e.g. the one of xtimer_usleep())
+     * never get unlocked */
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        thread_t *waiter = (thread_t*)sched_threads[pid];
+
+        if ((waiter != NULL) && (waiter != thread) &&
+            (waiter->status == STATUS_MUTEX_BLOCKED) &&
+            (((mutex_t*)waiter->wait_data)->owner == thread->pid) &&
+            (waiter->priority < priority)) {
+            priority = waiter->priority;
+        }
+    }
+    DEBUG("PID[%" PRIkernel_pid "]: priority of %" PRIkernel_pid " back to %"
+          PRIu16 "\n", sched_active_pid, thread->pid, priority);
+    _set_priority(thread, priority);
+}
+
+/* hands mutex over to the thread that locks it next (or to nobody), returns
+ * 1 if the active thread lost priority */
+static int _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    thread_t *owner = (thread_t*)thread_get(mutex->owner);
+    uint8_t active_priority = sched_active_thread->priority;
+
+    mutex->owner = (thread != NULL) ? thread->pid : KERNEL_PID_UNDEF;
+    if ((owner != NULL) && (owner->priority != owner->base_priority)) {
+        _restore(owner);
+    }
+    if ((thread != NULL) && (mutex->queue.next != MUTEX_LOCKED)) {
+        /* the remaining waiters now wait for the new owner */
+        _inherit(mutex, container_of((clist_node_t*)mutex->queue.next,
+                                     thread_t, rq_entry)->priority);
+    }
+    return (sched_active_thread->priority > active_priority);
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -46,6 +141,9 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        mutex->owner = sched_active_pid;
+#endif
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -56,17 +154,15 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         DEBUG("PID[%" PRIkernel_pid "]: Adding node to mutex queue: prio: %"
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
-        if (mutex->queue.next == MUTEX_LOCKED) {
-            mutex->queue.next = (list_node_t*)&me->rq_entry;
-            mutex->queue.next->next = NULL;
-        }
-        else {
-            thread_add_to_list(&mutex->queue, me);
-        }
+        _enqueue(mutex, me);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        me->wait_data = mutex;
+        _inherit(mutex, me->priority);
+#endif
         irq_restore(irqstate);
         thread_yield_higher();
-        /* We were woken up by scheduler. Waker removed us from queue.
-         * We have the mutex now. */
+        /* We were woken up by scheduler. Waker removed us from queue
+         * and made us the owner. We have the mutex now. */
         return 1;
     }
     else {
@@ -91,6 +187,15 @@ void mutex_unlock(mutex_t *mutex)
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        if (_set_owner(mutex, NULL)) {
+            /* the active thread lost its inherited priority, let the
+             * threads it held up run */
+            irq_restore(irqstate);
+            sched_switch(0);
+            return;
+        }
+#endif
         irq_restore(irqstate);
         return;
     }
@@ -106,6 +211,9 @@ void mutex_unlock(mutex_t *mutex)
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
     }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    _set_owner(mutex, process);
+#endif
 
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
@@ -121,6 +229,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     if (mutex->queue.next) {
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+            _set_owner(mutex, NULL);
+#endif
         }
         else {
             list_node_t *next = list_remove_head(&mutex->queue);
@@ -131,6 +242,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+            _set_owner(mutex, process);
+#endif
         }
     }
 
@@ -29,7 +29,7 @@
 #include "irq.h"
 #include "log.h"
 
-#ifdef MODULE_SCHEDSTATISTICS
+#if defined(MODULE_SCHEDSTATISTICS) || defined(MODULE_SCHED_ROUND_ROBIN)
 #include "xtimer.h"
 #endif
 
@@ -56,6 +56,59 @@ static uint32_t runqueue_bitcache = 0;
 #ifdef MODULE_SCHEDSTATISTICS
 static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
+
+#ifndef HAVE_SCHEDSTAT_CLOCK
+uint64_t schedstat_clock(void)
+{
+    return xtimer_now64();
+}
+#endif
+#endif
+
+#ifdef MODULE_SCHED_ROUND_ROBIN
+static xtimer_t _rr_timer;
+static int _rr_armed;
+
+/* more than one thread runnable on a level with time slicing */
+static inline int _rr_sliced(uint16_t prio)
+{
+    clist_node_t *rq = &sched_runqueues[prio];
+
+    return (((uint32_t)SCHED_RR_MASK >> prio) & 1) &&
+           rq->next && (rq->next->next != rq->next);
+}
+
+static void _rr_expired(void *arg)
+{
+    (void)arg;
+    thread_t *active_thread = (thread_t *)sched_active_thread;
+
+    _rr_armed = 0;
+    if (active_thread && (active_thread->status >= STATUS_ON_RUNQUEUE) &&
+        _rr_sliced(active_thread->priority)) {
+        DEBUG("sched: slice of thread %" PRIkernel_pid " expired\n",
+              active_thread->pid);
+        /* the active thread is the head of its run queue, sched_run() picks
+         * the next one when the ISR returns */
+        clist_advance(&sched_runqueues[active_thread->priority]);
+        sched_context_switch_request = 1;
+    }
+}
+
+static void _rr_start(void)
+{
+    _rr_armed = 1;
+    _rr_timer.callback = _rr_expired;
+    xtimer_set(&_rr_timer, SCHED_RR_QUANTUM);
+}
+
+static void _rr_stop(void)
+{
+    if (_rr_armed) {
+        _rr_armed = 0;
+        xtimer_remove(&_rr_timer);
+    }
+}
 #endif
 
 int sched_run(void)
@@ -74,13 +127,26 @@ int sched_run(void)
           (active_thread == NULL) ? KERNEL_PID_UNDEF : active_thread->pid,
           next_thread->pid);
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    /* only tick while the running level has threads to take turns */
+    if (_rr_sliced(nextrq)) {
+        if ((active_thread != next_thread) || !_rr_armed) {
+            /* a thread taking over gets a full quantum */
+            _rr_start();
+        }
+    }
+    else {
+        _rr_stop();
+    }
+#endif
+
     if (active_thread == next_thread) {
         DEBUG("sched_run: done, sched_active_thread was not changed.\n");
         return 0;
     }
 
 #ifdef MODULE_SCHEDSTATISTICS
-    unsigned long time = xtimer_now();
+    uint64_t time = schedstat_clock();
 #endif
 
     if (active_thread) {
@@ -99,15 +165,29 @@ int sched_run(void)
         if (active_stat->laststart) {
             active_stat->runtime_ticks += time - active_stat->laststart;
         }
+        if (active_thread->status >= STATUS_ON_RUNQUEUE) {
+            active_stat->involuntary++;
+            active_stat->runnable_since = time;
+        }
+        else {
+            active_stat->voluntary++;
+        }
 #endif
     }
 
 #ifdef MODULE_SCHEDSTATISTICS
     schedstat *next_stat = &sched_pidlist[next_thread->pid];
+    if (next_stat->runnable_since) {
+        uint64_t latency = time - next_stat->runnable_since;
+        if (latency > next_stat->max_latency) {
+            next_stat->max_latency = (latency > UINT32_MAX) ? UINT32_MAX : latency;
+        }
+        next_stat->runnable_since = 0;
+    }
     next_stat->laststart = time;
     next_stat->schedules++;
     if (sched_cb) {
-        sched_cb(time, next_thread->pid);
+        sched_cb((uint32_t)time, next_thread->pid);
     }
 #endif
 
@@ -135,6 +215,17 @@ void sched_set_status(thread_t *process, unsigned int status)
                   process->pid, process->priority);
             clist_insert(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHEDSTATISTICS
+            sched_pidlist[process->pid].runnable_since = schedstat_clock();
+#endif
+#ifdef MODULE_SCHED_ROUND_ROBIN
+            /* joins the level of the active thread, which keeps running */
+            if (sched_active_thread && !_rr_armed &&
+                (process->priority == sched_active_thread->priority) &&
+                _rr_sliced(process->priority)) {
+                _rr_start();
+            }
+#endif
         }
     }
     else {
@@ -152,6 +243,32 @@ void sched_set_status(thread_t *process, unsigned int status)
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    if (thread->priority == priority) {
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid " from %" PRIu16
+          " to %" PRIu16 ".\n", thread->pid, thread->priority, priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        if (thread == sched_active_thread) {
+            clist_lpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        else {
+            clist_insert(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        runqueue_bitcache |= 1 << priority;
+    }
+
+    thread->priority = priority;
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
@@ -20,6 +20,7 @@
 
 #include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "assert.h"
 #include "thread.h"
@@ -223,8 +224,18 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->priority = priority;
     cb->status = 0;
 
+#ifdef MODULE_SCHEDSTATISTICS
+    /* the pid may have been used by an exited thread before */
+    memset(&sched_pidlist[pid], 0, sizeof(schedstat));
+#endif
+
     cb->rq_entry.next = NULL;
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    cb->wait_data = NULL;
+    cb->base_priority = priority;
+#endif
+
 #ifdef MODULE_CORE_MSG
     cb->wait_data = NULL;
     cb->msg_waiters.next = NULL;
@@ -55,6 +55,14 @@ extern "C" {
  */
 #define NATIVE_ETH_PROTO 0x1234
 
+/**
+ * @brief   Use CLOCK_MONOTONIC of the host for the scheduler statistics
+ * @{
+ */
+#define HAVE_SCHEDSTAT_CLOCK
+#define SCHEDSTAT_CLOCK_HZ      (1000000000LU)
+/** @} */
+
 #if (defined(GNRC_PKTBUF_SIZE)) && (GNRC_PKTBUF_SIZE < 2048)
 #   undef  GNRC_PKTBUF_SIZE
 #   define GNRC_PKTBUF_SIZE     (2048)
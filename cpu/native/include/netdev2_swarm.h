@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     netdev2
+ * @brief       Low-level ethernet driver for a simulated medium shared by
+ *              many native instances
+ * @{
+ *
+ * @file
+ * @brief       Definitions for @ref netdev2 ethernet driver for the medium
+ *              provided by dist/tools/swarm
+ *
+ * Every native instance (with `<id>` given by the `-i` option) exchanges its
+ * frames with the medium through a pair of single-producer single-consumer
+ * rings in the shared memory file `<dir>/node-<id>.ring`, the medium forwards
+ * them to the instance's neighbors. No tap interfaces or root privileges are
+ * needed, and no system call is made per frame.
+ *
+ * The UNIX datagram sockets `<dir>/node-<id>` and `<dir>/medium` only carry
+ * doorbells: a consumer that found its ring empty sets
+ * netdev2_swarm_ring_t::sleeping and the producer rings the doorbell when it
+ * takes that flag back after having added a frame. A busy consumer thus
+ * takes a whole batch of frames for one doorbell. A frame in a ring is its
+ * length as uint16_t in host byte order followed by the frame, wrapping
+ * around at the end of the ring.
+ */
+#ifndef NETDEV2_SWARM_H
+#define NETDEV2_SWARM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sys/un.h>
+
+#include "net/netdev2.h"
+
+#include "net/ethernet/hdr.h"
+
+/**
+ * @brief   Name of the medium's socket in the swarm directory
+ */
+#define NETDEV2_SWARM_MEDIUM    "medium"
+
+/**
+ * @brief   Prefix of the instances' socket names in the swarm directory
+ */
+#define NETDEV2_SWARM_NODE      "node-"
+
+/**
+ * @brief   Suffix of the instances' ring files in the swarm directory
+ */
+#define NETDEV2_SWARM_RING      ".ring"
+
+/**
+ * @brief   Magic number of a ring file
+ */
+#define NETDEV2_SWARM_RING_MAGIC    (0x53575231)
+
+/**
+ * @brief   Size of the frame data of a ring in bytes, must be a power of 2
+ */
+#ifndef NETDEV2_SWARM_RING_SIZE
+#define NETDEV2_SWARM_RING_SIZE     (64U * 1024U)
+#endif
+
+/**
+ * @name    Doorbells
+ * @{
+ */
+#define NETDEV2_SWARM_DOORBELL_ATTACH   'A' /**< ring file was (re-)created */
+#define NETDEV2_SWARM_DOORBELL_DATA     'D' /**< ring is not empty anymore */
+/** @} */
+
+/**
+ * @brief   Frame ring shared with the medium
+ *
+ * @p head and @p tail are free running byte counters, @p head is only
+ * written by the producer and @p tail only by the consumer. They live in
+ * different cache lines.
+ */
+typedef struct {
+    uint32_t head;                      /**< end of the last frame added */
+    uint32_t sleeping;                  /**< consumer waits for a doorbell */
+    uint8_t pad0[56];                   /**< cache line padding */
+    uint32_t tail;                      /**< start of the next frame taken */
+    uint8_t pad1[60];                   /**< cache line padding */
+    uint8_t data[NETDEV2_SWARM_RING_SIZE];  /**< frames */
+} netdev2_swarm_ring_t;
+
+/**
+ * @brief   Layout of a ring file
+ */
+typedef struct {
+    uint32_t magic;                     /**< NETDEV2_SWARM_RING_MAGIC */
+    uint32_t size;                      /**< NETDEV2_SWARM_RING_SIZE */
+    uint8_t pad[56];                    /**< cache line padding */
+    netdev2_swarm_ring_t tx;            /**< instance to medium */
+    netdev2_swarm_ring_t rx;            /**< medium to instance */
+} netdev2_swarm_rings_t;
+
+/**
+ * @brief swarm interface state
+ */
+typedef struct netdev2_swarm {
+    netdev2_t netdev;                   /**< netdev2 internal member */
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)]; /**< socket path */
+    const char *dir;                    /**< swarm directory */
+    int sock_fd;                        /**< host file descriptor for the socket */
+    netdev2_swarm_rings_t *rings;       /**< mapped ring file */
+    uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the interface */
+    uint8_t promiscous;                 /**< Flag for promiscous mode */
+} netdev2_swarm_t;
+
+/**
+ * @brief swarm interface initialization parameters
+ */
+typedef struct {
+    const char *dir;                    /**< Directory of the swarm medium */
+} netdev2_swarm_params_t;
+
+/**
+ * @brief global device struct. driver only supports one device as of now.
+ */
+extern netdev2_swarm_t netdev2_swarm;
+
+/**
+ * @brief Setup netdev2_swarm_t structure.
+ *
+ * @param dev       the preallocated netdev2_swarm device handle to setup
+ * @param params    initialization parameters
+ */
+void netdev2_swarm_setup(netdev2_swarm_t *dev, const netdev2_swarm_params_t *params);
+
+/**
+ * @brief Cleanup swarm resources
+ *
+ * @param dev  the netdev2_swarm device handle to cleanup
+ */
+void netdev2_swarm_cleanup(netdev2_swarm_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+/** @} */
+#endif /* NETDEV2_SWARM_H */
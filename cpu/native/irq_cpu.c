@@ -37,6 +37,7 @@
 
 #include "irq.h"
 #include "cpu.h"
+#include "sched.h"
 
 #include "lpm.h"
 
@@ -135,6 +136,11 @@ void native_print_signals(void)
     }
 }
 
+#ifdef MODULE_SCHEDSTATISTICS
+static uint64_t _irq_off_since;
+static kernel_pid_t _irq_off_pid;
+#endif
+
 /**
  * block signals
  */
@@ -156,6 +162,13 @@ unsigned irq_disable(void)
     prev_state = native_interrupts_enabled;
     native_interrupts_enabled = 0;
 
+#ifdef MODULE_SCHEDSTATISTICS
+    if ((prev_state == 1) && (_native_in_isr == 0)) {
+        _irq_off_since = schedstat_clock();
+        _irq_off_pid = sched_active_pid;
+    }
+#endif
+
     DEBUG("irq_disable(): return\n");
     _native_syscall_leave();
 
@@ -184,6 +197,13 @@ unsigned irq_enable(void)
      * before returning to userspace.
      */
 
+#ifdef MODULE_SCHEDSTATISTICS
+    if ((native_interrupts_enabled == 0) && (_irq_off_since != 0)) {
+        sched_pidlist[_irq_off_pid].irq_off_ticks += schedstat_clock() - _irq_off_since;
+        _irq_off_since = 0;
+    }
+#endif
+
     prev_state = native_interrupts_enabled;
     native_interrupts_enabled = 1;
 
@@ -45,6 +45,7 @@
 #endif
 
 #include <stdlib.h>
+#include <time.h>
 
 #include "irq.h"
 #include "sched.h"
@@ -74,6 +75,19 @@ void thread_print_stack(void)
     return;
 }
 
+#ifdef MODULE_SCHEDSTATISTICS
+uint64_t schedstat_clock(void)
+{
+    struct timespec ts;
+
+    if (real_clock_gettime(CLOCK_MONOTONIC, &ts) == -1) {
+        err(EXIT_FAILURE, "schedstat_clock: clock_gettime");
+    }
+
+    return ((uint64_t)ts.tv_sec * SCHEDSTAT_CLOCK_HZ) + ts.tv_nsec;
+}
+#endif
+
 char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_start, int stacksize)
 {
     char *stk;
@@ -0,0 +1,448 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/*
+ * @ingroup netdev2
+ * @{
+ * @brief   Low-level ethernet driver for the swarm medium
+ * @}
+ */
+#include <assert.h>
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "native_internal.h"
+
+#include "async_read.h"
+
+#include "net/netdev2.h"
+#include "net/netdev2/eth.h"
+#include "net/ethernet.h"
+#include "net/ethernet/hdr.h"
+#include "netdev2_swarm.h"
+#include "net/netopt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* support one swarm interface for now */
+netdev2_swarm_t netdev2_swarm;
+
+/* netdev2 interface */
+static int _init(netdev2_t *netdev);
+static int _send(netdev2_t *netdev, const struct iovec *vector, int n);
+static int _recv(netdev2_t *netdev, char* buf, int n, void *info);
+
+static inline void _isr(netdev2_t *netdev)
+{
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE, NULL);
+    }
+#if DEVELHELP
+    else {
+        puts("netdev2_swarm: _isr(): no event_callback set.");
+    }
+#endif
+}
+
+static int _get(netdev2_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    netdev2_swarm_t *dev = (netdev2_swarm_t *)netdev;
+
+    if (dev != &netdev2_swarm) {
+        return -ENODEV;
+    }
+
+    switch (opt) {
+        case NETOPT_ADDRESS:
+            if (max_len < ETHERNET_ADDR_LEN) {
+                return -EINVAL;
+            }
+            memcpy(value, dev->addr, ETHERNET_ADDR_LEN);
+            return ETHERNET_ADDR_LEN;
+        case NETOPT_PROMISCUOUSMODE:
+            *((bool *)value) = (bool)dev->promiscous;
+            return sizeof(bool);
+        default:
+            return netdev2_eth_get(netdev, opt, value, max_len);
+    }
+}
+
+static int _set(netdev2_t *netdev, netopt_t opt, void *value, size_t value_len)
+{
+    netdev2_swarm_t *dev = (netdev2_swarm_t *)netdev;
+
+    (void)value_len;
+
+    if (dev != &netdev2_swarm) {
+        return -ENODEV;
+    }
+
+    switch (opt) {
+        case NETOPT_ADDRESS:
+            assert(value_len == ETHERNET_ADDR_LEN);
+            memcpy(dev->addr, value, ETHERNET_ADDR_LEN);
+            return 0;
+        case NETOPT_PROMISCUOUSMODE:
+            dev->promiscous = ((bool *)value)[0];
+            return 0;
+        default:
+            return -ENOTSUP;
+    }
+}
+
+static netdev2_driver_t netdev2_driver_swarm = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+/* driver implementation */
+static inline bool _is_for_me(netdev2_swarm_t *dev, uint8_t *addr)
+{
+    /* covers broadcast, too */
+    return (dev->promiscous) || (addr[0] & 0x01) ||
+           (memcmp(addr, dev->addr, ETHERNET_ADDR_LEN) == 0);
+}
+
+/* positions in a ring are free running and wrap around at its end */
+static void _ring_write(netdev2_swarm_ring_t *ring, uint32_t pos,
+                        const void *data, size_t len)
+{
+    uint32_t off = pos & (NETDEV2_SWARM_RING_SIZE - 1);
+    size_t first = NETDEV2_SWARM_RING_SIZE - off;
+
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&ring->data[off], data, first);
+    memcpy(ring->data, (const uint8_t *)data + first, len - first);
+}
+
+static void _ring_read(netdev2_swarm_ring_t *ring, uint32_t pos, void *data,
+                       size_t len)
+{
+    uint32_t off = pos & (NETDEV2_SWARM_RING_SIZE - 1);
+    size_t first = NETDEV2_SWARM_RING_SIZE - off;
+
+    if (first > len) {
+        first = len;
+    }
+    memcpy(data, &ring->data[off], first);
+    memcpy((uint8_t *)data + first, ring->data, len - first);
+}
+
+static void _doorbell(netdev2_swarm_t *dev, char bell, const char *path)
+{
+    struct sockaddr_un addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+    _native_syscall_enter();
+    if (real_sendto(dev->sock_fd, &bell, sizeof(bell), 0, &addr,
+                    sizeof(addr)) == -1) {
+        /* not fatal, the medium maps all ring files on its start */
+        DEBUG("netdev2_swarm: doorbell to %s not delivered\n", path);
+    }
+    _native_syscall_leave();
+}
+
+static void _medium_doorbell(netdev2_swarm_t *dev, char bell)
+{
+    char path[sizeof(dev->path)];
+
+    snprintf(path, sizeof(path), "%s/%s", dev->dir, NETDEV2_SWARM_MEDIUM);
+    _doorbell(dev, bell, path);
+}
+
+/* returns the length of the next frame in the rx ring, 0 if it is empty */
+static size_t _rx_next(netdev2_swarm_t *dev)
+{
+    netdev2_swarm_ring_t *rx = &dev->rings->rx;
+    uint16_t len;
+
+    if (__atomic_load_n(&rx->head, __ATOMIC_ACQUIRE) == rx->tail) {
+        char tmp[8];
+
+        /* the socket is kept readable as long as the ring is not empty:
+         * drain the doorbells only now and ask for a new one */
+        _native_syscall_enter();
+        while (real_read(dev->sock_fd, tmp, sizeof(tmp)) > 0) {}
+        _native_syscall_leave();
+        __atomic_store_n(&rx->sleeping, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&rx->head, __ATOMIC_SEQ_CST) == rx->tail) {
+            return 0;
+        }
+        /* the medium added a frame before it saw the flag, ring the doorbell
+         * ourselves unless the medium was faster */
+        if (__atomic_exchange_n(&rx->sleeping, 0, __ATOMIC_SEQ_CST)) {
+            _doorbell(dev, NETDEV2_SWARM_DOORBELL_DATA, dev->path);
+        }
+    }
+    _ring_read(rx, rx->tail, &len, sizeof(len));
+    return len;
+}
+
+static void _rx_pop(netdev2_swarm_t *dev, size_t len)
+{
+    netdev2_swarm_ring_t *rx = &dev->rings->rx;
+
+    __atomic_store_n(&rx->tail, rx->tail + sizeof(uint16_t) + len,
+                     __ATOMIC_RELEASE);
+}
+
+static void _continue_reading(netdev2_swarm_t *dev)
+{
+    /* work around lost signals */
+    fd_set rfds;
+    struct timeval t;
+
+    /* puts the socket to rest if the ring is empty */
+    _rx_next(dev);
+
+    memset(&t, 0, sizeof(t));
+    FD_ZERO(&rfds);
+    FD_SET(dev->sock_fd, &rfds);
+
+    _native_in_syscall++; /* no switching here */
+
+    if (real_select(dev->sock_fd + 1, &rfds, NULL, NULL, &t) == 1) {
+        int sig = SIGIO;
+        real_write(_sig_pipefd[1], &sig, sizeof(int));
+        _native_sigpend++;
+        DEBUG("netdev2_swarm: sigpend++\n");
+    }
+    else {
+        native_async_read_continue(dev->sock_fd);
+    }
+
+    _native_in_syscall--;
+}
+
+static int _recv(netdev2_t *netdev2, char *buf, int len, void *info)
+{
+    netdev2_swarm_t *dev = (netdev2_swarm_t *)netdev2;
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
+    int size = _rx_next(dev);
+    (void)info;
+
+    if (!buf) {
+        if ((len > 0) && (size > 0)) {
+            /* no memory available in pktbuf, discarding the frame */
+            DEBUG("netdev2_swarm: discarding the frame\n");
+            _rx_pop(dev, size);
+            _continue_reading(dev);
+            return 0;
+        }
+        /* unlike on a tap device the size of the next frame is known */
+        return size;
+    }
+    if (size == 0) {
+        return -1;
+    }
+
+    _ring_read(&dev->rings->rx, dev->rings->rx.tail + sizeof(uint16_t), buf,
+               (size < len) ? size : len);
+    _rx_pop(dev, size);
+    _continue_reading(dev);
+    DEBUG("netdev2_swarm: read %d bytes\n", size);
+
+    if ((size < (int)sizeof(ethernet_hdr_t)) || (size > len)) {
+        DEBUG("netdev2_swarm: invalid frame => dropped\n");
+        return 0;
+    }
+    if (!_is_for_me(dev, hdr->dst)) {
+        DEBUG("netdev2_swarm: not for me => dropped\n");
+        return 0;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev2->stats.rx_count++;
+    netdev2->stats.rx_bytes += size;
+#endif
+    return size;
+}
+
+static int _send(netdev2_t *netdev, const struct iovec *vector, int n)
+{
+    netdev2_swarm_t *dev = (netdev2_swarm_t *)netdev;
+    netdev2_swarm_ring_t *tx = &dev->rings->tx;
+    uint32_t head = tx->head;
+    uint16_t len = 0;
+    int res;
+
+    for (int i = 0; i < n; i++) {
+        len += vector[i].iov_len;
+    }
+    if ((NETDEV2_SWARM_RING_SIZE -
+         (head - __atomic_load_n(&tx->tail, __ATOMIC_ACQUIRE))) < (sizeof(len) + len)) {
+        DEBUG("netdev2_swarm: tx ring full, frame dropped\n");
+        res = -ENOBUFS;
+    }
+    else {
+        _ring_write(tx, head, &len, sizeof(len));
+        head += sizeof(len);
+        for (int i = 0; i < n; i++) {
+            _ring_write(tx, head, vector[i].iov_base, vector[i].iov_len);
+            head += vector[i].iov_len;
+        }
+        __atomic_store_n(&tx->head, head, __ATOMIC_SEQ_CST);
+        /* only a sleeping medium needs a doorbell */
+        if (__atomic_exchange_n(&tx->sleeping, 0, __ATOMIC_SEQ_CST)) {
+            _medium_doorbell(dev, NETDEV2_SWARM_DOORBELL_DATA);
+        }
+        res = len;
+#ifdef MODULE_NETSTATS_L2
+        netdev->stats.tx_bytes += res;
+#endif
+    }
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV2_EVENT_TX_COMPLETE, NULL);
+    }
+    return res;
+}
+
+void netdev2_swarm_setup(netdev2_swarm_t *dev, const netdev2_swarm_params_t *params)
+{
+    dev->netdev.driver = &netdev2_driver_swarm;
+    dev->dir = params->dir;
+}
+
+static void _swarm_isr(int fd)
+{
+    (void) fd;
+
+    netdev2_t *netdev = (netdev2_t *)&netdev2_swarm;
+
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV2_EVENT_ISR, netdev->isr_arg);
+    }
+    else {
+        puts("netdev2_swarm: _isr: no event callback.");
+    }
+}
+
+static void _map_rings(netdev2_swarm_t *dev)
+{
+    char path[sizeof(dev->path) + sizeof(NETDEV2_SWARM_RING)];
+    int fd;
+
+    snprintf(path, sizeof(path), "%s%s", dev->path, NETDEV2_SWARM_RING);
+    /* always a new file, the medium may still map the one of a former run */
+    real_unlink(path);
+    if ((fd = real_open(path, O_RDWR | O_CREAT | O_EXCL, 0600)) == -1) {
+        err(EXIT_FAILURE, "netdev2_swarm: open(%s)", path);
+    }
+    if (ftruncate(fd, sizeof(netdev2_swarm_rings_t)) == -1) {
+        err(EXIT_FAILURE, "netdev2_swarm: ftruncate");
+    }
+    dev->rings = mmap(NULL, sizeof(netdev2_swarm_rings_t),
+                      PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    real_close(fd);
+    if (dev->rings == MAP_FAILED) {
+        err(EXIT_FAILURE, "netdev2_swarm: mmap");
+    }
+    /* no side has seen a frame yet, both wait for a doorbell */
+    dev->rings->tx.sleeping = 1;
+    dev->rings->rx.sleeping = 1;
+    dev->rings->size = NETDEV2_SWARM_RING_SIZE;
+    __atomic_store_n(&dev->rings->magic, NETDEV2_SWARM_RING_MAGIC,
+                     __ATOMIC_RELEASE);
+}
+
+static int _init(netdev2_t *netdev)
+{
+    netdev2_swarm_t *dev = (netdev2_swarm_t *)netdev;
+    struct sockaddr_un local;
+    uint32_t id = (uint32_t)_native_id;
+
+    /* check device parametrs */
+    if (dev == NULL) {
+        return -ENODEV;
+    }
+
+    dev->promiscous = 0;
+    /* locally administered unicast address derived from the instance id,
+     * the medium uses it to forward unicast frames to the addressee only */
+    dev->addr[0] = 0x02;
+    dev->addr[1] = 0x00;
+    dev->addr[2] = (uint8_t)(id >> 24);
+    dev->addr[3] = (uint8_t)(id >> 16);
+    dev->addr[4] = (uint8_t)(id >> 8);
+    dev->addr[5] = (uint8_t)id;
+
+    if ((dev->sock_fd = real_socket(AF_UNIX, SOCK_DGRAM, 0)) == -1) {
+        err(EXIT_FAILURE, "netdev2_swarm: socket");
+    }
+    memset(&local, 0, sizeof(local));
+    local.sun_family = AF_UNIX;
+    snprintf(local.sun_path, sizeof(local.sun_path), "%s/%s%" PRIu32,
+             dev->dir, NETDEV2_SWARM_NODE, id);
+    strncpy(dev->path, local.sun_path, sizeof(dev->path));
+    real_unlink(dev->path);
+    if (real_bind(dev->sock_fd, &local, sizeof(local)) == -1) {
+        _native_in_syscall++;
+        warn("bind(%s)", dev->path);
+        warnx("probably the swarm directory (%s) does not exist", dev->dir);
+        real_exit(EXIT_FAILURE);
+    }
+    _map_rings(dev);
+    DEBUG("netdev2_swarm: dev->addr = %02x:%02x:%02x:%02x:%02x:%02x\n",
+          dev->addr[0], dev->addr[1], dev->addr[2],
+          dev->addr[3], dev->addr[4], dev->addr[5]);
+
+    /* configure signal handler for fds */
+    native_async_read_setup();
+    native_async_read_add_handler(dev->sock_fd, _swarm_isr);
+
+    /* tell a running medium about the new rings */
+    _medium_doorbell(dev, NETDEV2_SWARM_DOORBELL_ATTACH);
+
+#ifdef MODULE_NETSTATS_L2
+    memset(&netdev->stats, 0, sizeof(netstats_t));
+#endif
+    DEBUG("netdev2_swarm: initialized.\n");
+    return 0;
+}
+
+void netdev2_swarm_cleanup(netdev2_swarm_t *dev)
+{
+    char path[sizeof(dev->path) + sizeof(NETDEV2_SWARM_RING)];
+
+    /* Do we have a device */
+    if (!dev) {
+        return;
+    }
+
+    /* cleanup signal handling */
+    native_async_read_cleanup();
+
+    /* close and remove the socket and the rings */
+    real_close(dev->sock_fd);
+    real_unlink(dev->path);
+    if (dev->rings) {
+        snprintf(path, sizeof(path), "%s%s", dev->path, NETDEV2_SWARM_RING);
+        real_unlink(path);
+        munmap(dev->rings, sizeof(netdev2_swarm_rings_t));
+        dev->rings = NULL;
+    }
+}
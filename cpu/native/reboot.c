@@ -20,6 +20,7 @@
 
 #include "native_internal.h"
 #include "netdev2_tap.h"
+#include "netdev2_swarm.h"
 #include "tty_uart.h"
 
 void reboot(void)
@@ -29,6 +30,9 @@ void reboot(void)
 #ifdef MODULE_NETDEV2_TAP
     netdev2_tap_cleanup(&netdev2_tap);
 #endif
+#ifdef MODULE_NETDEV2_SWARM
+    netdev2_swarm_cleanup(&netdev2_swarm);
+#endif
 
     uart_cleanup();
 
@@ -52,6 +52,15 @@ const char *_native_unix_socket_path = NULL;
 extern netdev2_tap_t netdev2_tap;
 #endif
 
+#ifdef MODULE_NETDEV2_SWARM
+#include "netdev2_swarm.h"
+extern netdev2_swarm_t netdev2_swarm;
+#endif
+
+#if defined(MODULE_NETDEV2_TAP) && defined(MODULE_NETDEV2_SWARM)
+#error "netdev2_tap and netdev2_swarm can't be used together"
+#endif
+
 /**
  * initialize _native_null_in_pipe to allow for reading from stdin
  * @param stdiotype: "stdio" (only initialize pipe) or any string
@@ -199,6 +208,8 @@ void usage_exit(void)
 
 #if defined(MODULE_NETDEV2_TAP)
     real_printf(" <tap interface>");
+#elif defined(MODULE_NETDEV2_SWARM)
+    real_printf(" <swarm directory>");
 #endif
 
     real_printf(" [-i <id>] [-d] [-e|-E] [-o] [-c <tty device>]\n");
@@ -243,7 +254,7 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
     char *stdiotype = "stdio";
     int uart = 0;
 
-#if defined(MODULE_NETDEV2_TAP)
+#if defined(MODULE_NETDEV2_TAP) || defined(MODULE_NETDEV2_SWARM)
     if (
             (argc < 2)
             || (
@@ -330,6 +341,11 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
     p.tap_name = &(argv[1]);
     netdev2_tap_setup(&netdev2_tap, &p);
 #endif
+#ifdef MODULE_NETDEV2_SWARM
+    netdev2_swarm_params_t swarm_params;
+    swarm_params.dir = argv[1];
+    netdev2_swarm_setup(&netdev2_swarm, &swarm_params);
+#endif
 
     board_init();
 
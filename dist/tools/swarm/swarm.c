@@ -0,0 +1,846 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/*
+ * Simulated medium for many native instances using the netdev2_swarm driver.
+ *
+ * Every instance exchanges its ethernet frames with the medium through the
+ * ring pair in <dir>/node-<id>.ring, see netdev2_swarm.h for its layout. The
+ * medium forwards them to the instance's neighbors, applying the loss and
+ * latency configured for each link. The UNIX datagram sockets <dir>/medium
+ * and <dir>/node-<id> only carry doorbells for rings that became non-empty
+ * while their consumer was waiting.
+ *
+ * The links and the statistics are kept in <dir>/medium.shm, which is shared
+ * with `swarm -s` (print statistics) and `swarm -c` (change a link) while the
+ * medium runs.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SWARM_MEDIUM        "medium"        /* NETDEV2_SWARM_MEDIUM */
+#define SWARM_NODE          "node-"         /* NETDEV2_SWARM_NODE */
+#define SWARM_RING          ".ring"         /* NETDEV2_SWARM_RING */
+#define SWARM_RING_MAGIC    (0x53575231)    /* NETDEV2_SWARM_RING_MAGIC */
+#define SWARM_RING_SIZE     (64U * 1024U)   /* NETDEV2_SWARM_RING_SIZE */
+#define SWARM_ATTACH        'A'             /* NETDEV2_SWARM_DOORBELL_ATTACH */
+#define SWARM_SHM           "medium.shm"
+#define SWARM_MAGIC         (0x53574d32)    /* "SWM2" */
+#define SWARM_FRAME_MAX     (1518U)         /* ETHERNET_FRAME_LEN */
+#define SWARM_QUEUE_SIZE    (1U << 16)      /* delayed frames in flight */
+#define SWARM_RX_BURST      (64U)           /* frames taken from a ring at once */
+#define SWARM_SWEEP         (100000U)       /* look at all rings every 100 ms */
+#define SWARM_SOCKBUF       (4 * 1024 * 1024)
+
+/* netdev2_swarm_ring_t */
+typedef struct {
+    uint32_t head;
+    uint32_t sleeping;
+    uint8_t pad0[56];
+    uint32_t tail;
+    uint8_t pad1[60];
+    uint8_t data[SWARM_RING_SIZE];
+} swarm_ring_t;
+
+/* netdev2_swarm_rings_t */
+typedef struct {
+    uint32_t magic;
+    uint32_t size;
+    uint8_t pad[56];
+    swarm_ring_t tx;                /* instance to medium */
+    swarm_ring_t rx;                /* medium to instance */
+} swarm_rings_t;
+
+typedef struct {
+    uint64_t frames;
+    uint64_t bytes;
+} swarm_count_t;
+
+typedef struct {
+    swarm_count_t tx;               /* sent by the instance */
+    swarm_count_t rx;               /* delivered to the instance */
+    uint64_t lost;                  /* dropped by link loss */
+    uint64_t dropped;               /* instance absent or not reading */
+} swarm_node_t;
+
+typedef struct {
+    uint32_t up;                    /* link exists */
+    uint32_t loss;                  /* loss probability in ppm */
+    uint32_t latency;               /* in us */
+    uint32_t jitter;                /* in us, added uniformly distributed */
+} swarm_link_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t nodes;
+    uint64_t started;               /* CLOCK_MONOTONIC in us */
+    swarm_node_t total;
+    uint64_t overflow;              /* delay queue full */
+    uint64_t latency_sum;           /* in us, over all delivered frames */
+    uint64_t latency_max;
+    uint64_t doorbells;             /* sent and received */
+    /* followed by swarm_node_t[nodes] and swarm_link_t[nodes * nodes],
+     * node ids start at 1 */
+} swarm_shm_t;
+
+typedef struct {
+    unsigned refs;
+    uint16_t len;
+    uint8_t data[];
+} swarm_frame_t;
+
+typedef struct {
+    uint64_t due;
+    uint64_t received;
+    uint32_t dst;
+    swarm_frame_t *frame;
+} swarm_pending_t;
+
+static swarm_shm_t *_shm;
+static swarm_node_t *_nodes;
+static swarm_link_t *_links;
+static struct sockaddr_un *_addrs;
+static swarm_rings_t **_rings;
+static uint32_t *_awake;            /* ids of instances with a busy tx ring */
+static uint32_t _awake_len;
+static uint8_t *_is_awake;          /* by id */
+static swarm_pending_t *_queue;
+static unsigned _queue_len;
+static int _fd;
+static uint32_t _rand_state = 1;
+static volatile sig_atomic_t _stop;
+
+static void usage(void)
+{
+    fprintf(stderr,
+"usage: swarm [-n <nodes>] [-t <topology>] [-l <loss %%>] [-L <latency ms>]\n"
+"             [-j <jitter ms>] [-r <report interval s>] [-S <seed>] <dir>\n"
+"       swarm -s <dir>\n"
+"       swarm -c <a> <b> <loss %%> <latency ms> [<jitter ms>] <dir>\n"
+"\n"
+"  -n    number of instances, started as `<elf> <dir> -i <id>` with\n"
+"        1 <= id <= nodes (default: 16)\n"
+"  -t    full (default), line, ring, grid or a file with lines\n"
+"        `<a> <b> [<loss %%> [<latency ms> [<jitter ms>]]]`\n"
+"  -l/-L/-j  default loss, latency and jitter of the links\n"
+"  -r    print statistics every <s> seconds (default: 10, 0 = off)\n"
+"  -s    print the statistics of the medium running in <dir>\n"
+"  -c    change the link between <a> and <b> (both directions) of the\n"
+"        medium running in <dir>, a loss of 100 takes the link down\n");
+    exit(EXIT_FAILURE);
+}
+
+static uint64_t _now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, plenty for loss and jitter */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static size_t _shm_size(uint32_t nodes)
+{
+    return sizeof(swarm_shm_t) + (nodes * sizeof(swarm_node_t)) +
+           ((size_t)nodes * nodes * sizeof(swarm_link_t));
+}
+
+static void _shm_map(const char *dir, uint32_t nodes, int create)
+{
+    char path[sizeof(_addrs->sun_path)];
+    int fd;
+    size_t size;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, SWARM_SHM);
+    if (create) {
+        if ((fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600)) < 0) {
+            perror(path);
+            exit(EXIT_FAILURE);
+        }
+        size = _shm_size(nodes);
+        if (ftruncate(fd, size) < 0) {
+            perror("ftruncate");
+            exit(EXIT_FAILURE);
+        }
+    }
+    else {
+        struct stat st;
+
+        if (((fd = open(path, O_RDWR)) < 0) || (fstat(fd, &st) < 0)) {
+            perror(path);
+            exit(EXIT_FAILURE);
+        }
+        size = st.st_size;
+    }
+    _shm = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (_shm == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    if (create) {
+        _shm->magic = SWARM_MAGIC;
+        _shm->nodes = nodes;
+        _shm->started = _now();
+    }
+    else if ((size < sizeof(swarm_shm_t)) || (_shm->magic != SWARM_MAGIC) ||
+             (size < _shm_size(_shm->nodes))) {
+        fprintf(stderr, "%s: no medium\n", path);
+        exit(EXIT_FAILURE);
+    }
+    _nodes = (swarm_node_t *)(_shm + 1);
+    _links = (swarm_link_t *)(_nodes + _shm->nodes);
+}
+
+static inline swarm_link_t *_link(uint32_t a, uint32_t b)
+{
+    return &_links[((a - 1) * _shm->nodes) + (b - 1)];
+}
+
+static void _link_set(uint32_t a, uint32_t b, double loss, double latency,
+                      double jitter)
+{
+    swarm_link_t link;
+
+    if ((a < 1) || (b < 1) || (a > _shm->nodes) || (b > _shm->nodes) || (a == b)) {
+        fprintf(stderr, "invalid link %" PRIu32 " <-> %" PRIu32 "\n", a, b);
+        exit(EXIT_FAILURE);
+    }
+    link.up = (loss < 100.0);
+    link.loss = (uint32_t)lround(loss * 10000.0);
+    link.latency = (uint32_t)lround(latency * 1000.0);
+    link.jitter = (uint32_t)lround(jitter * 1000.0);
+    *_link(a, b) = link;
+    *_link(b, a) = link;
+}
+
+static void _topology(const char *topo, double loss, double latency, double jitter)
+{
+    uint32_t n = _shm->nodes;
+
+    if (strcmp(topo, "full") == 0) {
+        for (uint32_t a = 1; a <= n; a++) {
+            for (uint32_t b = a + 1; b <= n; b++) {
+                _link_set(a, b, loss, latency, jitter);
+            }
+        }
+    }
+    else if ((strcmp(topo, "line") == 0) || (strcmp(topo, "ring") == 0)) {
+        for (uint32_t a = 1; a < n; a++) {
+            _link_set(a, a + 1, loss, latency, jitter);
+        }
+        if ((topo[0] == 'r') && (n > 2)) {
+            _link_set(n, 1, loss, latency, jitter);
+        }
+    }
+    else if (strcmp(topo, "grid") == 0) {
+        uint32_t width = (uint32_t)ceil(sqrt(n));
+
+        for (uint32_t a = 1; a <= n; a++) {
+            if (((a % width) != 0) && (a < n)) {
+                _link_set(a, a + 1, loss, latency, jitter);
+            }
+            if ((a + width) <= n) {
+                _link_set(a, a + width, loss, latency, jitter);
+            }
+        }
+    }
+    else {
+        FILE *f = fopen(topo, "r");
+        char line[128];
+
+        if (f == NULL) {
+            perror(topo);
+            exit(EXIT_FAILURE);
+        }
+        while (fgets(line, sizeof(line), f)) {
+            unsigned a, b;
+            double l = loss, lat = latency, jit = jitter;
+
+            if ((line[0] == '#') ||
+                (sscanf(line, "%u %u %lf %lf %lf", &a, &b, &l, &lat, &jit) < 2)) {
+                continue;
+            }
+            _link_set(a, b, l, lat, jit);
+        }
+        fclose(f);
+    }
+}
+
+static void _count(swarm_count_t *count, size_t len)
+{
+    count->frames++;
+    count->bytes += len;
+}
+
+static void _frame_put(swarm_frame_t *frame)
+{
+    if (--frame->refs == 0) {
+        free(frame);
+    }
+}
+
+static void _ring_write(swarm_ring_t *ring, uint32_t pos, const void *data,
+                        size_t len)
+{
+    uint32_t off = pos & (SWARM_RING_SIZE - 1);
+    size_t first = SWARM_RING_SIZE - off;
+
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&ring->data[off], data, first);
+    memcpy(ring->data, (const uint8_t *)data + first, len - first);
+}
+
+static void _ring_read(swarm_ring_t *ring, uint32_t pos, void *data, size_t len)
+{
+    uint32_t off = pos & (SWARM_RING_SIZE - 1);
+    size_t first = SWARM_RING_SIZE - off;
+
+    if (first > len) {
+        first = len;
+    }
+    memcpy(data, &ring->data[off], first);
+    memcpy((uint8_t *)data + first, ring->data, len - first);
+}
+
+static void _detach(uint32_t id)
+{
+    if (_rings[id] != NULL) {
+        munmap(_rings[id], sizeof(swarm_rings_t));
+        _rings[id] = NULL;
+    }
+}
+
+static void _attach(uint32_t id)
+{
+    char path[sizeof(_addrs->sun_path) + sizeof(SWARM_RING)];
+    swarm_rings_t *rings;
+    struct stat st;
+    int fd;
+
+    _detach(id);
+    snprintf(path, sizeof(path), "%s%s", _addrs[id].sun_path, SWARM_RING);
+    if ((fd = open(path, O_RDWR)) < 0) {
+        return;
+    }
+    if ((fstat(fd, &st) < 0) || ((size_t)st.st_size < sizeof(swarm_rings_t))) {
+        close(fd);
+        return;
+    }
+    rings = mmap(NULL, sizeof(swarm_rings_t), PROT_READ | PROT_WRITE,
+                 MAP_SHARED, fd, 0);
+    close(fd);
+    if (rings == MAP_FAILED) {
+        return;
+    }
+    if ((__atomic_load_n(&rings->magic, __ATOMIC_ACQUIRE) != SWARM_RING_MAGIC) ||
+        (rings->size != SWARM_RING_SIZE)) {
+        fprintf(stderr, "%s: no rings of this medium\n", path);
+        munmap(rings, sizeof(swarm_rings_t));
+        return;
+    }
+    _rings[id] = rings;
+}
+
+static void _doorbell(uint32_t dst)
+{
+    char bell = 'D';
+
+    _shm->doorbells++;
+    if ((sendto(_fd, &bell, sizeof(bell), 0, (struct sockaddr *)&_addrs[dst],
+                sizeof(_addrs[dst])) < 0) &&
+        ((errno == ECONNREFUSED) || (errno == ENOENT))) {
+        /* instance is gone, rings of a new one are announced */
+        _detach(dst);
+    }
+}
+
+static void _send(uint32_t dst, swarm_frame_t *frame, uint64_t received)
+{
+    swarm_ring_t *rx = (_rings[dst] != NULL) ? &_rings[dst]->rx : NULL;
+    uint16_t len = frame->len;
+
+    if ((rx == NULL) ||
+        ((SWARM_RING_SIZE - (rx->head - __atomic_load_n(&rx->tail, __ATOMIC_ACQUIRE)))
+         < (sizeof(len) + len))) {
+        /* instance not (yet) running or not keeping up */
+        _nodes[dst - 1].dropped++;
+        _shm->total.dropped++;
+    }
+    else {
+        uint64_t latency = _now() - received;
+        uint32_t head = rx->head;
+
+        _ring_write(rx, head, &len, sizeof(len));
+        _ring_write(rx, head + sizeof(len), frame->data, len);
+        __atomic_store_n(&rx->head, head + sizeof(len) + len, __ATOMIC_SEQ_CST);
+        if (__atomic_exchange_n(&rx->sleeping, 0, __ATOMIC_SEQ_CST)) {
+            _doorbell(dst);
+        }
+        _count(&_nodes[dst - 1].rx, frame->len);
+        _count(&_shm->total.rx, frame->len);
+        _shm->latency_sum += latency;
+        if (latency > _shm->latency_max) {
+            _shm->latency_max = latency;
+        }
+    }
+}
+
+/* binary min-heap on swarm_pending_t::due */
+static void _queue_push(const swarm_pending_t *p)
+{
+    unsigned i = _queue_len++;
+
+    while (i > 0) {
+        unsigned parent = (i - 1) / 2;
+
+        if (_queue[parent].due <= p->due) {
+            break;
+        }
+        _queue[i] = _queue[parent];
+        i = parent;
+    }
+    _queue[i] = *p;
+}
+
+static void _queue_pop(void)
+{
+    swarm_pending_t last = _queue[--_queue_len];
+    unsigned i = 0;
+
+    while (1) {
+        unsigned child = (2 * i) + 1;
+
+        if (child >= _queue_len) {
+            break;
+        }
+        if (((child + 1) < _queue_len) && (_queue[child + 1].due < _queue[child].due)) {
+            child++;
+        }
+        if (last.due <= _queue[child].due) {
+            break;
+        }
+        _queue[i] = _queue[child];
+        i = child;
+    }
+    _queue[i] = last;
+}
+
+static void _deliver(uint32_t src, uint32_t dst, swarm_frame_t *frame,
+                     uint64_t received)
+{
+    swarm_link_t *link = _link(src, dst);
+    swarm_pending_t p;
+
+    if (!link->up) {
+        return;
+    }
+    if ((link->loss > 0) && ((_rand() % 1000000) < link->loss)) {
+        _nodes[dst - 1].lost++;
+        _shm->total.lost++;
+        return;
+    }
+    if ((link->latency == 0) && (link->jitter == 0)) {
+        _send(dst, frame, received);
+        return;
+    }
+    p.due = received + link->latency;
+    if (link->jitter > 0) {
+        p.due += _rand() % (link->jitter + 1);
+    }
+    if (_queue_len == SWARM_QUEUE_SIZE) {
+        _shm->overflow++;
+        return;
+    }
+    p.received = received;
+    p.dst = dst;
+    p.frame = frame;
+    frame->refs++;
+    _queue_push(&p);
+}
+
+static void _forward(uint32_t src, swarm_frame_t *frame, uint64_t received)
+{
+    const uint8_t *dst = frame->data;
+
+    if ((dst[0] == 0x02) && (dst[1] == 0x00)) {
+        /* address of an instance, see netdev2_swarm */
+        uint32_t id = ((uint32_t)dst[2] << 24) | ((uint32_t)dst[3] << 16) |
+                      ((uint32_t)dst[4] << 8) | dst[5];
+
+        if ((id >= 1) && (id <= _shm->nodes) && (id != src)) {
+            _deliver(src, id, frame, received);
+        }
+        return;
+    }
+    /* broadcast, multicast and foreign unicast reach all neighbors */
+    for (uint32_t id = 1; id <= _shm->nodes; id++) {
+        if (id != src) {
+            _deliver(src, id, frame, received);
+        }
+    }
+}
+
+static uint32_t _src_id(const struct sockaddr_un *addr, socklen_t len)
+{
+    const char *name = strrchr(addr->sun_path, '/');
+    unsigned long id;
+    char *end;
+
+    if ((len <= sizeof(sa_family_t)) || (name == NULL) ||
+        (strncmp(++name, SWARM_NODE, strlen(SWARM_NODE)) != 0)) {
+        return 0;
+    }
+    id = strtoul(name + strlen(SWARM_NODE), &end, 10);
+    return ((*end == '\0') && (id <= _shm->nodes)) ? id : 0;
+}
+
+/* forwards up to SWARM_RX_BURST frames of the tx ring of src, returns 1 if
+ * there are more */
+static int _drain(uint32_t src)
+{
+    swarm_ring_t *tx = &_rings[src]->tx;
+    uint64_t now = _now();
+    unsigned i = 0;
+
+    while (1) {
+        while (__atomic_load_n(&tx->head, __ATOMIC_ACQUIRE) != tx->tail) {
+            swarm_frame_t *frame;
+            uint16_t len;
+
+            if (i++ == SWARM_RX_BURST) {
+                return 1;
+            }
+            _ring_read(tx, tx->tail, &len, sizeof(len));
+            if ((len >= 6) && (len <= SWARM_FRAME_MAX) &&
+                ((frame = malloc(sizeof(swarm_frame_t) + len)) != NULL)) {
+                frame->refs = 1;
+                frame->len = len;
+                _ring_read(tx, tx->tail + sizeof(len), frame->data, len);
+                _count(&_nodes[src - 1].tx, len);
+                _count(&_shm->total.tx, len);
+                _forward(src, frame, now);
+                _frame_put(frame);
+            }
+            else if (len >= 6) {
+                _shm->overflow++;
+            }
+            __atomic_store_n(&tx->tail, tx->tail + sizeof(len) + len,
+                             __ATOMIC_RELEASE);
+        }
+        /* ask for a doorbell, unless the instance added a frame meanwhile */
+        __atomic_store_n(&tx->sleeping, 1, __ATOMIC_SEQ_CST);
+        if ((__atomic_load_n(&tx->head, __ATOMIC_SEQ_CST) == tx->tail) ||
+            !__atomic_exchange_n(&tx->sleeping, 0, __ATOMIC_SEQ_CST)) {
+            /* empty, or the doorbell is on its way */
+            return 0;
+        }
+    }
+}
+
+static void _wake(uint32_t src)
+{
+    if (!_is_awake[src]) {
+        _is_awake[src] = 1;
+        _awake[_awake_len++] = src;
+    }
+}
+
+static void _receive(void)
+{
+    while (1) {
+        struct sockaddr_un addr;
+        socklen_t addr_len = sizeof(addr);
+        uint32_t src;
+        ssize_t len;
+        char bell;
+
+        memset(&addr, 0, sizeof(addr));
+        len = recvfrom(_fd, &bell, sizeof(bell), 0, (struct sockaddr *)&addr,
+                       &addr_len);
+        if (len < 0) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+                perror("recvfrom");
+            }
+            return;
+        }
+        if ((len < 1) || ((src = _src_id(&addr, addr_len)) == 0)) {
+            continue;
+        }
+        _shm->doorbells++;
+        if ((bell == SWARM_ATTACH) || (_rings[src] == NULL)) {
+            _attach(src);
+        }
+        if (_rings[src] != NULL) {
+            _wake(src);
+        }
+    }
+}
+
+/* takes turns on the busy tx rings, so no instance can hold up the others */
+static void _drain_awake(void)
+{
+    uint32_t i = 0;
+
+    while (i < _awake_len) {
+        if (_drain(_awake[i])) {
+            i++;
+        }
+        else {
+            _is_awake[_awake[i]] = 0;
+            _awake[i] = _awake[--_awake_len];
+        }
+    }
+}
+
+static void _sweep(void)
+{
+    /* a doorbell may have been lost on a full socket buffer */
+    for (uint32_t id = 1; id <= _shm->nodes; id++) {
+        if ((_rings[id] != NULL) &&
+            (__atomic_load_n(&_rings[id]->tx.head, __ATOMIC_ACQUIRE) !=
+             _rings[id]->tx.tail)) {
+            _wake(id);
+        }
+    }
+}
+
+static void _flush(uint64_t now)
+{
+    while ((_queue_len > 0) && (_queue[0].due <= now)) {
+        swarm_pending_t p = _queue[0];
+
+        _queue_pop();
+        _send(p.dst, p.frame, p.received);
+        _frame_put(p.frame);
+    }
+}
+
+static void _report(const swarm_shm_t *last, uint64_t interval)
+{
+    double secs = (double)interval / 1000000.0;
+    uint64_t frames = _shm->total.rx.frames - last->total.rx.frames;
+    uint64_t bytes = _shm->total.rx.bytes - last->total.rx.bytes;
+    uint64_t latency = _shm->latency_sum - last->latency_sum;
+
+    printf("swarm: %" PRIu32 " nodes, %.1f s: tx %" PRIu64 " frames, "
+           "rx %" PRIu64 " frames (%.0f frames/s, %.0f B/s), lost %" PRIu64
+           ", dropped %" PRIu64 ", overflow %" PRIu64 ", latency avg %.0f us "
+           "max %" PRIu64 " us, doorbells %" PRIu64 "\n", _shm->nodes, secs,
+           _shm->total.tx.frames - last->total.tx.frames, frames,
+           (secs > 0) ? frames / secs : 0, (secs > 0) ? bytes / secs : 0,
+           _shm->total.lost - last->total.lost,
+           _shm->total.dropped - last->total.dropped,
+           _shm->overflow - last->overflow,
+           (frames > 0) ? (double)latency / frames : 0, _shm->latency_max,
+           _shm->doorbells - last->doorbells);
+    fflush(stdout);
+}
+
+static void _print_stats(void)
+{
+    swarm_shm_t zero;
+
+    memset(&zero, 0, sizeof(zero));
+    _report(&zero, _now() - _shm->started);
+    printf("%6s %10s %12s %10s %12s %8s %8s\n", "node", "tx frames", "tx bytes",
+           "rx frames", "rx bytes", "lost", "dropped");
+    for (uint32_t i = 0; i < _shm->nodes; i++) {
+        printf("%6" PRIu32 " %10" PRIu64 " %12" PRIu64 " %10" PRIu64
+               " %12" PRIu64 " %8" PRIu64 " %8" PRIu64 "\n", i + 1,
+               _nodes[i].tx.frames, _nodes[i].tx.bytes, _nodes[i].rx.frames,
+               _nodes[i].rx.bytes, _nodes[i].lost, _nodes[i].dropped);
+    }
+}
+
+static void _sig_stop(int sig)
+{
+    (void)sig;
+    _stop = 1;
+}
+
+static void _open_medium(const char *dir)
+{
+    struct sockaddr_un addr;
+    int size = SWARM_SOCKBUF;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s/%s", dir, SWARM_MEDIUM);
+    if ((_fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0)) < 0) {
+        perror("socket");
+        exit(EXIT_FAILURE);
+    }
+    unlink(addr.sun_path);
+    if (bind(_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror(addr.sun_path);
+        exit(EXIT_FAILURE);
+    }
+    setsockopt(_fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    setsockopt(_fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+
+    /* index 0 is unused, node ids start at 1 */
+    if ((_addrs = calloc(_shm->nodes + 1, sizeof(*_addrs))) == NULL) {
+        perror("calloc");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t id = 1; id <= _shm->nodes; id++) {
+        _addrs[id].sun_family = AF_UNIX;
+        snprintf(_addrs[id].sun_path, sizeof(_addrs[id].sun_path),
+                 "%s/%s%" PRIu32, dir, SWARM_NODE, id);
+    }
+    if (((_rings = calloc(_shm->nodes + 1, sizeof(*_rings))) == NULL) ||
+        ((_awake = calloc(_shm->nodes, sizeof(*_awake))) == NULL) ||
+        ((_is_awake = calloc(_shm->nodes + 1, sizeof(*_is_awake))) == NULL)) {
+        perror("calloc");
+        exit(EXIT_FAILURE);
+    }
+    /* instances started before the medium */
+    for (uint32_t id = 1; id <= _shm->nodes; id++) {
+        _attach(id);
+    }
+    _sweep();
+}
+
+int main(int argc, char **argv)
+{
+    const char *topo = "full";
+    double loss = 0, latency = 0, jitter = 0;
+    unsigned long nodes = 16, interval = 10;
+    swarm_shm_t last;
+    uint64_t next_report, next_sweep;
+    struct sigaction sa;
+    int c;
+
+    if ((argc > 1) && (strcmp(argv[1], "-c") == 0)) {
+        if ((argc != 7) && (argc != 8)) {
+            usage();
+        }
+        _shm_map(argv[argc - 1], 0, 0);
+        _link_set(strtoul(argv[2], NULL, 10), strtoul(argv[3], NULL, 10),
+                  atof(argv[4]), atof(argv[5]), (argc == 8) ? atof(argv[6]) : 0);
+        return 0;
+    }
+    while ((c = getopt(argc, argv, "n:t:l:L:j:r:S:s")) != -1) {
+        switch (c) {
+            case 'n':
+                nodes = strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                topo = optarg;
+                break;
+            case 'l':
+                loss = atof(optarg);
+                break;
+            case 'L':
+                latency = atof(optarg);
+                break;
+            case 'j':
+                jitter = atof(optarg);
+                break;
+            case 'r':
+                interval = strtoul(optarg, NULL, 10);
+                break;
+            case 'S':
+                _rand_state = strtoul(optarg, NULL, 10) | 1;
+                break;
+            case 's':
+                if (optind != (argc - 1)) {
+                    usage();
+                }
+                _shm_map(argv[optind], 0, 0);
+                _print_stats();
+                return 0;
+            default:
+                usage();
+        }
+    }
+    if ((optind != (argc - 1)) || (nodes < 2) || (nodes > 65535)) {
+        usage();
+    }
+
+    _shm_map(argv[optind], nodes, 1);
+    _topology(topo, loss, latency, jitter);
+    if ((_queue = malloc(SWARM_QUEUE_SIZE * sizeof(*_queue))) == NULL) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    _open_medium(argv[optind]);
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = _sig_stop;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    printf("swarm: medium for %lu nodes running in %s\n", nodes, argv[optind]);
+    fflush(stdout);
+    last = *_shm;
+    next_report = _now() + (interval * 1000000);
+    next_sweep = _now() + SWARM_SWEEP;
+    while (!_stop) {
+        struct pollfd pfd = { .fd = _fd, .events = POLLIN };
+        uint64_t now = _now(), wakeup = next_sweep;
+        int timeout;
+
+        if ((interval > 0) && (next_report < wakeup)) {
+            wakeup = next_report;
+        }
+        if ((_queue_len > 0) && (_queue[0].due < wakeup)) {
+            wakeup = _queue[0].due;
+        }
+        /* round up, poll() would return early and spin otherwise */
+        timeout = (wakeup > now) ? (int)((wakeup - now + 999) / 1000) : 0;
+        if (_awake_len > 0) {
+            /* busy rings left from the last round */
+            timeout = 0;
+        }
+        if (poll(&pfd, 1, timeout) > 0) {
+            _receive();
+        }
+        now = _now();
+        if (now >= next_sweep) {
+            _sweep();
+            next_sweep = now + SWARM_SWEEP;
+        }
+        _drain_awake();
+        now = _now();
+        _flush(now);
+        if ((interval > 0) && (now >= next_report)) {
+            _report(&last, now - (next_report - (interval * 1000000)));
+            last = *_shm;
+            next_report = now + (interval * 1000000);
+        }
+    }
+    _print_stats();
+    return 0;
+}
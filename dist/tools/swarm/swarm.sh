@@ -0,0 +1,74 @@
+#!/bin/sh
+#
+# Starts the swarm medium and <nodes> native instances of <elf> on it, pinned
+# round-robin to the CPUs of the host, and stops them all again on Ctrl-C (or
+# after -T seconds). The medium prints the aggregated statistics on exit.
+
+SWARM_TOOL_DIR="$(dirname $(readlink -f $0))"
+SWARM="${SWARM_TOOL_DIR}/swarm"
+
+usage() {
+    echo "usage: $0 [-d <dir>] [-T <seconds>] <elf> <nodes> [<swarm options>]"
+    echo ""
+    echo "  -d  directory of the medium (default: /tmp/riot-swarm)"
+    echo "  -T  stop after <seconds> (default: run until interrupted)"
+    echo ""
+    echo "see \`${SWARM}\` for the options of the medium (topology, loss, ...)"
+    exit 1
+}
+
+cleanup() {
+    trap "" INT QUIT TERM EXIT
+    echo "Stopping swarm..."
+    [ -n "${NODE_PIDS}" ] && kill ${NODE_PIDS} 2> /dev/null
+    kill ${MEDIUM_PID} 2> /dev/null
+    wait ${MEDIUM_PID}
+}
+
+DIR=/tmp/riot-swarm
+DURATION=
+
+while getopts d:T: opt; do
+    case ${opt} in
+        d) DIR=${OPTARG} ;;
+        T) DURATION=${OPTARG} ;;
+        *) usage ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+ELF=$1
+NODES=$2
+[ -z "${ELF}" -o -z "${NODES}" ] && usage
+shift 2
+
+[ -x "${SWARM}" ] || make -C "${SWARM_TOOL_DIR}" > /dev/null || exit 1
+mkdir -p "${DIR}" || exit 1
+CPUS=$(getconf _NPROCESSORS_ONLN)
+TASKSET=
+command -v taskset > /dev/null && TASKSET=taskset
+
+trap "cleanup" INT QUIT TERM EXIT
+
+"${SWARM}" -n ${NODES} "$@" "${DIR}" &
+MEDIUM_PID=$!
+while [ ! -S "${DIR}/medium" ]; do
+    kill -0 ${MEDIUM_PID} 2> /dev/null || exit 1
+    sleep 0.1
+done
+
+# -d detaches the instances from the terminal, -o logs their stdout to
+# /tmp/riot.stdout.<pid>
+for i in $(seq 1 ${NODES}); do
+    PIN=
+    [ -n "${TASKSET}" ] && PIN="${TASKSET} -c $((i % CPUS))"
+    PID=$(${PIN} "${ELF}" "${DIR}" -i ${i} -d -o | sed -n 's/^RIOT pid: //p')
+    NODE_PIDS="${NODE_PIDS} ${PID}"
+done
+echo "Started ${NODES} nodes on ${CPUS} CPUs, statistics: ${SWARM} -s ${DIR}"
+
+if [ -n "${DURATION}" ]; then
+    sleep ${DURATION}
+else
+    wait ${MEDIUM_PID}
+fi
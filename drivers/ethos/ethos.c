@@ -26,6 +26,7 @@
 #include "ethos.h"
 #include "periph/uart.h"
 #include "tsrb.h"
+#include "uart_escape.h"
 #include "irq.h"
 
 #include "net/netdev2.h"
@@ -44,8 +45,12 @@ static void _get_mac_addr(netdev2_t *dev, uint8_t* buf);
 static void ethos_isr(void *arg, uint8_t c);
 static const netdev2_driver_t netdev2_driver_ethos;
 
-static const uint8_t _esc_esc[] = {ETHOS_ESC_CHAR, (ETHOS_ESC_CHAR ^ 0x20)};
-static const uint8_t _esc_delim[] = {ETHOS_ESC_CHAR, (ETHOS_FRAME_DELIMITER ^ 0x20)};
+static const uart_escape_t _escape = {
+    .delim = ETHOS_FRAME_DELIMITER,
+    .esc = ETHOS_ESC_CHAR,
+    .delim_esc = (ETHOS_FRAME_DELIMITER ^ 0x20),
+    .esc_esc = (ETHOS_ESC_CHAR ^ 0x20),
+};
 
 
 void ethos_setup(ethos_t *dev, const ethos_params_t *params)
@@ -197,28 +202,6 @@ static size_t iovec_count_total(const struct iovec *vector, int count)
     return result;
 }
 
-static void _write_escaped(uart_t uart, uint8_t c)
-{
-    uint8_t *out;
-    int n;
-
-    switch(c) {
-        case ETHOS_FRAME_DELIMITER:
-            out = (uint8_t*)_esc_delim;
-            n = 2;
-            break;
-        case ETHOS_ESC_CHAR:
-            out = (uint8_t*)_esc_esc;
-            n = 2;
-            break;
-        default:
-            out = &c;
-            n = 1;
-    }
-
-    uart_write(uart, out, n);
-}
-
 void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned frame_type)
 {
     uint8_t frame_delim = ETHOS_FRAME_DELIMITER;
@@ -242,9 +225,7 @@ void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned fr
     }
 
     /* send frame content */
-    while(len--) {
-        _write_escaped(dev->uart, *(uint8_t*)data++);
-    }
+    uart_escape_write(dev->uart, &_escape, data, len);
 
     /* end of frame */
     uart_write(dev->uart, &frame_delim, 1);
@@ -271,11 +252,8 @@ static int _send(netdev2_t *netdev, const struct iovec *vector, int count)
 
     /* send iovec */
     while(count--) {
-        size_t n = vector->iov_len;
-        uint8_t *ptr = vector->iov_base;
-        while(n--) {
-            _write_escaped(dev->uart, *ptr++);
-        }
+        uart_escape_write(dev->uart, &_escape, vector->iov_base,
+                          vector->iov_len);
         vector++;
     }
 
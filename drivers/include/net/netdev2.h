@@ -122,6 +122,11 @@ typedef struct netdev2_driver {
     /**
      * @brief Send frame
      *
+     * The first entry of @p vector holds the link layer header, the others
+     * point directly to the headers and payload of the packet. Drivers should
+     * write the entries out as they are instead of copying them into a
+     * frame buffer first.
+     *
      * @param[in] dev       network device descriptor
      * @param[in] vector    io vector array to send
      * @param[in] count     nr of entries in vector
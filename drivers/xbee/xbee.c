@@ -142,6 +142,7 @@ static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
 
     xtimer_t resp_timer;
 
+    resp_timer.target = resp_timer.long_target = 0;
     resp_timer.callback = isr_resp_timeout;
     resp_timer.arg = dev;
 
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/**
+ * @ingroup auto_init_ng_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for the native swarm interface
+ */
+
+#ifdef MODULE_NETDEV2_SWARM
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#include "netdev2_swarm.h"
+#include "net/gnrc/netdev2/eth.h"
+
+extern netdev2_swarm_t netdev2_swarm;
+
+/**
+ * @brief   Define stack parameters for the MAC layer thread
+ * @{
+ */
+#define SWARM_MAC_STACKSIZE         (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#define SWARM_MAC_PRIO              (THREAD_PRIORITY_MAIN - 3)
+/** @} */
+
+/**
+ * @brief   Stacks for the MAC layer threads
+ */
+static char _netdev2_eth_stack[SWARM_MAC_STACKSIZE + DEBUG_EXTRA_STACKSIZE];
+static gnrc_netdev2_t _gnrc_netdev2_swarm;
+
+void auto_init_netdev2_swarm(void)
+{
+    gnrc_netdev2_eth_init(&_gnrc_netdev2_swarm, (netdev2_t*)&netdev2_swarm);
+
+    gnrc_netdev2_init(_netdev2_eth_stack, SWARM_MAC_STACKSIZE,
+            SWARM_MAC_PRIO, "gnrc_netdev2_swarm", &_gnrc_netdev2_swarm);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NETDEV2_SWARM */
+/** @} */
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_benchmark
+ * @{
+ *
+ * @file
+ * @brief       Benchmark output
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+
+void benchmark_print_time(uint32_t time, unsigned long runs, const char *name)
+{
+    /* average in nanoseconds, as a single run often takes less than 1us */
+    uint32_t avg = (uint32_t)(((uint64_t)time * 1000) / runs);
+
+    printf("%14s (%7lu runs) took %9" PRIu32 " us (%" PRIu32 ".%03" PRIu32
+           " us per run)\n", name, runs, time, avg / 1000, avg % 1000);
+}
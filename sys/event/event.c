@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Event queue implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "event.h"
+#include "irq.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+void event_queue_init(event_queue_t *queue)
+{
+    assert(queue);
+    queue->event_list.next = NULL;
+    queue->waiter = (thread_t *) sched_active_thread;
+}
+
+void event_post(event_queue_t *queue, event_t *event)
+{
+    assert(queue && event);
+
+    unsigned state = irq_disable();
+    /* a queued event always points to its successor in the circular list */
+    if (!event->list_node.next) {
+        clist_insert(&queue->event_list, &event->list_node);
+    }
+    thread_t *waiter = queue->waiter;
+    irq_restore(state);
+
+    /* without a waiter yet, the event is picked up by its first wait */
+    if (waiter) {
+        thread_flags_set(waiter, THREAD_FLAG_EVENT);
+    }
+}
+
+void event_cancel(event_queue_t *queue, event_t *event)
+{
+    assert(queue && event);
+
+    unsigned state = irq_disable();
+    if (clist_remove(&queue->event_list, &event->list_node)) {
+        event->list_node.next = NULL;
+    }
+    irq_restore(state);
+}
+
+event_t *event_get(event_queue_t *queue)
+{
+    event_t *result = NULL;
+    unsigned state = irq_disable();
+    clist_node_t *node = clist_remove_head(&queue->event_list);
+
+    if (node) {
+        /* may be posted again from here on */
+        node->next = NULL;
+        result = container_of(node, event_t, list_node);
+    }
+    irq_restore(state);
+    return result;
+}
+
+event_t *event_wait(event_queue_t *queue)
+{
+    event_t *result;
+    unsigned state = irq_disable();
+
+    /* statically initialized queues belong to the first thread waiting */
+    if (!queue->waiter) {
+        queue->waiter = (thread_t *) sched_active_thread;
+    }
+    irq_restore(state);
+    assert(queue->waiter == sched_active_thread);
+
+    while (!(result = event_get(queue))) {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
+    DEBUG("event_wait(): got event %p\n", (void *)result);
+    return result;
+}
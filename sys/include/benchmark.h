@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_benchmark Benchmark
+ * @ingroup     sys
+ * @brief       Framework for timing and printing simple benchmarks
+ *
+ * All benchmark applications in `tests/` use this module, so their output
+ * looks the same and can be compared between boards and configurations.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Benchmark interface
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdint.h>
+
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Runs @p func @p runs times and prints the time it took
+ *
+ * @p func can use the loop variable `i`, which counts from 0 to @p runs - 1.
+ *
+ * @param[in] name  name of the benchmark
+ * @param[in] runs  number of runs
+ * @param[in] func  statement to time
+ */
+#define BENCHMARK_FUNC(name, runs, func) \
+    do { \
+        uint32_t _benchmark_time = xtimer_now(); \
+        for (unsigned long i = 0; i < (runs); i++) { \
+            func; \
+        } \
+        _benchmark_time = xtimer_now() - _benchmark_time; \
+        benchmark_print_time(_benchmark_time, (runs), (name)); \
+    } while (0)
+
+/**
+ * @brief   Prints the total and the average time of a benchmark
+ *
+ * @param[in] time  total time of all runs in microseconds
+ * @param[in] runs  number of runs
+ * @param[in] name  name of the benchmark
+ */
+void benchmark_print_time(uint32_t time, unsigned long runs, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCHMARK_H */
+/** @} */
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event Event Queue
+ * @ingroup     sys
+ * @brief       Run-to-completion event queues
+ *
+ * An event is a handler function together with the state it operates on.
+ * Events are posted into an event queue, from threads or ISRs, and the
+ * thread owning the queue runs their handlers one after another. Each handler
+ * runs to completion before the next one is started.
+ *
+ * Several modules that only react to events (e.g. timeouts and packets
+ * handed over by other modules) can share one queue and thus one thread and
+ * one stack, instead of running a thread with its own stack and message queue
+ * each. Handing work to such a module costs a function call in the handler
+ * thread instead of a context switch.
+ *
+ * Events are not copied: the event_t is linked into the queue, so posting
+ * never fails and needs no queue memory. The flip side is that an event can
+ * be pending at most once, posting an event that is already queued has no
+ * effect. An event must not be changed while it is queued.
+ *
+ * Usually, event_t is embedded into a struct holding the event's state:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * typedef struct {
+ *     event_t super;
+ *     unsigned count;
+ * } counter_event_t;
+ *
+ * static void _handler(event_t *event)
+ * {
+ *     counter_event_t *counter = (counter_event_t *) event;
+ *     printf("%u\n", ++counter->count);
+ * }
+ *
+ * static counter_event_t _counter = { .super.handler = _handler };
+ *
+ * static void *_thread(void *arg)
+ * {
+ *     event_queue_t *queue = (event_queue_t *) arg;
+ *     event_queue_init(queue);
+ *     event_loop(queue);
+ *     return NULL;
+ * }
+ *
+ * // somewhere else, e.g. in an ISR:
+ * event_post(queue, &_counter.super);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The queue wakes its thread with @ref THREAD_FLAG_EVENT, so the thread can
+ * wait for other thread flags at the same time. See @ref sys_event_timeout
+ * for events posted by xtimer and @ref sys_event_callback for events calling
+ * a plain callback function.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event queue API
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "kernel_defines.h"
+#include "sched.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef THREAD_FLAG_EVENT
+/**
+ * @brief   Thread flag used to notify a thread of posted events
+ */
+#define THREAD_FLAG_EVENT   (0x1)
+#endif
+
+/**
+ * @brief   Static initializer for event queues
+ *
+ * The queue belongs to the first thread that waits for its events. Events
+ * posted before stay queued until then.
+ */
+#define EVENT_QUEUE_INIT    { { NULL }, NULL }
+
+/**
+ * @brief   Event structure forward declaration
+ */
+typedef struct event event_t;
+
+/**
+ * @brief   Event handler type definition
+ */
+typedef void (*event_handler_t)(event_t *);
+
+/**
+ * @brief   Event structure
+ */
+struct event {
+    clist_node_t list_node;     /**< event queue list entry             */
+    event_handler_t handler;    /**< pointer to event handler function  */
+};
+
+/**
+ * @brief   Event queue structure
+ */
+typedef struct {
+    clist_node_t event_list;    /**< list of queued events              */
+    thread_t *waiter;           /**< thread owning the event queue, NULL
+                                     *   until the first event_wait()      */
+} event_queue_t;
+
+/**
+ * @brief   Initialize an event queue
+ *
+ * Makes the calling thread the owner of @p queue, only it may get events
+ * from it.
+ *
+ * @param[out]  queue   event queue object to initialize
+ */
+void event_queue_init(event_queue_t *queue);
+
+/**
+ * @brief   Queue an event
+ *
+ * Does nothing if @p event is already queued. Can be called from an ISR.
+ *
+ * @param[in]   queue   event queue to queue event in
+ * @param[in]   event   event to queue
+ */
+void event_post(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Cancel a queued event
+ *
+ * Does nothing if @p event is not queued in @p queue. Can be called from an
+ * ISR.
+ *
+ * @note    Takes linear time in the number of queued events.
+ *
+ * @param[in]   queue   event queue to remove event from
+ * @param[in]   event   event to remove from queue
+ */
+void event_cancel(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Get next event from event queue, non-blocking
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @return      pointer to next event
+ * @return      NULL if no event available
+ */
+event_t *event_get(event_queue_t *queue);
+
+/**
+ * @brief   Get next event from event queue, blocking
+ *
+ * Must only be called by the thread owning @p queue.
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @return      pointer to next event
+ */
+event_t *event_wait(event_queue_t *queue);
+
+/**
+ * @brief   Simple event loop
+ *
+ * Runs the handler of every event posted to @p queue, forever. Must only be
+ * called by the thread owning @p queue.
+ *
+ * @param[in]   queue   event queue to process
+ */
+static inline NORETURN void event_loop(event_queue_t *queue)
+{
+    event_t *event;
+
+    while (1) {
+        event = event_wait(queue);
+        event->handler(event);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* EVENT_H */
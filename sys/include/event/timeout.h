@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event_timeout Event Timeout
+ * @ingroup     sys_event
+ * @brief       Post events to an event queue after a timeout
+ *
+ * The xtimer callback posts the event directly into the queue, no message
+ * and no extra thread is involved. Enabled by the pseudomodule
+ * `event_timeout`.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event timeout API
+ */
+
+#ifndef EVENT_TIMEOUT_H
+#define EVENT_TIMEOUT_H
+
+#include "event.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Timeout Event structure
+ */
+typedef struct {
+    xtimer_t timer;         /**< xtimer object used for timeout */
+    event_queue_t *queue;   /**< event queue to post event to   */
+    event_t *event;         /**< event to post after timeout    */
+} event_timeout_t;
+
+/**
+ * @brief   Initialize timeout event object
+ *
+ * @param[in]   event_timeout   event_timeout object to initialize
+ * @param[in]   queue           queue that the timed-out event will be added to
+ * @param[in]   event           event to add to queue after timeout
+ */
+void event_timeout_init(event_timeout_t *event_timeout, event_queue_t *queue,
+                        event_t *event);
+
+/**
+ * @brief   Set a timeout
+ *
+ * This will make the event as configured in @p event_timeout be triggered
+ * after @p timeout microseconds. A timeout that is already set is restarted.
+ *
+ * @param[in]   event_timeout   event_timeout context object to use
+ * @param[in]   timeout         timeout in microseconds
+ */
+void event_timeout_set(event_timeout_t *event_timeout, uint32_t timeout);
+
+/**
+ * @brief   Clear a timeout event
+ *
+ * Stops the timer. An event that has already been posted is also removed
+ * from the queue.
+ *
+ * @param[in]   event_timeout   event_timeout object to clear
+ */
+void event_timeout_clear(event_timeout_t *event_timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* EVENT_TIMEOUT_H */
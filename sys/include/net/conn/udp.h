@@ -118,6 +118,56 @@ int conn_udp_getlocaladdr(conn_udp_t *conn, void *addr, uint16_t *port);
 int conn_udp_recvfrom(conn_udp_t *conn, void *data, size_t max_len, void *addr, size_t *addr_len,
                       uint16_t *port);
 
+/**
+ * @brief   Special value for the timeout of @ref conn_udp_recv_buf() to wait
+ *          for a message without any time limit
+ */
+#define CONN_UDP_NO_TIMEOUT     (UINT32_MAX)
+
+#if defined(MODULE_GNRC_CONN_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Receives a UDP message without copying it
+ *
+ * The payload stays in the network stack's buffer and is lent to the caller
+ * until it is handed back with @ref conn_udp_recv_buf_release(). There is no
+ * upper limit for the size of the message.
+ *
+ * @note    Currently only provided by @ref net_gnrc.
+ *
+ * @param[in] conn      A UDP connection object.
+ * @param[out] data     The payload of the received message.
+ * @param[out] buf_ctx  Handle to hand to @ref conn_udp_recv_buf_release() once
+ *                      @p data is not needed anymore.
+ * @param[in] timeout   Time in microseconds to wait for a message. 0 to not
+ *                      wait at all, @ref CONN_UDP_NO_TIMEOUT to wait forever.
+ * @param[out] addr     NULL pointer or the sender's network layer address. Must have space
+ *                      for any address of the connection's family.
+ * @param[out] addr_len Length of @p addr. Can be NULL if @p addr is NULL.
+ * @param[out] port     NULL pointer or the sender's UDP port.
+ *
+ * @todo    With @ref net_gnrc this function needs to be called from the same
+ *          thread as @ref conn_udp_create.
+ *
+ * @return  The number of bytes at @p data on success.
+ * @return  -EAGAIN, if @p timeout is 0 and no message is available.
+ * @return  -ETIMEDOUT, if no message was received within @p timeout.
+ * @return  any other negative number in case of an error.
+ */
+int conn_udp_recv_buf(conn_udp_t *conn, void **data, void **buf_ctx, uint32_t timeout,
+                      void *addr, size_t *addr_len, uint16_t *port);
+
+/**
+ * @brief   Hands a message received with @ref conn_udp_recv_buf() back to the
+ *          network stack
+ *
+ * @note    Currently only provided by @ref net_gnrc.
+ *
+ * @param[in] conn      A UDP connection object.
+ * @param[in] buf_ctx   The handle returned by @ref conn_udp_recv_buf().
+ */
+void conn_udp_recv_buf_release(conn_udp_t *conn, void *buf_ctx);
+#endif
+
 /**
  * @brief   Sends a UDP message
  *
@@ -11,6 +11,11 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * Single hop tables are indexed by a path-compressed binary trie over the
+ * destination prefixes, so fib_get_next_hop() visits at most one node per
+ * address bit independent of the number of entries. The trie is built by
+ * fib_init(), tables must not be used before.
+ *
  * @{
  *
  * @file
@@ -35,6 +35,32 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+/**
+ * @brief Node of the longest-prefix-match trie indexing a FIB table
+ */
+typedef struct fib_trie_node {
+    /** sub-tries continuing with a 0 or a 1 bit after the first `len` bits */
+    struct fib_trie_node *child[2];
+    /** parent node, or the previous node if this node is a duplicate */
+    struct fib_trie_node *parent;
+    /** nodes with the same prefix that are not linked into the trie */
+    struct fib_trie_node *dup;
+    /** prefix length in bits */
+    uint16_t len;
+    /** node type, see fib.c */
+    uint8_t type;
+} fib_trie_node_t;
+
+/**
+ * @brief Branching node of the trie that does not belong to a FIB entry
+ */
+typedef struct {
+    /** the node linked into the trie */
+    fib_trie_node_t node;
+    /** the prefix shared by all nodes below */
+    uint8_t key[UNIVERSAL_ADDRESS_SIZE];
+} fib_trie_glue_t;
+
 /**
  * @brief Container descriptor for a FIB entry
  */
@@ -51,6 +77,10 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+    /** trie node of the destination `global` */
+    fib_trie_node_t node;
+    /** branching node, used independently of this entry by the FIB */
+    fib_trie_glue_t glue;
 } fib_entry_t;
 
 /**
@@ -133,6 +163,10 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** root of the trie over the single hop entries */
+    fib_trie_node_t *trie;
+    /** unused branching nodes of the single hop entries */
+    fib_trie_node_t *trie_glue;
 } fib_table_t;
 
 #ifdef __cplusplus
@@ -117,13 +117,39 @@ bool gnrc_conn6_set_local_addr(uint8_t *conn_addr, const ipv6_addr_t *addr);
  *
  * @return  The number of bytes received on success.
  * @return  0, if no received data is available, but everything is in order.
- * @return  -ENOMEM, if received data was more than max_len.
+ * @return  -ENOMEM, if received data was more than max_len. The data is dropped.
  * @returne -ETIMEDOUT, if more than 3 IPC messages were not @ref net_ng_netapi receive commands
  *          with the required headers in the packet
  */
 int gnrc_conn_recvfrom(conn_t *conn, void *data, size_t max_len, void *addr, size_t *addr_len,
                        uint16_t *port);
 
+#if defined(MODULE_GNRC_CONN_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Generic receive without copying the payload
+ *
+ * @internal
+ *
+ * @param[in] conn      Connection object.
+ * @param[out] pkt      The received packet. Its first snip is the payload.
+ *                      Must be released by the caller.
+ * @param[in] timeout   Time in microseconds to wait for a message. 0 to not
+ *                      wait at all, UINT32_MAX to wait forever.
+ * @param[out] addr     NULL pointer or the sender's IP address. Must fit address of connection's
+ *                      family if not NULL.
+ * @param[out] addr_len Length of @p addr. May be NULL if @p addr is NULL.
+ * @param[out] port     NULL pointer or the sender's port.
+ *
+ * @return  The size of the payload on success.
+ * @return  -EAGAIN, if @p timeout was 0 and no message was available.
+ * @return  -ETIMEDOUT, if no message arrived within @p timeout or more than 3 IPC messages
+ *          were not @ref net_ng_netapi receive commands with the required headers in the
+ *          packet
+ */
+int gnrc_conn_recv_buf(conn_t *conn, gnrc_pktsnip_t **pkt, uint32_t timeout, void *addr,
+                       size_t *addr_len, uint16_t *port);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
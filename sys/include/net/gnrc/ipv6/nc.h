@@ -10,6 +10,13 @@
  * @defgroup    net_gnrc_ipv6_nc  IPv6 neighbor cache
  * @ingroup     net_gnrc_ipv6
  * @brief       Translates IPv6 addresses to link layer addresses.
+ *
+ * Entries are found by a hash index over their IPv6 address, so lookups
+ * take constant time independent of @ref GNRC_IPV6_NC_SIZE. If the cache is
+ * full, gnrc_ipv6_nc_add() replaces the least recently used entry in
+ * @ref GNRC_IPV6_NC_STATE_STALE state. Routers and entries of type
+ * @ref GNRC_IPV6_NC_TYPE_REGISTERED or @ref GNRC_IPV6_NC_TYPE_TENTATIVE are
+ * never replaced.
  * @{
  *
  * @file
@@ -40,6 +47,8 @@ extern "C" {
 #ifndef GNRC_IPV6_NC_SIZE
 /**
  * @brief   The size of the neighbor cache
+ *
+ * @note    Must be smaller than 65535.
  */
 #define GNRC_IPV6_NC_SIZE           (GNRC_NETIF_NUMOF * 8)
 #endif
@@ -184,7 +193,7 @@ void gnrc_ipv6_nc_init(void);
  * @param[in] flags         Flags for the entry
  *
  * @return  Pointer to new neighbor cache entry on success
- * @return  NULL, on failure
+ * @return  NULL, if the cache is full and has no entry to replace
  */
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr,
                                  const void *l2_addr, size_t l2_addr_len, uint8_t flags);
@@ -202,6 +211,8 @@ void gnrc_ipv6_nc_remove(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr);
 /**
  * @brief   Searches for any neighbor cache entry fitting the @p ipv6_addr.
  *
+ * A found entry is marked as most recently used.
+ *
  * @param[in] iface         PID to the interface where the neighbor is. If it
  *                          is KERNEL_PID_UNDEF it will be searched on all
  *                          interfaces.
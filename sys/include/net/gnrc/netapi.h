@@ -62,6 +62,31 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt up the
+ *          network stack
+ *
+ * @details The message content is a packet of type @ref GNRC_NETTYPE_BATCH.
+ *          Use @ref gnrc_netapi_batch_drain() to handle it.
+ */
+#define GNRC_NETAPI_MSG_TYPE_RCV_BATCH  (0x0206)
+
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt down the
+ *          network stack
+ *
+ * @details The message content is a packet of type @ref GNRC_NETTYPE_BATCH.
+ *          Use @ref gnrc_netapi_batch_drain() to handle it.
+ */
+#define GNRC_NETAPI_MSG_TYPE_SND_BATCH  (0x0207)
+
+/**
+ * @brief   Maximum number of packets in a batch
+ */
+#ifndef GNRC_NETAPI_BATCH_SIZE
+#define GNRC_NETAPI_BATCH_SIZE          (8)
+#endif
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -73,6 +98,25 @@ typedef struct {
     uint16_t data_len;          /**< size of the data / the buffer */
 } gnrc_netapi_opt_t;
 
+/**
+ * @brief   Collects packets for the same subscribers to hand them over with a
+ *          single message
+ *
+ * @details Initialize with all zeroes. Packets added with
+ *          @ref gnrc_netapi_batch_add() are dispatched as soon as
+ *          @ref GNRC_NETAPI_BATCH_SIZE packets are collected, a packet for
+ *          other subscribers is added, or @ref gnrc_netapi_batch_flush() is
+ *          called. A thread typically flushes its batches when its message
+ *          queue runs empty, so batching only happens under load.
+ */
+typedef struct {
+    gnrc_pktsnip_t *batch;      /**< packet of type @ref GNRC_NETTYPE_BATCH */
+    uint32_t demux_ctx;         /**< demultiplexing context of the subscribers */
+    gnrc_nettype_t type;        /**< type of the subscribers */
+    uint16_t cmd;               /**< command for the subscribers */
+    uint8_t numof;              /**< number of packets in gnrc_netapi_batch_t::batch */
+} gnrc_netapi_batch_t;
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_SND messages
  *
@@ -176,6 +220,60 @@ int gnrc_netapi_get(kernel_pid_t pid, netopt_t opt, uint16_t context,
 int gnrc_netapi_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
                     void *data, size_t data_len);
 
+#if defined(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Adds a packet to a batch for all subscribers to
+ *          (@p type, @p demux_ctx)
+ *
+ * @note    Only available with module `gnrc_netapi_batch`. All subscribers to
+ *          (@p type, @p demux_ctx) need to handle
+ *          @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH respectively.
+ *
+ * If @p batch holds packets for other subscribers or another command it is
+ * flushed first. If no batch can be allocated in the packet buffer @p pkt is
+ * dispatched on its own.
+ *
+ * @param[in,out] batch     the batch
+ * @param[in] type          type of the targeted network modules.
+ * @param[in] demux_ctx     demultiplexing context for @p type.
+ * @param[in] cmd           @ref GNRC_NETAPI_MSG_TYPE_RCV or
+ *                          @ref GNRC_NETAPI_MSG_TYPE_SND
+ * @param[in] pkt           the packet. The batch takes over the caller's
+ *                          reference if the packet was added.
+ *
+ * @return  Number of subscribers to (@p type, @p demux_ctx). If 0 the packet
+ *          was not added and still belongs to the caller.
+ */
+int gnrc_netapi_batch_add(gnrc_netapi_batch_t *batch, gnrc_nettype_t type,
+                          uint32_t demux_ctx, uint16_t cmd, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Sends the packets in @p batch to their subscribers with one message
+ *          each
+ *
+ * @note    Only available with module `gnrc_netapi_batch`.
+ *
+ * @param[in,out] batch     the batch. Is empty afterwards.
+ *
+ * @return  Number of subscribers the batch was dispatched to.
+ */
+int gnrc_netapi_batch_flush(gnrc_netapi_batch_t *batch);
+
+/**
+ * @brief   Hands every packet in a received batch to @p cb and releases the
+ *          batch
+ *
+ * @note    Only available with module `gnrc_netapi_batch`.
+ *
+ * @param[in] batch     content of a @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ *                      @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH message
+ * @param[in] cb        handler for a single packet. Takes over the reference
+ *                      to the packet.
+ */
+void gnrc_netapi_batch_drain(gnrc_pktsnip_t *batch, void (*cb)(gnrc_pktsnip_t *));
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,9 +29,14 @@
 #ifndef GNRC_NETDEV2_H
 #define GNRC_NETDEV2_H
 
+#include <stdbool.h>
+
 #include "kernel_types.h"
 #include "net/netdev2.h"
 #include "net/gnrc.h"
+#ifdef MODULE_GNRC_NETDEV2_TXQ
+#include "net/gnrc/pktqueue.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,6 +47,38 @@ extern "C" {
  */
 #define NETDEV2_MSG_TYPE_EVENT 0x1234
 
+#if defined(MODULE_GNRC_NETDEV2_TXQ) || defined(DOXYGEN)
+/**
+ * @brief   Number of packets the transmit queue of an interface can hold
+ */
+#ifndef GNRC_NETDEV2_TXQ_SIZE
+#define GNRC_NETDEV2_TXQ_SIZE       (8U)
+#endif
+
+/**
+ * @brief   Priority classes of the transmit queue
+ *
+ * Queued packets of a class are sent before any packet of the classes below.
+ */
+typedef enum {
+    GNRC_NETDEV2_TXQ_PRIO_CTRL = 0,     /**< control packets, e.g. NDP and RPL */
+    GNRC_NETDEV2_TXQ_PRIO_DATA,         /**< all other packets */
+    GNRC_NETDEV2_TXQ_PRIO_NUMOF,        /**< number of priority classes */
+} gnrc_netdev2_txq_prio_t;
+
+/**
+ * @brief   Policies to make room for a packet when the transmit queue is full
+ *
+ * Packets are only dropped from the lowest non-empty class that is not above
+ * the class of the new packet. If all queued packets are of a higher class,
+ * the new packet is dropped.
+ */
+typedef enum {
+    GNRC_NETDEV2_TXQ_DROP_TAIL = 0,     /**< drop the newest packet */
+    GNRC_NETDEV2_TXQ_DROP_HEAD,         /**< drop the oldest packet */
+} gnrc_netdev2_txq_policy_t;
+#endif
+
 /**
  * @brief Structure holding GNRC netdev2 adapter state
  *
@@ -77,6 +114,38 @@ typedef struct gnrc_netdev2 {
      * @brief PID of this adapter for netapi messages
      */
     kernel_pid_t pid;
+
+#if defined(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
+    /**
+     * @brief Received packets not yet passed on to the upper layer
+     */
+    gnrc_netapi_batch_t rx_batch;
+#endif
+
+#if defined(MODULE_GNRC_NETDEV2_TXQ) || defined(DOXYGEN)
+    /**
+     * @brief Packets not yet sent, one queue per priority class
+     */
+    gnrc_pktqueue_t *txq[GNRC_NETDEV2_TXQ_PRIO_NUMOF];
+
+    /**
+     * @brief Nodes for gnrc_netdev2_t::txq
+     */
+    gnrc_pktqueue_t txq_nodes[GNRC_NETDEV2_TXQ_SIZE];
+
+    /**
+     * @brief Number of packets in gnrc_netdev2_t::txq
+     */
+    uint8_t txq_numof;
+
+    /**
+     * @brief Drop policy of the transmit queue
+     *
+     * One of @ref gnrc_netdev2_txq_policy_t. Set it before calling
+     * gnrc_netdev2_init(), defaults to @ref GNRC_NETDEV2_TXQ_DROP_TAIL.
+     */
+    uint8_t txq_policy;
+#endif
 } gnrc_netdev2_t;
 
 /**
@@ -94,6 +163,37 @@ typedef struct gnrc_netdev2 {
 kernel_pid_t gnrc_netdev2_init(char *stack, int stacksize, char priority,
                                const char *name, gnrc_netdev2_t *gnrc_netdev2);
 
+#if defined(MODULE_GNRC_NETDEV2_TXQ) || defined(DOXYGEN)
+/**
+ * @brief   Empties the transmit queue of @p gnrc_netdev2
+ *
+ * @param[in] gnrc_netdev2  the adapter
+ */
+void gnrc_netdev2_txq_init(gnrc_netdev2_t *gnrc_netdev2);
+
+/**
+ * @brief   Queues a packet for sending
+ *
+ * Packets with @ref GNRC_NETIF_HDR_FLAGS_CTRL set in their interface header
+ * are queued in @ref GNRC_NETDEV2_TXQ_PRIO_CTRL. If the queue is full, a
+ * packet is dropped according to gnrc_netdev2_t::txq_policy.
+ *
+ * @param[in] gnrc_netdev2  the adapter
+ * @param[in] pkt           the packet, starting with its interface header
+ */
+void gnrc_netdev2_txq_add(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Sends the head of the highest non-empty priority class
+ *
+ * @param[in] gnrc_netdev2  the adapter
+ *
+ * @return  true, if a packet was sent
+ * @return  false, if the queue is empty
+ */
+bool gnrc_netdev2_txq_send(gnrc_netdev2_t *gnrc_netdev2);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
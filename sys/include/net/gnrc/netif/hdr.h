@@ -65,6 +65,16 @@ extern "C" {
  *          this flag the same way it does @ref GNRC_NETIF_HDR_FLAGS_BROADCAST.
  */
 #define GNRC_NETIF_HDR_FLAGS_MULTICAST  (0x40)
+
+/**
+ * @brief   Packet carries control traffic.
+ *
+ * @details The network layer sets this flag for control messages, e.g. NDP
+ *          and RPL, while it can still see them. Lower layers may then send
+ *          these packets first, even after their payload was compressed or
+ *          fragmented.
+ */
+#define GNRC_NETIF_HDR_FLAGS_CTRL       (0x20)
 /**
  * @}
  */
@@ -192,6 +202,28 @@ static inline void gnrc_netif_hdr_set_dst_addr(gnrc_netif_hdr_t *hdr, uint8_t *a
  */
 gnrc_pktsnip_t *gnrc_netif_hdr_build(uint8_t *src, uint8_t src_len, uint8_t *dst, uint8_t dst_len);
 
+/**
+ * @brief   Builds a generic network interface header for sending and
+ *          prepends it to a packet.
+ *
+ * The header is put into the headroom of @p pkt if it fits, see
+ * gnrc_pktbuf_push().
+ *
+ * @param[in] pkt       The packet to prepend the header to.
+ * @param[in] src       Source address for the header. Can be NULL if not
+ *                      known or required.
+ * @param[in] src_len   Length of @p src. Can be 0 if not known or required.
+ * @param[in] dst       Destination address for the header. Can be NULL if not
+ *                      known or required.
+ * @param[in] dst_len   Length of @p dst. Can be 0 if not known or required.
+ *
+ * @return  The generic network layer header on success, followed by @p pkt.
+ * @return  NULL on error.
+ */
+gnrc_pktsnip_t *gnrc_netif_hdr_push(gnrc_pktsnip_t *pkt, uint8_t *src,
+                                    uint8_t src_len, uint8_t *dst,
+                                    uint8_t dst_len);
+
 /**
  * @brief   Outputs a generic interface header to stdout.
  *
@@ -38,6 +38,16 @@ extern "C" {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+/**
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t
+ *
+ * Must be a power of two. Increase it if many demultiplexing contexts (e.g.
+ * UDP ports) are registered for one type.
+ */
+#ifndef GNRC_NETREG_BUCKETS
+#define GNRC_NETREG_BUCKETS         (4U)
+#endif
+
 /**
  * @brief   Entry to the @ref net_gnrc_netreg
  */
@@ -58,8 +68,27 @@ typedef struct gnrc_netreg_entry {
      */
     uint32_t demux_ctx;
     kernel_pid_t pid;       /**< The PID of the registering thread */
+
+    /**
+     * @brief   Number of registered entries with the same demultiplexing
+     *          context, only valid for the first of them
+     *
+     * @internal
+     */
+    uint16_t num;
 } gnrc_netreg_entry_t;
 
+/**
+ * @brief   Initializes a netreg entry statically with PID
+ *
+ * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                      for the netreg entry
+ * @param[in] pid       The PID of the registering thread
+ *
+ * @return  An initialized netreg entry
+ */
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, pid, 0 }
+
 /**
  * @brief   Initializes module.
  */
@@ -111,6 +140,10 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
  * @brief   Returns number of entries with the same gnrc_netreg_entry_t::type and
  *          gnrc_netreg_entry_t::demux_ctx.
  *
+ * @note    The number is cached in the registry, so this costs as much as
+ *          gnrc_netreg_lookup(). Use gnrc_netreg_entry_num() if you need
+ *          both.
+ *
  * @param[in] type      Type of the protocol.
  * @param[in] demux_ctx The demultiplexing context for the registered thread.
  *                      See gnrc_netreg_entry_t::demux_ctx.
@@ -120,6 +153,21 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
  */
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx);
 
+/**
+ * @brief   Returns the number of entries with the same
+ *          gnrc_netreg_entry_t::type and gnrc_netreg_entry_t::demux_ctx as
+ *          @p entry.
+ *
+ * @param[in] entry     A registry entry retrieved by gnrc_netreg_lookup().
+ *                      Must not be NULL.
+ *
+ * @return  Number of entries, including @p entry.
+ */
+static inline int gnrc_netreg_entry_num(const gnrc_netreg_entry_t *entry)
+{
+    return entry->num;
+}
+
 /**
  * @brief   Returns the next entry after @p entry with the same
  *          gnrc_netreg_entry_t::type and gnrc_netreg_entry_t::demux_ctx as the
@@ -40,6 +40,12 @@ extern "C" {
  * @note    Expand at will.
  */
 typedef enum {
+    /**
+     * @brief   Not so much protocol but an array of packets that is passed
+     *          between network modules with a single message. Not usable with
+     *          @ref net_gnrc_netreg
+     */
+    GNRC_NETTYPE_BATCH = -3,
     /**
      * @brief   Not so much protocol but data type that is passed to network
      *          devices using the netdev interface
@@ -32,6 +32,12 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Value of gnrc_pktsnip_t::chunk_offset for snips whose data lies in
+ *          the headroom of gnrc_pktsnip_t::shared
+ */
+#define GNRC_PKTSNIP_NO_CHUNK   (UINT16_MAX)
+
 /**
  * @brief   Type to represent parts (either headers or payload) of a packet,
  *          called snips.
@@ -115,6 +121,44 @@ typedef struct gnrc_pktsnip {
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
                                      *   packet snip */
 #endif
+#if defined(MODULE_GNRC_PKTBUF_HEADROOM) || defined(DOXYGEN)
+    /**
+     * @brief   Unused bytes directly in front of gnrc_pktsnip_t::data
+     *
+     * @see     gnrc_pktbuf_push()
+     *
+     * @internal
+     */
+    uint16_t headroom;
+
+    /**
+     * @brief   Bytes between the start of the chunk owned by this snip and
+     *          gnrc_pktsnip_t::data
+     *
+     * @ref GNRC_PKTSNIP_NO_CHUNK if gnrc_pktsnip_t::data lies in the headroom
+     * of another snip.
+     *
+     * @internal
+     */
+    uint16_t chunk_offset;
+#endif
+#if defined(MODULE_GNRC_PKTBUF_HEADROOM) || defined(MODULE_GNRC_PKTBUF_COW) || \
+    defined(DOXYGEN)
+    /**
+     * @brief   Snip whose data this snip shares or whose headroom its data
+     *          lies in, NULL if it has data of its own
+     *
+     * A snip sharing the data of another one holds a reference
+     * (gnrc_pktsnip_t::users) to it until it is released or gets its own
+     * copy of the data.
+     *
+     * @see     gnrc_pktbuf_push()
+     * @see     gnrc_pktbuf_start_write_snip()
+     *
+     * @internal
+     */
+    struct gnrc_pktsnip *shared;
+#endif
 } gnrc_pktsnip_t;
 
 /**
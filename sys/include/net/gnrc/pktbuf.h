@@ -18,6 +18,12 @@
  *          this *will* lead to alignment problems and can potentially result
  *          in segmentation/hard faults and other unexpected behaviour.
  *
+ * The default implementation `gnrc_pktbuf_static` manages the buffer with a
+ * first-fit free list. As an alternative, `gnrc_pktbuf_sizeclass` keeps free
+ * chunks in segregated size classes (snip descriptors, header-sized chunks and
+ * payloads) and allocates and frees in constant time, which keeps the buffer
+ * less fragmented under bursty traffic.
+ *
  * @{
  *
  * @file
@@ -85,6 +91,75 @@ void gnrc_pktbuf_init(void);
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
                                 gnrc_nettype_t type);
 
+#if defined(MODULE_GNRC_PKTBUF_HEADROOM) || defined(DOXYGEN)
+/**
+ * @brief   Adds a new gnrc_pktsnip_t with room for headers in front of its data
+ *          to the packet buffer.
+ *
+ * Headers added with gnrc_pktbuf_push() on top of the new snip are put into
+ * this room, so the packet ends up in one contiguous chunk and the headers do
+ * not need allocations of their own.
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet. Leave NULL if you
+ *                      want to create a new packet.
+ * @param[in] data      Data of the new gnrc_pktsnip_t. If @p data is NULL no data
+ *                      will be inserted into `result`.
+ * @param[in] size      Length of @p data. May not be 0.
+ * @param[in] headroom  Bytes to reserve in front of the data. Rounded up to
+ *                      the alignment of the packet buffer.
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer.
+ * @return  NULL, if @p size == 0.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type);
+
+/**
+ * @brief   Prepends a header to @p pkt, in the headroom of @p pkt if possible.
+ *
+ * The new snip's data is taken from the headroom of @p pkt, if it is large
+ * enough and @p size keeps the header aligned. The rest of the headroom is
+ * passed on to the new snip. Otherwise this is the same as gnrc_pktbuf_add().
+ *
+ * A snip taking its data from the headroom of @p pkt holds a reference
+ * (gnrc_pktsnip_t::users) to the snip owning the memory, so it stays valid
+ * when @p pkt is released or replaced first.
+ *
+ * @note    gnrc_pktbuf_mark() and gnrc_pktbuf_realloc_data() must not move or
+ *          split the data of @p pkt while the new snip is in use.
+ *
+ * @param[in] pkt       The packet to prepend the header to.
+ * @param[in] data      Data of the header. If @p data is NULL no data will be
+ *                      inserted into `result`.
+ * @param[in] size      Length of the header. May not be 0.
+ * @param[in] type      Protocol type of the header.
+ *
+ * @return  Pointer to the packet part that represents the new header.
+ * @return  NULL, if no space is left in the packet buffer.
+ * @return  NULL, if @p size == 0.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_push(gnrc_pktsnip_t *pkt, void *data, size_t size,
+                                 gnrc_nettype_t type);
+#else
+static inline gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next,
+                                                       void *data, size_t size,
+                                                       size_t headroom,
+                                                       gnrc_nettype_t type)
+{
+    (void)headroom;
+    return gnrc_pktbuf_add(next, data, size, type);
+}
+
+static inline gnrc_pktsnip_t *gnrc_pktbuf_push(gnrc_pktsnip_t *pkt, void *data,
+                                               size_t size, gnrc_nettype_t type)
+{
+    return gnrc_pktbuf_add(pkt, data, size, type);
+}
+#endif
+
 /**
  * @brief   Marks the first @p size bytes in a received packet with a new
  *          packet snip that is appended to the packet.
@@ -179,6 +254,53 @@ static inline void gnrc_pktbuf_release(gnrc_pktsnip_t *pkt)
  */
 gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt);
 
+#if defined(MODULE_GNRC_PKTBUF_COW) || defined(DOXYGEN)
+/**
+ * @brief   Statistics on snips sharing their data
+ */
+typedef struct {
+    uint32_t shared;        /**< snips duplicated without copying their data */
+    uint32_t shared_bytes;  /**< bytes not copied because of that */
+    uint32_t copied;        /**< shared data copied by gnrc_pktbuf_start_write() */
+} gnrc_pktbuf_cow_stats_t;
+
+/**
+ * @brief   Must be called once before the snip (but not its data) is changed
+ *          in a thread, e.g. to mark a header in it with gnrc_pktbuf_mark().
+ *
+ * @details If gnrc_pktsnip_t::users of @p pkt > 1 only the snip is
+ *          duplicated. The duplicate shares the data of @p pkt, which is only
+ *          copied once gnrc_pktbuf_start_write() is called on it (or on a
+ *          part of it marked with gnrc_pktbuf_mark()). Snips received by
+ *          several subscribers thus don't need their payload copied just to
+ *          have their headers marked.
+ *
+ * @note    Do *not* call this function in a thread twice on the same packet.
+ *          Do *not* write into the data of the returned snip without calling
+ *          gnrc_pktbuf_start_write() on it first, even if its
+ *          gnrc_pktsnip_t::users is 1.
+ *
+ * @param[in] pkt   The packet you want to change.
+ *
+ * @return  The (new) pointer to the pkt.
+ * @return  NULL, if gnrc_pktsnip_t::users of @p pkt > 1 and if there is not
+ *          enough space in the packet buffer.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_start_write_snip(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Gets the statistics on snips sharing their data
+ *
+ * @param[out] stats    The statistics.
+ */
+void gnrc_pktbuf_cow_stats(gnrc_pktbuf_cow_stats_t *stats);
+#else
+static inline gnrc_pktsnip_t *gnrc_pktbuf_start_write_snip(gnrc_pktsnip_t *pkt)
+{
+    return gnrc_pktbuf_start_write(pkt);
+}
+#endif
+
 /**
  * @brief   Create a IOVEC representation of the packet pointed to by *pkt*
  *
@@ -271,7 +393,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes. With
+ *          `gnrc_pktbuf_sizeclass` they include the bytes and chunks currently
+ *          in use and their high-water marks per size class (snip
+ *          descriptors, headers, payloads).
  */
 void gnrc_pktbuf_stats(void);
 #endif
@@ -113,6 +113,18 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
                                                 uint8_t prefix_len, uint16_t ltime,
                                                 bool comp);
 
+/**
+ * @brief   Gets the generation of the context buffer.
+ *
+ * @details The generation changes every time a context is added or updated
+ *          with gnrc_sixlowpan_ctx_update(). Users caching the results of
+ *          gnrc_sixlowpan_ctx_lookup_addr() can use it to detect new
+ *          contexts.
+ *
+ * @return  The current generation of the context buffer.
+ */
+uint16_t gnrc_sixlowpan_ctx_generation(void);
+
 #ifdef MODULE_GNRC_SIXLOWPAN_CTX
 /**
  * @brief   Removes context.
@@ -53,6 +53,16 @@ typedef struct {
                              *   payload datagram */
 } gnrc_sixlowpan_msg_frag_t;
 
+/**
+ * @brief   Statistics of the reassembly buffer
+ */
+typedef struct {
+    uint32_t complete;      /**< datagrams reassembled */
+    uint32_t drops;         /**< fragments or datagrams dropped */
+    uint32_t evictions;     /**< incomplete datagrams evicted for a new one */
+    uint32_t timeouts;      /**< incomplete datagrams timed out */
+} gnrc_sixlowpan_frag_stats_t;
+
 /**
  * @brief   Sends a packet fragmented.
  *
@@ -68,6 +78,13 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
  */
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Get the statistics of the reassembly buffer.
+ *
+ * @return  The statistics since startup.
+ */
+const gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
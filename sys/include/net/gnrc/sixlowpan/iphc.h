@@ -23,12 +23,41 @@
 #include <stdbool.h>
 
 #include "net/gnrc/pkt.h"
+#include "net/ipv6/hdr.h"
 #include "net/sixlowpan.h"
+#include "net/udp.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Size of the IPv6 header snip to pre-allocate for
+ *          gnrc_sixlowpan_iphc_decode() for unfragmented packets.
+ *
+ * @details Leaves room behind the IPv6 header to decode a compressed UDP
+ *          header in place.
+ */
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+#define GNRC_SIXLOWPAN_IPHC_DEC_HDR_LEN (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t))
+#else
+#define GNRC_SIXLOWPAN_IPHC_DEC_HDR_LEN (sizeof(ipv6_hdr_t))
+#endif
+
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Number of flows for which the compressed addresses are cached
+ *          by gnrc_sixlowpan_iphc_encode().
+ *
+ * @details A flow is identified by the interface, the link-layer addresses
+ *          and the IPv6 source and destination address of a packet. The
+ *          cache is used with module `gnrc_sixlowpan_iphc_cache`.
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define GNRC_SIXLOWPAN_IPHC_CACHE_SIZE  (4)
+#endif
+#endif
+
 /**
  * @brief   Decompresses a received 6LoWPAN IPHC frame.
  *
@@ -36,6 +65,10 @@ extern "C" {
  *
  * @param[out] dec_hdr      A pre-allocated IPv6 header. Will not be inserted into
  *                          @p pkt. May change due to next headers being added in NHC.
+ *                          For unfragmented packets it should be of size
+ *                          @ref GNRC_SIXLOWPAN_IPHC_DEC_HDR_LEN, so compressed
+ *                          next headers are decoded in place. Unused space
+ *                          is given back to the packet buffer.
  * @param[in] pkt           A received 6LoWPAN IPHC frame. IPHC dispatch will not
  *                          be marked.
  * @param[in] datagram_size Size of the full uncompressed IPv6 datagram. May be 0, if @p pkt
@@ -60,6 +93,17 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
  */
 bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Empties the flow cache of gnrc_sixlowpan_iphc_encode().
+ *
+ * @details Changes of the 6LoWPAN contexts are detected by the cache itself.
+ *          This is only needed when the IPv6 IID of an interface changes
+ *          that does not provide it in its link-layer address.
+ */
+void gnrc_sixlowpan_iphc_cache_flush(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
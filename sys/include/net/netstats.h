@@ -39,6 +39,11 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+#if defined(MODULE_GNRC_NETDEV2_TXQ) || defined(DOXYGEN)
+    uint32_t tx_queue_len;      /**< packets currently in the transmit queue */
+    uint32_t tx_queue_max;      /**< most packets in the transmit queue */
+    uint32_t tx_queue_drops;    /**< packets dropped by the transmit queue */
+#endif
 } netstats_t;
 
 #ifdef __cplusplus
@@ -23,6 +23,9 @@
 #ifndef __PS_H
 #define __PS_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -32,6 +35,93 @@ extern "C" {
  */
 void ps(void);
 
+#if defined(MODULE_SCHEDSTATISTICS) || defined(DOXYGEN)
+/**
+ * @brief   Magic number at the start of a dump ("RPS1" in little endian)
+ */
+#define PS_DUMP_MAGIC       (0x31535052)
+
+/**
+ * @brief   Version of the dump format
+ */
+#define PS_DUMP_VERSION     (1)
+
+/**
+ * @brief   Status of a thread in a binary dump
+ *
+ * These values are part of the dump format. They do not follow changes of
+ * the `STATUS_*` values in thread.h.
+ */
+typedef enum {
+    PS_DUMP_STATUS_STOPPED = 0,         /**< @ref STATUS_STOPPED */
+    PS_DUMP_STATUS_SLEEPING,            /**< @ref STATUS_SLEEPING */
+    PS_DUMP_STATUS_MUTEX_BLOCKED,       /**< @ref STATUS_MUTEX_BLOCKED */
+    PS_DUMP_STATUS_RECEIVE_BLOCKED,     /**< @ref STATUS_RECEIVE_BLOCKED */
+    PS_DUMP_STATUS_SEND_BLOCKED,        /**< @ref STATUS_SEND_BLOCKED */
+    PS_DUMP_STATUS_REPLY_BLOCKED,       /**< @ref STATUS_REPLY_BLOCKED */
+    PS_DUMP_STATUS_FLAG_BLOCKED_ANY,    /**< @ref STATUS_FLAG_BLOCKED_ANY */
+    PS_DUMP_STATUS_FLAG_BLOCKED_ALL,    /**< @ref STATUS_FLAG_BLOCKED_ALL */
+    PS_DUMP_STATUS_RUNNING,             /**< @ref STATUS_RUNNING */
+    PS_DUMP_STATUS_PENDING,             /**< @ref STATUS_PENDING */
+    PS_DUMP_STATUS_MBOX_BLOCKED,        /**< @ref STATUS_MBOX_BLOCKED */
+} ps_dump_status_t;
+
+/**
+ * @brief   Header of a binary dump of the scheduler statistics
+ *
+ * All fields are in host byte order, times are in ticks of
+ * ps_dump_hdr_t::clock_hz.
+ */
+typedef struct {
+    uint32_t magic;         /**< @ref PS_DUMP_MAGIC */
+    uint16_t version;       /**< @ref PS_DUMP_VERSION */
+    uint16_t numof;         /**< number of records following the header */
+    uint32_t clock_hz;      /**< frequency of the statistics clock */
+    uint32_t reserved;      /**< reserved, 0 */
+    uint64_t now;           /**< time the dump was taken */
+} ps_dump_hdr_t;
+
+/**
+ * @brief   Per-thread record of a binary dump
+ */
+typedef struct {
+    uint64_t runtime;       /**< total runtime */
+    uint64_t irq_off;       /**< time spent with interrupts disabled */
+    uint32_t schedules;     /**< number of times the thread was scheduled */
+    uint32_t voluntary;     /**< number of voluntary context switches */
+    uint32_t involuntary;   /**< number of involuntary context switches */
+    uint32_t max_latency;   /**< maximum run queue latency */
+    int16_t pid;            /**< pid of the thread */
+    uint8_t status;         /**< status of the thread, see @ref ps_dump_status_t */
+    uint8_t priority;       /**< priority of the thread */
+    uint32_t reserved;      /**< reserved, 0 */
+} ps_dump_rec_t;
+
+/**
+ * @brief   Callback receiving the parts of a binary dump
+ *
+ * @param[in] data  header or record of the dump
+ * @param[in] len   length of @p data
+ * @param[in] arg   argument given to ps_dump()
+ */
+typedef void (*ps_dump_cb_t)(const void *data, size_t len, void *arg);
+
+/**
+ * @brief   Writes a binary dump of the scheduler statistics
+ *
+ * The dump consists of a @ref ps_dump_hdr_t followed by one
+ * @ref ps_dump_rec_t per active thread. It is meant to be read on the host
+ * to find the threads that use most of the CPU.
+ *
+ * The header and the records are handed to @p cb one at a time, so the
+ * caller needs no buffer for the whole dump.
+ *
+ * @param[in] cb    callback called for the header and every record
+ * @param[in] arg   argument passed to @p cb
+ */
+void ps_dump(ps_dump_cb_t cb, void *arg);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
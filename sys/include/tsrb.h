@@ -17,7 +17,14 @@
  * @brief       Thread-safe ringbuffer implementation
  *
  * This ringbuffer implementation can be used without locking if
- * there's only one producer and one consumer.
+ * there's only one producer and one consumer, e.g. an ISR writing received
+ * bytes and the thread processing them.
+ *
+ * Besides the byte and bulk copy functions, the free and the used space can
+ * be accessed in place: tsrb_add_reserve() returns the largest contiguous
+ * free region, which the producer fills (e.g. by DMA) and hands over with
+ * tsrb_add_commit(). tsrb_get_reserve() and tsrb_get_commit() do the same
+ * for the consumer.
  *
  * @note Buffer size must be a power of two!
  *
@@ -146,6 +153,48 @@ int tsrb_add_one(tsrb_t *rb, char c);
  */
 int tsrb_add(tsrb_t *rb, const char *src, size_t n);
 
+/**
+ * @brief       Get the largest contiguous free region of the ringbuffer
+ *
+ * The region can be written to in place and is handed to the consumer with
+ * tsrb_add_commit(). Must only be called by the producer.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  ptr start of the free region
+ * @return      nr of bytes that can be written to @p ptr
+ */
+size_t tsrb_add_reserve(tsrb_t *rb, char **ptr);
+
+/**
+ * @brief       Mark bytes written to a region returned by tsrb_add_reserve()
+ *              as available for reading
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written, must not be greater than the value
+ *                  returned by tsrb_add_reserve()
+ */
+void tsrb_add_commit(tsrb_t *rb, size_t n);
+
+/**
+ * @brief       Get the largest contiguous region of unread bytes
+ *
+ * The bytes can be read in place and are released with tsrb_get_commit().
+ * Must only be called by the consumer.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  ptr start of the unread bytes
+ * @return      nr of bytes that can be read from @p ptr
+ */
+size_t tsrb_get_reserve(tsrb_t *rb, char **ptr);
+
+/**
+ * @brief       Release bytes read from a region returned by
+ *              tsrb_get_reserve()
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes read, must not be greater than the value
+ *                  returned by tsrb_get_reserve()
+ */
+void tsrb_get_commit(tsrb_t *rb, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_uart_escape UART byte stuffing
+ * @ingroup     sys
+ * @brief       Writes escaped frame content to a UART
+ *
+ * SLIP-like framings (e.g. @ref net_gnrc_slip and @ref drivers_ethos) mark
+ * frame boundaries with a delimiter byte. Within a frame, the delimiter and
+ * the escape byte are replaced with two-byte sequences starting with the
+ * escape byte.
+ *
+ * uart_escape_write() writes each run of plain bytes with a single
+ * uart_write() call, instead of one call per byte.
+ *
+ * @{
+ *
+ * @file
+ * @brief       UART byte stuffing interface
+ */
+
+#ifndef UART_ESCAPE_H
+#define UART_ESCAPE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "periph/uart.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Escape sequences of a framing
+ */
+typedef struct {
+    uint8_t delim;      /**< frame delimiter */
+    uint8_t esc;        /**< escape byte */
+    uint8_t delim_esc;  /**< byte following uart_escape_t::esc for a delimiter */
+    uint8_t esc_esc;    /**< byte following uart_escape_t::esc for an escape byte */
+} uart_escape_t;
+
+/**
+ * @brief   Writes @p data to @p uart, escaping delimiter and escape bytes
+ *
+ * @param[in] uart      UART device to write to
+ * @param[in] escape    escape sequences to use
+ * @param[in] data      frame content
+ * @param[in] len       length of @p data
+ */
+void uart_escape_write(uart_t uart, const uart_escape_t *escape,
+                       const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_ESCAPE_H */
+/** @} */
@@ -11,6 +11,11 @@
  * @ingroup     sys
  * @brief       universal address container
  *
+ * Addresses are interned in a hash table: every distinct address is stored
+ * once and shared by reference counting. The content of a container does
+ * not change while it is referenced, so reading it through
+ * universal_address_get_address() or the compare functions needs no lock.
+ *
  * @{
  *
  * @file
@@ -57,7 +62,7 @@ extern "C" {
  * @brief The container descriptor used to identify a universal address entry
  */
 typedef struct {
-    uint8_t use_count;                       /**< The number of entries link here */
+    uint16_t use_count;                      /**< The number of entries link here */
     uint8_t address_size;                    /**< Size in bytes of the used generic address */
     uint8_t address[UNIVERSAL_ADDRESS_SIZE]; /**< The generic address data */
 } universal_address_container_t;
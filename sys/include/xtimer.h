@@ -20,6 +20,14 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * Alternatively, the pseudomodule `xtimer_wheel` selects a hierarchical timing
+ * wheel backend at build time. With it, timers are hashed into buckets by
+ * their target time, so insertion and removal take constant time and the
+ * windows in which interrupts are disabled no longer grow with the number of
+ * active timers. Only timers expiring within the current wheel tick (see
+ * @ref XTIMER_WHEEL_SHIFT) are kept in a sorted list. The API is the same for
+ * both backends.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -30,6 +38,9 @@
 
 #include <stdint.h>
 #include "msg.h"
+#ifdef MODULE_CORE_MBOX
+#include "mbox.h"
+#endif
 #include "periph/timer.h"
 #include "timex.h"
 
@@ -62,6 +73,10 @@ typedef struct xtimer {
     timer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                  /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    struct xtimer **pprev;      /**< reference to the pointer pointing to this
+                                     timer (only with `xtimer_wheel`) */
+#endif
 } xtimer_t;
 
 /**
@@ -258,7 +273,8 @@ void xtimer_set(xtimer_t *timer, uint32_t offset);
 /**
  * @brief remove a timer
  *
- * @note this function runs in O(n) with n being the number of active timers
+ * @note this function runs in O(n) with n being the number of active timers,
+ *       or in O(1) with the `xtimer_wheel` backend
  *
  * @param[in] timer ptr to timer structure that will be removed
  */
@@ -286,6 +302,20 @@ int xtimer_msg_receive_timeout(msg_t *msg, uint32_t us);
  */
 int xtimer_msg_receive_timeout64(msg_t *msg, uint64_t us);
 
+#if defined(MODULE_CORE_MBOX) || defined(DOXYGEN)
+/**
+ * @brief get a message from a mailbox blocking but with timeout
+ *
+ * @param[in]   mbox    mailbox to get the message from
+ * @param[out]  msg     pointer to a msg_t which will be filled in case of
+ *                      no timeout
+ * @param[in]   us      timeout in microseconds relative
+ *
+ * @return       < 0 on timeout, other value otherwise
+ */
+int xtimer_mbox_get_timeout(mbox_t *mbox, msg_t *msg, uint32_t us);
+#endif
+
 /**
  * @brief xtimer backoff value
  *
@@ -395,6 +425,36 @@ int xtimer_msg_receive_timeout64(msg_t *msg, uint64_t us);
 #endif
 #define XTIMER_MASK_SHIFTED XTIMER_TICKS_TO_USEC(XTIMER_MASK)
 
+#ifndef XTIMER_WHEEL_SHIFT
+/**
+ * @brief   Granularity of the timing wheel as power of two microseconds
+ *
+ * Only used with the `xtimer_wheel` backend. Timers expiring within the same
+ * wheel tick of (1 << XTIMER_WHEEL_SHIFT) microseconds are kept sorted, all
+ * others are hashed into the wheel in O(1). Must not exceed the width of the
+ * low-level timer, i.e., be at most 16 for 16bit timers.
+ */
+#define XTIMER_WHEEL_SHIFT  (10)
+#endif
+
+#ifndef XTIMER_WHEEL_BITS
+/**
+ * @brief   Number of slots per wheel level as power of two (at most 5)
+ */
+#define XTIMER_WHEEL_BITS   (5)
+#endif
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of wheel levels
+ *
+ * The wheel covers (1 << (XTIMER_WHEEL_SHIFT + XTIMER_WHEEL_BITS *
+ * XTIMER_WHEEL_LEVELS)) microseconds, ~9.5h with the defaults. Timers further
+ * in the future are parked in the last level and re-hashed once it wraps.
+ */
+#define XTIMER_WHEEL_LEVELS (5)
+#endif
+
 #if XTIMER_MASK
 extern volatile uint32_t _high_cnt;
 #endif
@@ -51,6 +51,7 @@ void uhcp_client(uhcp_iface_t iface)
 
     kernel_pid_t pid = thread_getpid();
     xtimer_t timeout;
+    timeout.target = timeout.long_target = 0;
     timeout.callback = _timeout;
     timeout.arg = &pid;
 
@@ -13,6 +13,7 @@
  */
 
 #include <inttypes.h>
+#include <stdint.h>
 #include <stdio.h>
 #include "od.h"
 #include "net/inet_csum.h"
@@ -20,9 +21,86 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/**
+ * @brief   Adds @p word to @p acc with end-around carry
+ */
+static inline uint32_t _add(uint32_t acc, uint32_t word)
+{
+    acc += word;
+    return acc + (acc < word);
+}
+
+/**
+ * @brief   Folds a 32-bit one's complement sum to 16 bits
+ */
+static inline uint16_t _fold(uint32_t acc)
+{
+    while (acc >> 16) {
+        acc = (acc & 0xffff) + (acc >> 16);
+    }
+    return acc;
+}
+
+static inline uint16_t _swap(uint16_t sum)
+{
+    return (sum >> 8) | (sum << 8);
+}
+
+/* words are loaded from byte buffers, the types may alias them */
+typedef uint16_t __attribute__((may_alias)) _u16_alias_t;
+typedef uint32_t __attribute__((may_alias)) _u32_alias_t;
+
+/**
+ * @brief   Sums @p buf as 16-bit words in host byte order
+ *
+ * @pre @p buf is 2-byte aligned and starts at an even offset of the
+ *      checksum domain
+ */
+static uint32_t _sum_words(const uint8_t *buf, uint16_t len)
+{
+    uint32_t acc = 0;
+    const _u32_alias_t *word;
+
+    /* word loads are aligned from here on */
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        acc = *((const _u16_alias_t *)buf);
+        buf += 2;
+        len -= 2;
+    }
+    word = (const _u32_alias_t *)buf;
+    while (len >= 16) {
+        acc = _add(acc, word[0]);
+        acc = _add(acc, word[1]);
+        acc = _add(acc, word[2]);
+        acc = _add(acc, word[3]);
+        word += 4;
+        len -= 16;
+    }
+    while (len >= 4) {
+        acc = _add(acc, *(word++));
+        len -= 4;
+    }
+    buf = (const uint8_t *)word;
+    if (len >= 2) {
+        acc = _add(acc, *((const _u16_alias_t *)buf));
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        /* add last byte as top half of 16-bit word */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        acc = _add(acc, *buf);
+#else
+        acc = _add(acc, (uint32_t)*buf << 8);
+#endif
+    }
+    return acc;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
+    uint16_t words;
 
     DEBUG("inet_sum: sum = 0x%04" PRIx16 ", len = %" PRIu16, sum, len);
 #if ENABLE_DEBUG
@@ -41,21 +119,28 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
-    }
-
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
     }
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    if (len == 0)
+        return _fold(csum);
 
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
+    if ((uintptr_t)buf & 1) {
+        /* Sum the rest from the next aligned byte. Its words are shifted by
+         * one byte against the words of the checksum domain, which is undone
+         * by swapping the bytes of their sum (RFC 1071, 2.(B)). */
+        csum += (uint16_t)(*buf << 8);
+        words = _fold(_sum_words(buf + 1, len - 1));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        words = _swap(words);
+#endif
+    }
+    else {
+        words = _fold(_sum_words(buf, len));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        words = _swap(words);
+#endif
     }
+    csum = _fold(csum + words);
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
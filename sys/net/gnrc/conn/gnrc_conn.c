@@ -20,6 +20,37 @@
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/udp.h"
+#ifdef MODULE_GNRC_CONN_UDP
+#include "xtimer.h"
+#endif
+
+/* extracts sender information, returns false if the headers are missing */
+static bool _get_src(conn_t *conn, gnrc_pktsnip_t *pkt, void *addr, size_t *addr_len,
+                     uint16_t *port)
+{
+    gnrc_pktsnip_t *l3hdr = gnrc_pktsnip_search_type(pkt, conn->l3_type);
+
+    if (l3hdr == NULL) {
+        return false;
+    }
+#if defined(MODULE_CONN_UDP) || defined(MODULE_CONN_TCP)
+    if ((conn->l4_type != GNRC_NETTYPE_UNDEF) && (port != NULL)) {
+        gnrc_pktsnip_t *l4hdr;
+        l4hdr = gnrc_pktsnip_search_type(pkt, conn->l4_type);
+        if (l4hdr == NULL) {
+            return false;
+        }
+        *port = byteorder_ntohs(((udp_hdr_t *)l4hdr->data)->src_port);
+    }
+#else
+    (void)port;
+#endif  /* defined(MODULE_CONN_UDP) */
+    if (addr != NULL) {
+        memcpy(addr, &((ipv6_hdr_t *)l3hdr->data)->src, sizeof(ipv6_addr_t));
+        *addr_len = sizeof(ipv6_addr_t);
+    }
+    return true;
+}
 
 int gnrc_conn_recvfrom(conn_t *conn, void *data, size_t max_len, void *addr, size_t *addr_len,
                        uint16_t *port)
@@ -27,35 +58,20 @@ int gnrc_conn_recvfrom(conn_t *conn, void *data, size_t max_len, void *addr, siz
     msg_t msg;
     int timeout = 3;
     while ((timeout--) > 0) {
-        gnrc_pktsnip_t *pkt, *l3hdr;
+        gnrc_pktsnip_t *pkt;
         size_t size = 0;
         msg_receive(&msg);
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 pkt = (gnrc_pktsnip_t *)msg.content.ptr;
                 if (pkt->size > max_len) {
+                    gnrc_pktbuf_release(pkt);
                     return -ENOMEM;
                 }
-                l3hdr = gnrc_pktsnip_search_type(pkt, conn->l3_type);
-                if (l3hdr == NULL) {
+                if (!_get_src(conn, pkt, addr, addr_len, port)) {
                     msg_send_to_self(&msg); /* requeue invalid messages */
                     continue;
                 }
-#if defined(MODULE_CONN_UDP) || defined(MODULE_CONN_TCP)
-                if ((conn->l4_type != GNRC_NETTYPE_UNDEF) && (port != NULL)) {
-                    gnrc_pktsnip_t *l4hdr;
-                    l4hdr = gnrc_pktsnip_search_type(pkt, conn->l4_type);
-                    if (l4hdr == NULL) {
-                        msg_send_to_self(&msg); /* requeue invalid messages */
-                        continue;
-                    }
-                    *port = byteorder_ntohs(((udp_hdr_t *)l4hdr->data)->src_port);
-                }
-#endif  /* defined(MODULE_CONN_UDP) */
-                if (addr != NULL) {
-                    memcpy(addr, &((ipv6_hdr_t *)l3hdr->data)->src, sizeof(ipv6_addr_t));
-                    *addr_len = sizeof(ipv6_addr_t);
-                }
                 memcpy(data, pkt->data, pkt->size);
                 size = pkt->size;
                 gnrc_pktbuf_release(pkt);
@@ -69,6 +85,35 @@ int gnrc_conn_recvfrom(conn_t *conn, void *data, size_t max_len, void *addr, siz
     return -ETIMEDOUT;
 }
 
+#ifdef MODULE_GNRC_CONN_UDP
+int gnrc_conn_recv_buf(conn_t *conn, gnrc_pktsnip_t **pkt, uint32_t timeout, void *addr,
+                       size_t *addr_len, uint16_t *port)
+{
+    msg_t msg;
+    int tries = 3;
+    while ((tries--) > 0) {
+        if (timeout == 0) {
+            if (msg_try_receive(&msg) < 0) {
+                return -EAGAIN;
+            }
+        }
+        else if (timeout == UINT32_MAX) {
+            msg_receive(&msg);
+        }
+        else if (xtimer_msg_receive_timeout(&msg, timeout) < 0) {
+            return -ETIMEDOUT;
+        }
+        if ((msg.type == GNRC_NETAPI_MSG_TYPE_RCV) &&
+            _get_src(conn, (gnrc_pktsnip_t *)msg.content.ptr, addr, addr_len, port)) {
+            *pkt = (gnrc_pktsnip_t *)msg.content.ptr;
+            return (int)(*pkt)->size;
+        }
+        msg_send_to_self(&msg); /* requeue invalid messages */
+    }
+    return -ETIMEDOUT;
+}
+#endif
+
 #ifdef MODULE_GNRC_IPV6
 bool gnrc_conn6_set_local_addr(uint8_t *conn_addr, const ipv6_addr_t *addr)
 {
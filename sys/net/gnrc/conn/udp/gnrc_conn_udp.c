@@ -19,10 +19,16 @@
 #include "net/af.h"
 #include "net/gnrc/conn.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/udp.h"
 
 #include "net/conn/udp.h"
 
+/* room for the headers added by gnrc_udp_hdr_build(), gnrc_ipv6_hdr_build()
+ * and gnrc_netif_hdr_push() */
+#define _HEADROOM   (sizeof(udp_hdr_t) + sizeof(ipv6_hdr_t) + \
+                     sizeof(gnrc_netif_hdr_t) + GNRC_NETIF_HDR_L2ADDR_MAX_LEN)
+
 int conn_udp_create(conn_udp_t *conn, const void *addr, size_t addr_len,
                     int family, uint16_t port)
 {
@@ -89,13 +95,49 @@ int conn_udp_recvfrom(conn_udp_t *conn, void *data, size_t max_len, void *addr,
     }
 }
 
+int conn_udp_recv_buf(conn_udp_t *conn, void **data, void **buf_ctx, uint32_t timeout,
+                      void *addr, size_t *addr_len, uint16_t *port)
+{
+    assert(conn->l4_type == GNRC_NETTYPE_UDP);
+    switch (conn->l3_type) {
+#ifdef MODULE_GNRC_IPV6
+        case GNRC_NETTYPE_IPV6: {
+            gnrc_pktsnip_t *pkt;
+            int res = gnrc_conn_recv_buf((conn_t *)conn, &pkt, timeout, addr, addr_len, port);
+            if (res >= 0) {
+                *data = pkt->data;
+                *buf_ctx = pkt;
+            }
+            return res;
+        }
+#endif
+        default:
+            (void)data;
+            (void)buf_ctx;
+            (void)timeout;
+            (void)addr;
+            (void)addr_len;
+            (void)port;
+            return -EBADF;
+    }
+}
+
+void conn_udp_recv_buf_release(conn_udp_t *conn, void *buf_ctx)
+{
+    assert(conn->l4_type == GNRC_NETTYPE_UDP);
+    (void)conn;
+    gnrc_pktbuf_release((gnrc_pktsnip_t *)buf_ctx);
+}
+
 int conn_udp_sendto(const void *data, size_t len, const void *src, size_t src_len,
                     const void *dst, size_t dst_len, int family, uint16_t sport,
                     uint16_t dport)
 {
     gnrc_pktsnip_t *pkt, *hdr = NULL;
 
-    pkt = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF); /* data will only be copied */
+    /* data will only be copied */
+    pkt = gnrc_pktbuf_add_headroom(NULL, (void *)data, len, _HEADROOM,
+                                   GNRC_NETTYPE_UNDEF);
     hdr = gnrc_udp_hdr_build(pkt, sport, dport);
     if (hdr == NULL) {
         gnrc_pktbuf_release(pkt);
@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include "msg.h"
 #include "thread.h"
@@ -39,7 +40,7 @@
 
 #define NETDEV2_NETAPI_MSG_QUEUE_SIZE 8
 
-static void _pass_on_packet(gnrc_pktsnip_t *pkt);
+static void _pass_on_packet(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt);
 
 /**
  * @brief   Function called by the device driver on device events
@@ -70,7 +71,7 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event, void *data)
                     gnrc_pktsnip_t *pkt = gnrc_netdev2->recv(gnrc_netdev2);
 
                     if (pkt) {
-                        _pass_on_packet(pkt);
+                        _pass_on_packet(gnrc_netdev2, pkt);
                     }
 
                     break;
@@ -89,10 +90,18 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event, void *data)
     }
 }
 
-static void _pass_on_packet(gnrc_pktsnip_t *pkt)
+static void _pass_on_packet(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
 {
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    /* throw away packet if no one is interested */
+    if (!gnrc_netapi_batch_add(&gnrc_netdev2->rx_batch, pkt->type,
+                               GNRC_NETREG_DEMUX_CTX_ALL,
+                               GNRC_NETAPI_MSG_TYPE_RCV, pkt)) {
+#else
+    (void)gnrc_netdev2;
     /* throw away packet if no one is interested */
     if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+#endif
         DEBUG("gnrc_netdev2: unable to forward packet of type %i\n", pkt->type);
         gnrc_pktbuf_release(pkt);
         return;
@@ -114,6 +123,12 @@ static void *_gnrc_netdev2_thread(void *args)
     netdev2_t *dev = gnrc_netdev2->dev;
 
     gnrc_netdev2->pid = thread_getpid();
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    memset(&gnrc_netdev2->rx_batch, 0, sizeof(gnrc_netdev2->rx_batch));
+#endif
+#ifdef MODULE_GNRC_NETDEV2_TXQ
+    gnrc_netdev2_txq_init(gnrc_netdev2);
+#endif
 
     gnrc_netapi_opt_t *opt;
     int res;
@@ -134,6 +149,21 @@ static void *_gnrc_netdev2_thread(void *args)
 
     /* start the event loop */
     while (1) {
+#ifdef MODULE_GNRC_NETAPI_BATCH
+        if (msg_avail() == 0) {
+            gnrc_netapi_batch_flush(&gnrc_netdev2->rx_batch);
+        }
+#endif
+#ifdef MODULE_GNRC_NETDEV2_TXQ
+        /* send one packet per message at least, so a steady backlog of
+         * messages can't starve the queue, and more while no message is
+         * pending: a send may block until the device is done, and all
+         * packets arriving meanwhile are queued first, so control packets
+         * can overtake data packets */
+        if (gnrc_netdev2_txq_send(gnrc_netdev2)) {
+            while ((msg_avail() == 0) && gnrc_netdev2_txq_send(gnrc_netdev2)) {}
+        }
+#endif
         DEBUG("gnrc_netdev2: waiting for incoming messages\n");
         msg_receive(&msg);
         /* dispatch NETDEV and NETAPI messages */
@@ -145,7 +175,11 @@ static void *_gnrc_netdev2_thread(void *args)
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
                 gnrc_pktsnip_t *pkt = (gnrc_pktsnip_t *)msg.content.ptr;
+#ifdef MODULE_GNRC_NETDEV2_TXQ
+                gnrc_netdev2_txq_add(gnrc_netdev2, pkt);
+#else
                 gnrc_netdev2->send(gnrc_netdev2, pkt);
+#endif
                 break;
             case GNRC_NETAPI_MSG_TYPE_SET:
                 /* read incoming options */
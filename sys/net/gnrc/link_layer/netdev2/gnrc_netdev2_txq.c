@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_gnrc_netdev2
+ * @file
+ * @brief       Prioritized transmit queue of gnrc_netdev2
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/netdev2.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_NETDEV2_TXQ
+static void _txq_stats(gnrc_netdev2_t *gnrc_netdev2, bool dropped)
+{
+#ifdef MODULE_NETSTATS_L2
+    netstats_t *stats = &gnrc_netdev2->dev->stats;
+
+    /* the statistics may be reset at any time, so don't count on them */
+    stats->tx_queue_len = gnrc_netdev2->txq_numof;
+    if (stats->tx_queue_max < stats->tx_queue_len) {
+        stats->tx_queue_max = stats->tx_queue_len;
+    }
+    if (dropped) {
+        stats->tx_queue_drops++;
+    }
+#else
+    (void)gnrc_netdev2;
+    (void)dropped;
+#endif
+}
+
+static gnrc_netdev2_txq_prio_t _txq_prio(gnrc_pktsnip_t *pkt)
+{
+    /* the upper layers are compressed or fragmented by now, so the network
+     * layer marks control packets in the interface header */
+    if ((pkt->type == GNRC_NETTYPE_NETIF) &&
+        (((gnrc_netif_hdr_t *)pkt->data)->flags & GNRC_NETIF_HDR_FLAGS_CTRL)) {
+        return GNRC_NETDEV2_TXQ_PRIO_CTRL;
+    }
+    return GNRC_NETDEV2_TXQ_PRIO_DATA;
+}
+
+static gnrc_pktqueue_t *_txq_drop(gnrc_netdev2_t *gnrc_netdev2,
+                                  gnrc_netdev2_txq_prio_t prio)
+{
+    gnrc_pktqueue_t *node = NULL;
+    int class;
+
+    /* only drop from the lowest non-empty class not above the new packet */
+    for (class = GNRC_NETDEV2_TXQ_PRIO_NUMOF - 1; class >= (int)prio; class--) {
+        if (gnrc_netdev2->txq[class] != NULL) {
+            break;
+        }
+    }
+    if (class < (int)prio) {
+        return NULL;
+    }
+    if (gnrc_netdev2->txq_policy == GNRC_NETDEV2_TXQ_DROP_HEAD) {
+        node = gnrc_netdev2->txq[class];
+    }
+    else if (class != (int)prio) {
+        for (node = gnrc_netdev2->txq[class]; node->next != NULL; node = node->next) {}
+    }
+    else {
+        /* the new packet is the newest one of its class */
+        return NULL;
+    }
+    DEBUG("gnrc_netdev2: transmit queue full, dropping %p\n", (void *)node->pkt);
+    gnrc_pktqueue_remove(&gnrc_netdev2->txq[class], node);
+    gnrc_pktbuf_release(node->pkt);
+    gnrc_netdev2->txq_numof--;
+    _txq_stats(gnrc_netdev2, true);
+    return node;
+}
+
+void gnrc_netdev2_txq_init(gnrc_netdev2_t *gnrc_netdev2)
+{
+    memset(gnrc_netdev2->txq, 0, sizeof(gnrc_netdev2->txq));
+    memset(gnrc_netdev2->txq_nodes, 0, sizeof(gnrc_netdev2->txq_nodes));
+    gnrc_netdev2->txq_numof = 0;
+}
+
+void gnrc_netdev2_txq_add(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netdev2_txq_prio_t prio = _txq_prio(pkt);
+    gnrc_pktqueue_t *node = NULL;
+
+    for (unsigned i = 0; i < GNRC_NETDEV2_TXQ_SIZE; i++) {
+        if (gnrc_netdev2->txq_nodes[i].pkt == NULL) {
+            node = &gnrc_netdev2->txq_nodes[i];
+            break;
+        }
+    }
+    if ((node == NULL) && ((node = _txq_drop(gnrc_netdev2, prio)) == NULL)) {
+        DEBUG("gnrc_netdev2: transmit queue full, dropping %p\n", (void *)pkt);
+        gnrc_pktbuf_release(pkt);
+        _txq_stats(gnrc_netdev2, true);
+        return;
+    }
+    node->pkt = pkt;
+    gnrc_pktqueue_add(&gnrc_netdev2->txq[prio], node);
+    gnrc_netdev2->txq_numof++;
+    _txq_stats(gnrc_netdev2, false);
+}
+
+bool gnrc_netdev2_txq_send(gnrc_netdev2_t *gnrc_netdev2)
+{
+    for (unsigned class = 0; class < GNRC_NETDEV2_TXQ_PRIO_NUMOF; class++) {
+        gnrc_pktqueue_t *node = gnrc_pktqueue_remove_head(&gnrc_netdev2->txq[class]);
+
+        if (node != NULL) {
+            gnrc_pktsnip_t *pkt = node->pkt;
+
+            node->pkt = NULL;
+            gnrc_netdev2->txq_numof--;
+            _txq_stats(gnrc_netdev2, false);
+            gnrc_netdev2->send(gnrc_netdev2, pkt);
+            return true;
+        }
+    }
+    return false;
+}
+#else
+typedef int dont_be_pedantic;
+#endif
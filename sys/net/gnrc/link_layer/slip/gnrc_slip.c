@@ -29,8 +29,9 @@
 #include "net/gnrc.h"
 #include "periph/uart.h"
 #include "od.h"
-#include "ringbuffer.h"
 #include "thread.h"
+#include "tsrb.h"
+#include "uart_escape.h"
 #include "net/ipv6/hdr.h"
 
 #include "net/gnrc/slip.h"
@@ -49,6 +50,13 @@
 
 #define _SLIP_DEV(arg)    ((gnrc_slip_dev_t *)arg)
 
+static const uart_escape_t _escape = {
+    .delim = (uint8_t)_SLIP_END,
+    .esc = (uint8_t)_SLIP_ESC,
+    .delim_esc = (uint8_t)_SLIP_END_ESC,
+    .esc_esc = (uint8_t)_SLIP_ESC_ESC,
+};
+
 /* UART callbacks */
 static void _slip_rx_cb(void *arg, uint8_t data)
 {
@@ -67,14 +75,14 @@ static void _slip_rx_cb(void *arg, uint8_t data)
 
         switch (data) {
             case ((uint8_t)_SLIP_END_ESC):
-                if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, _SLIP_END) < 0) {
+                if (tsrb_add_one(&_SLIP_DEV(arg)->in_buf, _SLIP_END) == 0) {
                     _SLIP_DEV(arg)->in_bytes++;
                 }
 
                 break;
 
             case ((uint8_t)_SLIP_ESC_ESC):
-                if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, _SLIP_ESC) < 0) {
+                if (tsrb_add_one(&_SLIP_DEV(arg)->in_buf, _SLIP_ESC) == 0) {
                     _SLIP_DEV(arg)->in_bytes++;
                 }
 
@@ -88,7 +96,7 @@ static void _slip_rx_cb(void *arg, uint8_t data)
         _SLIP_DEV(arg)->in_esc = 1;
     }
     else {
-        if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, data) < 0) {
+        if (tsrb_add_one(&_SLIP_DEV(arg)->in_buf, data) == 0) {
             _SLIP_DEV(arg)->in_bytes++;
         }
     }
@@ -115,7 +123,7 @@ static void _slip_receive(gnrc_slip_dev_t *dev, size_t bytes)
         return;
     }
 
-    if (ringbuffer_get(&dev->in_buf, pkt->data, bytes) != bytes) {
+    if ((size_t)tsrb_get(&dev->in_buf, pkt->data, bytes) != bytes) {
         DEBUG("slip: could not read %u bytes from ringbuffer\n", (unsigned)bytes);
         gnrc_pktbuf_release(pkt);
         return;
@@ -153,29 +161,7 @@ static void _slip_send(gnrc_slip_dev_t *dev, gnrc_pktsnip_t *pkt)
 
     while (ptr != NULL) {
         DEBUG("slip: send pktsnip of length %u over UART_%d\n", (unsigned)ptr->size, dev->uart);
-        char *data = ptr->data;
-
-        for (size_t i = 0; i < ptr->size; i++) {
-            switch (data[i]) {
-                case _SLIP_END:
-                    DEBUG("slip: encountered END byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_END_ESC);
-                    break;
-
-                case _SLIP_ESC:
-                    DEBUG("slip: encountered ESC byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_ESC_ESC);
-                    break;
-
-                default:
-                    _slip_send_char(dev, data[i]);
-
-                    break;
-            }
-        }
-
+        uart_escape_write(dev->uart, &_escape, ptr->data, ptr->size);
         ptr = ptr->next;
     }
 
@@ -254,7 +240,7 @@ kernel_pid_t gnrc_slip_init(gnrc_slip_dev_t *dev, uart_t uart, uint32_t baudrate
     dev->slip_pid = KERNEL_PID_UNDEF;
 
     /* initialize buffers */
-    ringbuffer_init(&dev->in_buf, dev->rx_mem, sizeof(dev->rx_mem));
+    tsrb_init(&dev->in_buf, dev->rx_mem, sizeof(dev->rx_mem));
 
     /* initialize UART */
     DEBUG("slip: initialize UART_%d with baudrate %" PRIu32 "\n", uart,
@@ -18,6 +18,9 @@
  * @}
  */
 
+#include <assert.h>
+#include <string.h>
+
 #include "msg.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
@@ -76,11 +79,11 @@ static inline int _snd_rcv(kernel_pid_t pid, uint16_t type, gnrc_pktsnip_t *pkt)
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
-    int numof = gnrc_netreg_num(type, demux_ctx);
-
-    if (numof != 0) {
-        gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+    int numof = 0;
 
+    if (sendto != NULL) {
+        numof = gnrc_netreg_entry_num(sendto);
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
@@ -95,6 +98,100 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
     return numof;
 }
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+static void _release_batch(gnrc_pktsnip_t *batch)
+{
+    gnrc_pktsnip_t **pkts = batch->data;
+
+    for (unsigned i = 0; (i < GNRC_NETAPI_BATCH_SIZE) && (pkts[i] != NULL); i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    gnrc_pktbuf_release(batch);
+}
+
+int gnrc_netapi_batch_add(gnrc_netapi_batch_t *batch, gnrc_nettype_t type,
+                          uint32_t demux_ctx, uint16_t cmd, gnrc_pktsnip_t *pkt)
+{
+    int numof = gnrc_netreg_num(type, demux_ctx);
+
+    if (numof == 0) {
+        return 0;
+    }
+    if ((batch->batch != NULL) && ((batch->type != type) ||
+                                   (batch->demux_ctx != demux_ctx) ||
+                                   (batch->cmd != cmd))) {
+        gnrc_netapi_batch_flush(batch);
+    }
+    if (batch->batch == NULL) {
+        batch->batch = gnrc_pktbuf_add(NULL, NULL,
+                                       GNRC_NETAPI_BATCH_SIZE * sizeof(gnrc_pktsnip_t *),
+                                       GNRC_NETTYPE_BATCH);
+        if (batch->batch == NULL) {
+            DEBUG("gnrc_netapi: unable to allocate batch, dispatch packet alone\n");
+            return gnrc_netapi_dispatch(type, demux_ctx, cmd, pkt);
+        }
+        memset(batch->batch->data, 0, batch->batch->size);
+        batch->type = type;
+        batch->demux_ctx = demux_ctx;
+        batch->cmd = cmd;
+        batch->numof = 0;
+    }
+    ((gnrc_pktsnip_t **)batch->batch->data)[batch->numof++] = pkt;
+    if (batch->numof == GNRC_NETAPI_BATCH_SIZE) {
+        gnrc_netapi_batch_flush(batch);
+    }
+
+    return numof;
+}
+
+int gnrc_netapi_batch_flush(gnrc_netapi_batch_t *batch)
+{
+    gnrc_pktsnip_t *pkt = batch->batch;
+    gnrc_pktsnip_t **pkts;
+    gnrc_netreg_entry_t *sendto;
+    uint16_t cmd = (batch->cmd == GNRC_NETAPI_MSG_TYPE_RCV) ?
+                   GNRC_NETAPI_MSG_TYPE_RCV_BATCH : GNRC_NETAPI_MSG_TYPE_SND_BATCH;
+    int numof;
+
+    if (pkt == NULL) {
+        return 0;
+    }
+    batch->batch = NULL;
+    sendto = gnrc_netreg_lookup(batch->type, batch->demux_ctx);
+    if (sendto == NULL) {
+        DEBUG("gnrc_netapi: subscribers of batch vanished\n");
+        _release_batch(pkt);
+        return 0;
+    }
+    numof = gnrc_netreg_entry_num(sendto);
+    pkts = pkt->data;
+    for (unsigned i = 0; i < batch->numof; i++) {
+        gnrc_pktbuf_hold(pkts[i], numof - 1);
+    }
+    gnrc_pktbuf_hold(pkt, numof - 1);
+    while (sendto) {
+        if (_snd_rcv(sendto->pid, cmd, pkt) < 1) {
+            /* unable to dispatch batch */
+            _release_batch(pkt);
+        }
+        sendto = gnrc_netreg_getnext(sendto);
+    }
+
+    return numof;
+}
+
+void gnrc_netapi_batch_drain(gnrc_pktsnip_t *batch, void (*cb)(gnrc_pktsnip_t *))
+{
+    gnrc_pktsnip_t **pkts = batch->data;
+
+    assert(batch->type == GNRC_NETTYPE_BATCH);
+    for (unsigned i = 0; (i < GNRC_NETAPI_BATCH_SIZE) && (pkts[i] != NULL); i++) {
+        cb(pkts[i]);
+    }
+    gnrc_pktbuf_release(batch);
+}
+#endif
+
 int gnrc_netapi_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt)
 {
     return _snd_rcv(pid, GNRC_NETAPI_MSG_TYPE_SND, pkt);
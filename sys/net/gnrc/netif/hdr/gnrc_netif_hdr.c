@@ -15,12 +15,9 @@
 
 #include "net/gnrc/netif/hdr.h"
 
-gnrc_pktsnip_t *gnrc_netif_hdr_build(uint8_t *src, uint8_t src_len, uint8_t *dst, uint8_t dst_len)
+static gnrc_pktsnip_t *_init(gnrc_pktsnip_t *pkt, uint8_t *src, uint8_t src_len,
+                             uint8_t *dst, uint8_t dst_len)
 {
-    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
-                                          sizeof(gnrc_netif_hdr_t) + src_len + dst_len,
-                                          GNRC_NETTYPE_NETIF);
-
     if (pkt == NULL) {
         return NULL;
     }
@@ -38,4 +35,24 @@ gnrc_pktsnip_t *gnrc_netif_hdr_build(uint8_t *src, uint8_t src_len, uint8_t *dst
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_netif_hdr_build(uint8_t *src, uint8_t src_len, uint8_t *dst, uint8_t dst_len)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL,
+                                          sizeof(gnrc_netif_hdr_t) + src_len + dst_len,
+                                          GNRC_NETTYPE_NETIF);
+
+    return _init(pkt, src, src_len, dst, dst_len);
+}
+
+gnrc_pktsnip_t *gnrc_netif_hdr_push(gnrc_pktsnip_t *pkt, uint8_t *src,
+                                    uint8_t src_len, uint8_t *dst,
+                                    uint8_t dst_len)
+{
+    gnrc_pktsnip_t *hdr = gnrc_pktbuf_push(pkt, NULL,
+                                           sizeof(gnrc_netif_hdr_t) + src_len + dst_len,
+                                           GNRC_NETTYPE_NETIF);
+
+    return _init(hdr, src, src_len, dst, dst_len);
+}
+
 /** @} */
@@ -16,8 +16,6 @@
 #include <string.h>
 
 #include "assert.h"
-#include "clist.h"
-#include "utlist.h"
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
@@ -27,17 +25,32 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#if (GNRC_NETREG_BUCKETS & (GNRC_NETREG_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_BUCKETS must be a power of two"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and hashed demux context.
+ * Entries with the same demux context are kept next to each other in their
+ * bucket, the first of them holds their number. */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    demux_ctx ^= (demux_ctx >> 16);
+    demux_ctx ^= (demux_ctx >> 8);
+    return &netreg[type][demux_ctx & (GNRC_NETREG_BUCKETS - 1)];
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
+    gnrc_netreg_entry_t **prev;
+
     /* only threads with a message queue are allowed to register at gnrc */
     assert(sched_threads[entry->pid]->msg_array);
 
@@ -45,18 +58,43 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    /* insert in front of the entries with the same demux context */
+    prev = _bucket(type, entry->demux_ctx);
+    while ((*prev != NULL) && ((*prev)->demux_ctx != entry->demux_ctx)) {
+        prev = &(*prev)->next;
+    }
+    entry->num = (*prev != NULL) ? ((*prev)->num + 1) : 1;
+    entry->next = *prev;
+    *prev = entry;
 
     return 0;
 }
 
 void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
+    gnrc_netreg_entry_t **prev, *first = NULL;
+
     if (_INVALID_TYPE(type)) {
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    prev = _bucket(type, entry->demux_ctx);
+    while ((*prev != NULL) && (*prev != entry)) {
+        if ((first == NULL) && ((*prev)->demux_ctx == entry->demux_ctx)) {
+            first = *prev;
+        }
+        prev = &(*prev)->next;
+    }
+    if (*prev == NULL) {
+        return;
+    }
+    if (first != NULL) {
+        first->num--;
+    }
+    else if ((entry->next != NULL) && (entry->next->demux_ctx == entry->demux_ctx)) {
+        entry->next->num = entry->num - 1;
+    }
+    *prev = entry->next;
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -67,46 +105,29 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    res = *_bucket(type, demux_ctx);
+    while ((res != NULL) && (res->demux_ctx != demux_ctx)) {
+        res = res->next;
+    }
 
     return res;
 }
 
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 {
-    int num = 0;
-    gnrc_netreg_entry_t *entry;
+    gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(type, demux_ctx);
 
-    if (_INVALID_TYPE(type)) {
-        return 0;
-    }
-
-    entry = netreg[type];
-
-    while (entry != NULL) {
-        if (entry->demux_ctx == demux_ctx) {
-            num++;
-        }
-
-        entry = entry->next;
-    }
-
-    return num;
+    return (entry != NULL) ? entry->num : 0;
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
-    uint32_t demux_ctx;
-
-    if (entry == NULL) {
+    if ((entry == NULL) || (entry->next == NULL) ||
+        (entry->next->demux_ctx != entry->demux_ctx)) {
         return NULL;
     }
 
-    demux_ctx = entry->demux_ctx;
-
-    LL_SEARCH_SCALAR(entry->next, entry, demux_ctx, demux_ctx);
-
-    return entry;
+    return entry->next;
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
@@ -154,7 +154,7 @@ gnrc_pktsnip_t *gnrc_icmpv6_build(gnrc_pktsnip_t *next, uint8_t type, uint8_t co
     gnrc_pktsnip_t *pkt;
     icmpv6_hdr_t *icmpv6;
 
-    pkt = gnrc_pktbuf_add(next, NULL, size, GNRC_NETTYPE_ICMPV6);
+    pkt = gnrc_pktbuf_push(next, NULL, size, GNRC_NETTYPE_ICMPV6);
 
     if (pkt == NULL) {
         DEBUG("icmpv6_echo: no space left in packet buffer\n");
@@ -43,13 +43,14 @@ static enum gnrc_ipv6_ext_demux_status _handle_rh(gnrc_pktsnip_t *current, gnrc_
         return GNRC_IPV6_EXT_OK;
     }
 
-    /* We cannot use `gnrc_pktbuf_start_write` since it duplicates only
-       the head. `ipv6_ext_rh_process` modifies the IPv6 header as well as
-       the extension header */
-
     current_offset = gnrc_pkt_len_upto(current->next, GNRC_NETTYPE_IPV6);
+    ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
 
-    if (pkt->users != 1) {
+    /* both headers are written in place only if neither the snips nor their
+     * data are shared, gnrc_pktbuf_start_write() copies shared data */
+    if ((pkt->users != 1) || (current->users != 1) || (ipv6->users != 1) ||
+        (gnrc_pktbuf_start_write(current) == NULL) ||
+        (gnrc_pktbuf_start_write(ipv6) == NULL)) {
         if ((ipv6 = gnrc_pktbuf_duplicate_upto(pkt, GNRC_NETTYPE_IPV6)) == NULL) {
             DEBUG("ipv6: could not get a copy of pkt\n");
             gnrc_pktbuf_release(pkt);
@@ -60,8 +61,8 @@ static enum gnrc_ipv6_ext_demux_status _handle_rh(gnrc_pktsnip_t *current, gnrc_
         ext = (ipv6_ext_t *)(((uint8_t *)ipv6->data) + current_offset);
     }
     else {
-        ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
         hdr = ipv6->data;
+        ext = current->data;
     }
 
     switch (ipv6_ext_rh_process(hdr, (ipv6_ext_rh_t *)ext)) {
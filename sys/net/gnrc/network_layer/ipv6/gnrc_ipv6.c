@@ -67,6 +67,11 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+/* received packets for the upper layers, flushed when the queue runs empty */
+static gnrc_netapi_batch_t _rcv_batch;
+#endif
+
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
 /* dispatches received IPv6 packet for upper layer */
@@ -76,6 +81,10 @@ static void _dispatch_rcv_pkt(gnrc_nettype_t type, uint32_t demux_ctx,
  * prep_hdr: prepare header for sending (call to _fill_ipv6_hdr()), otherwise
  * assume it is already prepared */
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr);
+#ifdef MODULE_GNRC_NETAPI_BATCH
+/* handles single packet of GNRC_NETAPI_MSG_TYPE_SND_BATCH commands */
+static void _send_batched(gnrc_pktsnip_t *pkt);
+#endif
 /* Main event loop for IPv6 */
 static void *_event_loop(void *args);
 
@@ -142,6 +151,21 @@ void gnrc_ipv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *current, gnrc_pktsnip_t
             break;
     }
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    if (!interested && (gnrc_netreg_num(GNRC_NETTYPE_IPV6, nh) == 0)) {
+        /* IPv6 is done with the packet and only subscribers to its type
+         * want it => hand it over with the next batch */
+        assert(current == pkt);
+        DEBUG("ipv6: add nh = %u to batch for other threads\n", nh);
+        if (gnrc_netapi_batch_add(&_rcv_batch, pkt->type, GNRC_NETREG_DEMUX_CTX_ALL,
+                                  GNRC_NETAPI_MSG_TYPE_RCV, pkt) == 0) {
+            DEBUG("ipv6: unable to forward packet as no one is interested in it\n");
+            gnrc_pktbuf_release(pkt);
+        }
+        return;
+    }
+#endif
+
     DEBUG("ipv6: forward nh = %u to other threads\n", nh);
     receiver_num = gnrc_netreg_num(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL) +
                    gnrc_netreg_num(GNRC_NETTYPE_IPV6, nh);
@@ -228,6 +252,11 @@ static void *_event_loop(void *args)
 
     /* start event loop */
     while (1) {
+#ifdef MODULE_GNRC_NETAPI_BATCH
+        if (msg_avail() == 0) {
+            gnrc_netapi_batch_flush(&_rcv_batch);
+        }
+#endif
         DEBUG("ipv6: waiting for incoming message.\n");
         msg_receive(&msg);
 
@@ -242,6 +271,18 @@ static void *_event_loop(void *args)
                 _send((gnrc_pktsnip_t *)msg.content.ptr, true);
                 break;
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _receive);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _send_batched);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("ipv6: reply to unsupported get/set\n");
@@ -338,6 +379,14 @@ static void _send_to_iface(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
     ((gnrc_netif_hdr_t *)pkt->data)->if_pid = iface;
     gnrc_ipv6_netif_t *if_entry = gnrc_ipv6_netif_get(iface);
 
+#ifdef MODULE_GNRC_ICMPV6
+    /* NDP and RPL messages are ICMPv6 messages, mark them before 6LoWPAN
+     * compresses or fragments them */
+    if (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_ICMPV6) != NULL) {
+        ((gnrc_netif_hdr_t *)pkt->data)->flags |= GNRC_NETIF_HDR_FLAGS_CTRL;
+    }
+#endif
+
     assert(if_entry != NULL);
     if (gnrc_pkt_len(pkt->next) > if_entry->mtu) {
         DEBUG("ipv6: packet too big\n");
@@ -377,7 +426,8 @@ static void _send_unicast(kernel_pid_t iface, uint8_t *dst_l2addr,
     }
 
     DEBUG("ipv6: add interface header to packet\n");
-    netif = gnrc_netif_hdr_build(NULL, 0, dst_l2addr, dst_l2addr_len);
+    /* add netif to front of the pkt list */
+    netif = gnrc_netif_hdr_push(pkt, NULL, 0, dst_l2addr, dst_l2addr_len);
 
     if (netif == NULL) {
         DEBUG("ipv6: error on interface header allocation, dropping packet\n");
@@ -385,8 +435,7 @@ static void _send_unicast(kernel_pid_t iface, uint8_t *dst_l2addr,
         return;
     }
 
-    /* add netif to front of the pkt list */
-    LL_PREPEND(pkt, netif);
+    pkt = netif;
 
     DEBUG("ipv6: send unicast over interface %" PRIkernel_pid "\n", iface);
     /* and send to interface */
@@ -526,7 +575,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
             }
 
             /* allocate interface header */
-            netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+            netif = gnrc_netif_hdr_push(ipv6, NULL, 0, NULL, 0);
 
             if (netif == NULL) {
                 DEBUG("ipv6: error on interface header allocation, "
@@ -535,7 +584,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                 return;
             }
 
-            LL_PREPEND(ipv6, netif);
+            ipv6 = netif;
 
             _send_multicast_over_iface(ifs[i], ipv6);
         }
@@ -560,7 +609,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
         iface = ifs[0];
 
         /* allocate interface header */
-        netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+        netif = gnrc_netif_hdr_push(pkt, NULL, 0, NULL, 0);
 
         if (netif == NULL) {
             DEBUG("ipv6: error on interface header allocation, "
@@ -569,7 +618,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
             return;
         }
 
-        LL_PREPEND(pkt, netif);
+        pkt = netif;
     }
 
     if (prep_hdr) {
@@ -763,6 +812,13 @@ static void _dispatch_rcv_pkt(gnrc_nettype_t type, uint32_t demux_ctx,
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+static void _send_batched(gnrc_pktsnip_t *pkt)
+{
+    _send(pkt, true);
+}
+#endif
+
 static void _receive(gnrc_pktsnip_t *pkt)
 {
     kernel_pid_t iface = KERNEL_PID_UNDEF;
@@ -12,6 +12,7 @@
  * @file
  */
 
+#include <assert.h>
 #include <errno.h>
 #include <string.h>
 
@@ -35,7 +36,109 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+#if GNRC_IPV6_NC_SIZE >= UINT16_MAX
+#error "gnrc_ipv6_nc: GNRC_IPV6_NC_SIZE too large"
+#endif
+
+/* keep load factor of the index below 1/2 for short probe sequences */
+#define _INDEX_SIZE     ((2 * GNRC_IPV6_NC_SIZE) + 1)
+
+/* All links below store the position in ncache + 1, so 0 marks an empty slot
+ * or the end of a list and the zero-initialized state is a valid empty
+ * cache. */
 static gnrc_ipv6_nc_t ncache[GNRC_IPV6_NC_SIZE];
+/* open addressing index over ncache with linear probing */
+static uint16_t _index[_INDEX_SIZE];
+/* entries in use ordered from most (_mru) to least (_lru) recently used */
+static uint16_t _next[GNRC_IPV6_NC_SIZE], _prev[GNRC_IPV6_NC_SIZE];
+static uint16_t _mru, _lru;
+/* removed entries, linked by _next */
+static uint16_t _free;
+/* number of entries used at least once since initialization */
+static uint16_t _fresh;
+
+static inline uint16_t _link(const gnrc_ipv6_nc_t *entry)
+{
+    return (uint16_t)(entry - ncache) + 1;
+}
+
+static inline unsigned _hash(const ipv6_addr_t *ipv6_addr)
+{
+    uint32_t hash = ipv6_addr->u32[0].u32 ^ ipv6_addr->u32[1].u32 ^
+                    ipv6_addr->u32[2].u32 ^ ipv6_addr->u32[3].u32;
+
+    /* multiplicative hashing to spread similar addresses */
+    hash *= 2654435761U;
+    return (unsigned)((hash ^ (hash >> 16)) % _INDEX_SIZE);
+}
+
+/* returns the index slot of ipv6_addr or the empty slot it belongs into */
+static unsigned _index_slot(const ipv6_addr_t *ipv6_addr)
+{
+    unsigned slot = _hash(ipv6_addr);
+
+    while ((_index[slot] != 0) &&
+           !ipv6_addr_equal(&ncache[_index[slot] - 1].ipv6_addr, ipv6_addr)) {
+        slot = (slot + 1) % _INDEX_SIZE;
+    }
+    return slot;
+}
+
+static void _index_remove(const gnrc_ipv6_nc_t *entry)
+{
+    unsigned hole = _index_slot(&entry->ipv6_addr), slot = hole;
+
+    assert(_index[hole] == _link(entry));
+    /* shift back following entries of the cluster that would not be found
+     * anymore from their home slot otherwise */
+    while (1) {
+        unsigned home;
+
+        slot = (slot + 1) % _INDEX_SIZE;
+        if (_index[slot] == 0) {
+            break;
+        }
+        home = _hash(&ncache[_index[slot] - 1].ipv6_addr);
+        if ((hole <= slot) ? ((hole < home) && (home <= slot))
+                           : ((hole < home) || (home <= slot))) {
+            continue;
+        }
+        _index[hole] = _index[slot];
+        hole = slot;
+    }
+    _index[hole] = 0;
+}
+
+static void _lru_unlink(uint16_t link)
+{
+    uint16_t next = _next[link - 1], prev = _prev[link - 1];
+
+    if (prev != 0) {
+        _next[prev - 1] = next;
+    }
+    else {
+        _mru = next;
+    }
+    if (next != 0) {
+        _prev[next - 1] = prev;
+    }
+    else {
+        _lru = prev;
+    }
+}
+
+static void _lru_push(uint16_t link)
+{
+    _prev[link - 1] = 0;
+    _next[link - 1] = _mru;
+    if (_mru != 0) {
+        _prev[_mru - 1] = link;
+    }
+    else {
+        _lru = link;
+    }
+    _mru = link;
+}
 
 static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 {
@@ -73,6 +176,15 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
     xtimer_remove(&entry->nbr_sol_timer);
     xtimer_remove(&entry->nbr_adv_timer);
 
+    if (!ipv6_addr_is_unspecified(&(entry->ipv6_addr))) {
+        uint16_t link = _link(entry);
+
+        _index_remove(entry);
+        _lru_unlink(link);
+        _next[link - 1] = _free;
+        _free = link;
+    }
+
     ipv6_addr_set_unspecified(&(entry->ipv6_addr));
     entry->iface = KERNEL_PID_UNDEF;
     entry->flags = 0;
@@ -86,13 +198,42 @@ void gnrc_ipv6_nc_init(void)
         _nc_remove(entry->iface, entry);
     }
     memset(ncache, 0, sizeof(ncache));
+    memset(_index, 0, sizeof(_index));
+    _mru = _lru = _free = _fresh = 0;
+}
+
+/* registered and tentative entries (RFC 6775) and routers are only removed
+ * explicitly */
+static inline bool _evictable(const gnrc_ipv6_nc_t *entry)
+{
+    uint8_t type = gnrc_ipv6_nc_get_type(entry);
+
+    return (gnrc_ipv6_nc_get_state(entry) == GNRC_IPV6_NC_STATE_STALE) &&
+           (type != GNRC_IPV6_NC_TYPE_REGISTERED) &&
+           (type != GNRC_IPV6_NC_TYPE_TENTATIVE) &&
+           !(entry->flags & GNRC_IPV6_NC_IS_ROUTER);
 }
 
 gnrc_ipv6_nc_t *_find_free_entry(void)
 {
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr))) {
-            return ncache + i;
+    gnrc_ipv6_nc_t *entry;
+
+    if (_free != 0) {
+        entry = &ncache[_free - 1];
+        _free = _next[_free - 1];
+        return entry;
+    }
+    if (_fresh < GNRC_IPV6_NC_SIZE) {
+        return &ncache[_fresh++];
+    }
+    /* evict least recently used stale entry */
+    for (uint16_t link = _lru; link != 0; link = _prev[link - 1]) {
+        entry = &ncache[link - 1];
+        if (_evictable(entry)) {
+            DEBUG("ipv6_nc: evict stale entry %s\n",
+                  ipv6_addr_to_str(addr_str, &(entry->ipv6_addr), sizeof(addr_str)));
+            _nc_remove(entry->iface, entry);
+            return _find_free_entry();
         }
     }
 
@@ -102,7 +243,8 @@ gnrc_ipv6_nc_t *_find_free_entry(void)
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr,
                                  const void *l2_addr, size_t l2_addr_len, uint8_t flags)
 {
-    gnrc_ipv6_nc_t *free_entry = NULL;
+    gnrc_ipv6_nc_t *free_entry;
+    unsigned slot;
 
     if (ipv6_addr == NULL) {
         DEBUG("ipv6_nc: address was NULL\n");
@@ -114,31 +256,29 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Address %s already registered.\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
+    slot = _index_slot(ipv6_addr);
+    if (_index[slot] != 0) {
+        gnrc_ipv6_nc_t *entry = &ncache[_index[slot] - 1];
 
-            if ((l2_addr != NULL) && (l2_addr_len > 0)) {
-                DEBUG("ipv6_nc: Update to L2 address %s",
-                      gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
-                                             l2_addr, l2_addr_len));
+        DEBUG("ipv6_nc: Address %s already registered.\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
 
-                memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
-                ncache[i].l2_addr_len = l2_addr_len;
-                ncache[i].flags = flags;
-                DEBUG(" with flags = 0x%0x\n", flags);
+        if ((l2_addr != NULL) && (l2_addr_len > 0)) {
+            DEBUG("ipv6_nc: Update to L2 address %s",
+                  gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                         l2_addr, l2_addr_len));
 
-            }
-            return &ncache[i];
-        }
+            memcpy(&(entry->l2_addr), l2_addr, l2_addr_len);
+            entry->l2_addr_len = l2_addr_len;
+            entry->flags = flags;
+            DEBUG(" with flags = 0x%0x\n", flags);
 
-        if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr)) && !free_entry) {
-            /* found the first free entry */
-            free_entry = &ncache[i];
         }
+        return entry;
     }
 
+    free_entry = _find_free_entry();
+
     if (!free_entry) {
         /* reached end of NC without finding updateable or free entry */
         DEBUG("ipv6_nc: neighbor cache full.\n");
@@ -152,6 +292,9 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
     free_entry->pkts = NULL;
 #endif
     memcpy(&(free_entry->ipv6_addr), ipv6_addr, sizeof(ipv6_addr_t));
+    /* eviction may have moved index entries */
+    _index[_index_slot(ipv6_addr)] = _link(free_entry);
+    _lru_push(_link(free_entry));
     DEBUG("ipv6_nc: Register %s for interface %" PRIkernel_pid,
           ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
           iface);
@@ -204,17 +347,22 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (((ncache[i].iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
-             (iface == ncache[i].iface)) &&
-            ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
-                  " (0 = all interfaces) [%p]\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
-                  iface, (void *)(ncache + i));
+    uint16_t link = _index[_index_slot(ipv6_addr)];
+    gnrc_ipv6_nc_t *entry = (link != 0) ? &ncache[link - 1] : NULL;
+
+    if ((entry != NULL) &&
+        ((entry->iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
+         (iface == entry->iface))) {
+        DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
+              " (0 = all interfaces) [%p]\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
+              iface, (void *)entry);
 
-            return ncache + i;
+        if (_mru != link) {
+            _lru_unlink(link);
+            _lru_push(link);
         }
+        return entry;
     }
 
     return NULL;
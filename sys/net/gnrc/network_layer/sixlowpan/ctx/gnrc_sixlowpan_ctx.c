@@ -14,46 +14,57 @@
 
 #include <stdbool.h>
 #include <inttypes.h>
+#include <string.h>
 
+#include "irq.h"
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#include "timex.h"
 #include "xtimer.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#define MIN_IN_USEC     (60U * SEC_IN_USEC)
+
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
-static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
+/* masks for the prefixes of _ctxs */
+static ipv6_addr_t _ctx_masks[GNRC_SIXLOWPAN_CTX_SIZE];
+/* IDs of valid contexts, longest prefix first */
+static uint8_t _ctx_index[GNRC_SIXLOWPAN_CTX_SIZE];
+static uint8_t _ctx_index_numof;
 static mutex_t _ctx_mutex = MUTEX_INIT;
+static uint16_t _ctx_gen;
+static xtimer_t _ltime_timer;
+static bool _ltime_timer_set;
 
-static uint32_t _current_minute(void);
-static void _update_lifetime(uint8_t id);
+static void _index_remove(uint8_t id);
+static void _index_add(uint8_t id);
+static void _ltime_tick(void *arg);
 
 #if ENABLE_DEBUG
 static char ipv6str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
-static inline bool _valid(uint8_t id)
+static inline bool _matches(uint8_t id, const ipv6_addr_t *addr)
 {
-    _update_lifetime(id);
-    return (_ctxs[id].prefix_len > 0);
+    return ((addr->u64[0].u64 & _ctx_masks[id].u64[0].u64) == _ctxs[id].prefix.u64[0].u64) &&
+           ((addr->u64[1].u64 & _ctx_masks[id].u64[1].u64) == _ctxs[id].prefix.u64[1].u64);
 }
 
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
 {
-    uint8_t best = 0;
     gnrc_sixlowpan_ctx_t *res = NULL;
 
     mutex_lock(&_ctx_mutex);
 
-    for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
-        if (_valid(id)) {
-            uint8_t match = ipv6_addr_match_prefix(&_ctxs[id].prefix, addr);
+    for (unsigned int i = 0; i < _ctx_index_numof; i++) {
+        uint8_t id = _ctx_index[i];
 
-            if ((_ctxs[id].prefix_len <= match) && (match > best)) {
-                best = match;
-                res = &(_ctxs[id]);
-            }
+        /* gnrc_sixlowpan_ctx_remove() does not update the index */
+        if ((_ctxs[id].prefix_len > 0) && _matches(id, addr)) {
+            res = &(_ctxs[id]);
+            break;
         }
     }
 
@@ -74,95 +85,133 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
 
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_id(uint8_t id)
 {
-    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+    if ((id >= GNRC_SIXLOWPAN_CTX_SIZE) || (_ctxs[id].prefix_len == 0)) {
         return NULL;
     }
 
-    mutex_lock(&_ctx_mutex);
-
-    if (_valid(id)) {
-        DEBUG("6lo ctx: found context (%u, %s/%" PRIu8 ")\n", id,
-              ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
-              _ctxs[id].prefix_len);
-        mutex_unlock(&_ctx_mutex);
-        return &(_ctxs[id]);
-    }
-
-    mutex_unlock(&_ctx_mutex);
-
-    return NULL;
+    DEBUG("6lo ctx: found context (%u, %s/%" PRIu8 ")\n", id,
+          ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
+          _ctxs[id].prefix_len);
+    return &(_ctxs[id]);
 }
 
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *prefix,
                                                 uint8_t prefix_len, uint16_t ltime,
                                                 bool comp)
 {
+    unsigned state;
+
     if ((id >= GNRC_SIXLOWPAN_CTX_SIZE) || (prefix_len == 0)) {
         return NULL;
     }
 
-    mutex_lock(&_ctx_mutex);
-
-    _ctxs[id].ltime = ltime;
-
     if (ltime == 0) {
         comp = false;
     }
 
     if (prefix_len > IPV6_ADDR_BIT_LEN) {
-        _ctxs[id].prefix_len = IPV6_ADDR_BIT_LEN;
+        prefix_len = IPV6_ADDR_BIT_LEN;
     }
-    else {
-        _ctxs[id].prefix_len = prefix_len;
+
+    mutex_lock(&_ctx_mutex);
+
+    _index_remove(id);
+    memset(&_ctx_masks[id], 0, sizeof(ipv6_addr_t));
+    memset(_ctx_masks[id].u8, 0xff, prefix_len / 8);
+    if (prefix_len % 8) {
+        _ctx_masks[id].u8[prefix_len / 8] = (uint8_t)(0xff << (8 - (prefix_len % 8)));
     }
+    _ctxs[id].prefix.u64[0].u64 = prefix->u64[0].u64 & _ctx_masks[id].u64[0].u64;
+    _ctxs[id].prefix.u64[1].u64 = prefix->u64[1].u64 & _ctx_masks[id].u64[1].u64;
 
+    /* lifetime is also changed by _ltime_tick() in interrupt context */
+    state = irq_disable();
+    _ctxs[id].prefix_len = prefix_len;
+    _ctxs[id].ltime = ltime;
     _ctxs[id].flags_id = (comp) ? (GNRC_SIXLOWPAN_CTX_FLAGS_COMP | id) : id;
-
-    if (!ipv6_addr_equal(&(_ctxs[id].prefix), prefix)) {
-        ipv6_addr_set_unspecified(&(_ctxs[id].prefix));
-        ipv6_addr_init_prefix(&(_ctxs[id].prefix), prefix, _ctxs[id].prefix_len);
+    _ctx_gen++;
+    if ((ltime > 0) && !_ltime_timer_set) {
+        _ltime_timer.callback = _ltime_tick;
+        _ltime_timer_set = true;
+        xtimer_set(&_ltime_timer, MIN_IN_USEC);
     }
+    irq_restore(state);
+
+    _index_add(id);
     DEBUG("6lo ctx: update context (%u, %s/%" PRIu8 "), lifetime: %" PRIu16 " min\n",
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
-    _ctx_inval_times[id] = ltime + _current_minute();
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
-static uint32_t _current_minute(void)
+uint16_t gnrc_sixlowpan_ctx_generation(void)
 {
-    return xtimer_now() / (SEC_IN_USEC * 60);
+    return _ctx_gen;
 }
 
-static void _update_lifetime(uint8_t id)
+static void _index_remove(uint8_t id)
 {
-    uint32_t now;
+    for (unsigned i = 0; i < _ctx_index_numof; i++) {
+        if (_ctx_index[i] == id) {
+            _ctx_index_numof--;
+            memmove(&_ctx_index[i], &_ctx_index[i + 1], _ctx_index_numof - i);
+            return;
+        }
+    }
+}
 
-    if (_ctxs[id].ltime == 0) {
-        _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
-        return;
+static void _index_add(uint8_t id)
+{
+    unsigned i = _ctx_index_numof;
+
+    /* keep longest prefixes first, lower IDs first for equal lengths */
+    while ((i > 0) &&
+           ((_ctxs[_ctx_index[i - 1]].prefix_len < _ctxs[id].prefix_len) ||
+            ((_ctxs[_ctx_index[i - 1]].prefix_len == _ctxs[id].prefix_len) &&
+             (_ctx_index[i - 1] > id)))) {
+        _ctx_index[i] = _ctx_index[i - 1];
+        i--;
     }
+    _ctx_index[i] = id;
+    _ctx_index_numof++;
+}
 
-    now = _current_minute();
+static void _ltime_tick(void *arg)
+{
+    bool pending = false;
 
-    if (now >= _ctx_inval_times[id]) {
-        DEBUG("6lo ctx: context %u was invalidated for compression\n", id);
-        _ctxs[id].ltime = 0;
-        _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
+    (void)arg;
+    /* lifetimes are only counted down here, so lookups do not need to */
+    for (unsigned id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+        if ((_ctxs[id].prefix_len == 0) || (_ctxs[id].ltime == 0)) {
+            continue;
+        }
+        if (--_ctxs[id].ltime == 0) {
+            DEBUG("6lo ctx: context %u was invalidated for compression\n", id);
+            _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
+            _ctx_gen++;
+        }
+        else {
+            pending = true;
+        }
     }
-    else {
-        _ctxs[id].ltime = (uint16_t)(_ctx_inval_times[id] - now);
+    _ltime_timer_set = pending;
+    if (pending) {
+        xtimer_set(&_ltime_timer, MIN_IN_USEC);
     }
 }
 
 #ifdef TEST_SUITES
-#include <string.h>
 
 void gnrc_sixlowpan_ctx_reset(void)
 {
+    xtimer_remove(&_ltime_timer);
+    _ltime_timer_set = false;
     memset(_ctxs, 0, sizeof(_ctxs));
+    _ctx_index_numof = 0;
+    _ctx_gen++;
 }
 #endif
 
@@ -14,7 +14,9 @@
 
 #include <inttypes.h>
 #include <stdbool.h>
+#include <string.h>
 
+#include "assert.h"
 #include "rbuf.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
@@ -29,22 +31,22 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
+#if RBUF_SIZE >= UINT16_MAX
+#error "RBUF_SIZE must be smaller than UINT16_MAX"
 #endif
 
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(GNRC_IPV6_NETIF_DEFAULT_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
-#endif
+static rbuf_t rbuf[RBUF_SIZE];
 
-static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+/* links are entry index + 1, so that 0 is none and the zero initialized
+ * state is valid */
+static uint16_t _index[RBUF_INDEX_SIZE];    /* first entry of hash buckets */
+static uint16_t _free;                      /* first free entry */
+static uint16_t _fresh;                     /* number of entries ever used */
+static uint16_t _oldest;                    /* least recently updated entry */
+static uint16_t _newest;                    /* most recently updated entry */
+static size_t _mem_used;                    /* sum of all datagram sizes */
 
-static rbuf_t rbuf[RBUF_SIZE];
+static gnrc_sixlowpan_frag_stats_t _stats;
 
 #if ENABLE_DEBUG
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
@@ -53,17 +55,17 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
-/* checks timeouts and removes entries if necessary (oldest if full) */
+/* release the packet of an entry and remove it from reassembly buffer */
+static void _rbuf_drop(rbuf_t *entry);
+/* update received units of entry; 1 if the fragment is new, 0 if it is a
+ * duplicate, -1 if it overlaps other fragments partially */
+static int _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
+/* checks timeouts and removes entries if necessary */
 static void _rbuf_gc(void);
-/* gets an entry identified by its tupel */
+/* gets an entry identified by its tupel, creates it (removing the oldest
+ * entries if full) if it does not exist */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag);
@@ -77,8 +79,8 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     unsigned int data_offset = 0;
     size_t original_size = frag_size;
     sixlowpan_frag_t *frag = pkt->data;
-    rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
+    int res;
 
     _rbuf_gc();
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
@@ -91,8 +93,6 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return;
     }
 
-    ptr = entry->ints;
-
     /* dispatches in the first fragment are ignored */
     if (offset == 0) {
         if (data[0] == SIXLOWPAN_UNCOMP) {
@@ -106,8 +106,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                                                   sizeof(sixlowpan_frag_t), &nh_len);
             if (iphc_len == 0) {
                 DEBUG("6lo rfrag: could not decode IPHC dispatch\n");
-                gnrc_pktbuf_release(entry->pkt);
-                _rbuf_rem(entry);
+                _rbuf_drop(entry);
                 return;
             }
             data += iphc_len;       /* take remaining data as data */
@@ -125,32 +124,27 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 
     if ((offset + frag_size) > entry->pkt->size) {
         DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
-        gnrc_pktbuf_release(entry->pkt);
-        _rbuf_rem(entry);
+        _rbuf_drop(entry);
         return;
     }
 
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
-            DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
-            gnrc_pktbuf_release(entry->pkt);
-            _rbuf_rem(entry);
-
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            rbuf_add(netif_hdr, pkt, original_size, offset);
+    res = _rbuf_update_ints(entry, offset, frag_size);
+    if (res < 0) {
+        DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+        _rbuf_drop(entry);
 
-            return;
-        }
+        /* "A fresh reassembly may be commenced with the most recently
+         * received link fragment"
+         * https://tools.ietf.org/html/rfc4944#section-5.3 */
+        rbuf_add(netif_hdr, pkt, original_size, offset);
 
-        ptr = ptr->next;
+        return;
     }
 
-    if (_rbuf_update_ints(entry, offset, frag_size)) {
+    if (res > 0) {
         DEBUG("6lo rbuf: add fragment data\n");
         entry->cur_size += (uint16_t)frag_size;
         memcpy(((uint8_t *)entry->pkt->data) + offset + data_offset, data,
@@ -163,8 +157,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 
         if (netif == NULL) {
             DEBUG("6lo rbuf: error allocating netif header\n");
-            gnrc_pktbuf_release(entry->pkt);
-            _rbuf_rem(entry);
+            _rbuf_drop(entry);
             return;
         }
 
@@ -185,88 +178,171 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             gnrc_pktbuf_release(entry->pkt);
         }
 
+        _stats.complete++;
         _rbuf_rem(entry);
     }
 }
 
-static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end)
+const gnrc_sixlowpan_frag_stats_t *gnrc_sixlowpan_frag_stats(void)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
+    return &_stats;
 }
 
-static rbuf_int_t *_rbuf_int_get_free(void)
+static inline rbuf_t *_entry(uint16_t link)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
+    return (link == 0) ? NULL : &rbuf[link - 1];
+}
+
+static inline uint16_t _link(const rbuf_t *entry)
+{
+    return (uint16_t)(entry - rbuf) + 1;
+}
+
+static uint16_t *_bucket(const void *src, size_t src_len,
+                         const void *dst, size_t dst_len,
+                         size_t size, uint16_t tag)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash ^ ((const uint8_t *)src)[i]) * 16777619U;
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash ^ ((const uint8_t *)dst)[i]) * 16777619U;
+    }
+    hash = (hash ^ (tag & 0xff)) * 16777619U;
+    hash = (hash ^ (tag >> 8)) * 16777619U;
+    hash = (hash ^ (size & 0xff)) * 16777619U;
+    hash = (hash ^ (size >> 8)) * 16777619U;
+
+    return &_index[hash % RBUF_INDEX_SIZE];
+}
+
+/* moves entry to the newest end of the list of entries ordered by arrival */
+static void _rbuf_lru_unlink(rbuf_t *entry)
+{
+    if (entry->older) {
+        _entry(entry->older)->newer = entry->newer;
     }
+    else {
+        _oldest = entry->newer;
+    }
+    if (entry->newer) {
+        _entry(entry->newer)->older = entry->older;
+    }
+    else {
+        _newest = entry->older;
+    }
+    entry->older = entry->newer = 0;
+}
 
-    return NULL;
+static void _rbuf_lru_append(rbuf_t *entry)
+{
+    entry->older = _newest;
+    entry->newer = 0;
+    if (_newest) {
+        _entry(_newest)->newer = _link(entry);
+    }
+    else {
+        _oldest = _link(entry);
+    }
+    _newest = _link(entry);
 }
 
 static void _rbuf_rem(rbuf_t *entry)
 {
-    while (entry->ints != NULL) {
-        rbuf_int_t *next = entry->ints->next;
+    uint16_t *link = _bucket(entry->src, entry->src_len, entry->dst,
+                             entry->dst_len, entry->size, entry->tag);
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
+    while (*link != _link(entry)) {
+        assert(*link != 0);
+        link = &_entry(*link)->next;
     }
+    *link = entry->next;
+    _rbuf_lru_unlink(entry);
+    _mem_used -= entry->size;
 
     entry->pkt = NULL;
+    entry->next = _free;
+    _free = _link(entry);
 }
 
-static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+static void _rbuf_drop(rbuf_t *entry)
 {
-    rbuf_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    _stats.drops++;
+    gnrc_pktbuf_release(entry->pkt);
+    _rbuf_rem(entry);
+}
 
-    new = _rbuf_int_get_free();
+static int _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
+{
+    unsigned end = offset + frag_size;
+    unsigned first = offset / 8U;
+    unsigned last = (end + 7U) / 8U;                    /* exclusive */
+    unsigned received = 0;
 
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
+    for (unsigned i = first; i < last; i++) {
+        received += bf_isset(entry->received, i);
     }
 
-    new->start = offset;
-    new->end = end;
-
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(l2addr_str,
-                  sizeof(l2addr_str), entry->src, entry->src_len));
-    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
-            sizeof(l2addr_str), entry->dst, entry->dst_len),
-          (unsigned)entry->pkt->size, entry->tag);
+    if (received == 0) {
+        DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
+              offset, (uint16_t)(offset + frag_size - 1),
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), entry->src,
+                                     entry->src_len));
+        DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(l2addr_str,
+                sizeof(l2addr_str), entry->dst, entry->dst_len),
+              (unsigned)entry->size, entry->tag);
+
+        bf_set(entry->starts, first);
+        for (unsigned i = first; i < last; i++) {
+            bf_set(entry->received, i);
+        }
+        return 1;
+    }
 
-    LL_PREPEND(entry->ints, new);
+    /* a duplicate covers exactly the units of one received fragment */
+    if ((received != (last - first)) || !bf_isset(entry->starts, first)) {
+        return -1;
+    }
+    /* only the last fragment may end within a unit, so a fragment ending
+     * anywhere else in its last unit differs in size from the one received */
+    if ((end != (last * 8U)) && (end != entry->size)) {
+        return -1;
+    }
+    for (unsigned i = first + 1; i < last; i++) {
+        if (bf_isset(entry->starts, i)) {
+            return -1;
+        }
+    }
+    if ((last < ((entry->size + 7U) / 8U)) && bf_isset(entry->received, last) &&
+        !bf_isset(entry->starts, last)) {
+        return -1;
+    }
 
-    return true;
+    DEBUG("6lo rfrag: duplicate fragment\n");
+    return 0;
 }
 
 static void _rbuf_gc(void)
 {
     uint32_t now_usec = xtimer_now();
-    unsigned int i;
-
-    for (i = 0; i < RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
-                    sizeof(l2addr_str), rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), rbuf[i].dst,
-                                         rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-
-            gnrc_pktbuf_release(rbuf[i].pkt);
-            _rbuf_rem(&(rbuf[i]));
-        }
+    rbuf_t *entry;
+
+    /* since pkt occupies pktbuf, aggressivly collect garbage */
+    while (((entry = _entry(_oldest)) != NULL) &&
+           ((now_usec - entry->arrival) > RBUF_TIMEOUT)) {
+        DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
+                sizeof(l2addr_str), entry->src, entry->src_len));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), entry->dst,
+                                     entry->dst_len),
+              (unsigned)entry->size, entry->tag);
+
+        _stats.timeouts++;
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
     }
 }
 
@@ -274,56 +350,68 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
 {
-    rbuf_t *res = NULL, *oldest = NULL;
+    rbuf_t *res;
+    uint16_t *bucket = _bucket(src, src_len, dst, dst_len, size, tag);
     uint32_t now_usec = xtimer_now();
 
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].pkt->size == size) &&
-            (rbuf[i].tag == tag) && (rbuf[i].src_len == src_len) &&
-            (rbuf[i].dst_len == dst_len) &&
-            (memcmp(rbuf[i].src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
+    /* check first if entry already available */
+    for (res = _entry(*bucket); res != NULL; res = _entry(res->next)) {
+        if ((res->size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
                   gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].src, rbuf[i].src_len));
+                                         res->src, res->src_len));
             DEBUG("%s, %u, %u) found\n",
                   gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].dst, rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-            rbuf[i].arrival = now_usec;
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].pkt == NULL)) {
-            res = &(rbuf[i]);
+                                         res->dst, res->dst_len),
+                  (unsigned)res->size, res->tag);
+            res->arrival = now_usec;
+            _rbuf_lru_unlink(res);
+            _rbuf_lru_append(res);
+            return res;
         }
+    }
 
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) || (oldest->arrival - rbuf[i].arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
-        }
+    if ((size > RBUF_DATAGRAM_MAX) || (size > RBUF_MEM_BUDGET)) {
+        DEBUG("6lo rfrag: datagram too big for reassembly buffer.\n");
+        _stats.drops++;
+        return NULL;
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        assert(oldest->pkt != NULL); /* if oldest->pkt == NULL, res must not be NULL */
+    /* entry not in buffer: remove oldest entries until there is an empty
+     * spot and the datagram fits into the budget */
+    while (((_free == 0) && (_fresh >= RBUF_SIZE)) ||
+           ((_mem_used + size) > RBUF_MEM_BUDGET)) {
+        res = _entry(_oldest);
+        assert(res != NULL);
         DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        gnrc_pktbuf_release(oldest->pkt);
-        _rbuf_rem(oldest);
-        res = oldest;
+        _stats.evictions++;
+        gnrc_pktbuf_release(res->pkt);
+        _rbuf_rem(res);
     }
 
     /* now we have an empty spot */
+    if (_free != 0) {
+        res = _entry(_free);
+    }
+    else {
+        res = &rbuf[_fresh];
+    }
 
     res->pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
     if (res->pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        _stats.drops++;
         return NULL;
     }
+    if (_free != 0) {
+        _free = res->next;
+    }
+    else {
+        _fresh++;
+    }
 
     *((uint64_t *)res->pkt->data) = 0;  /* clean first few bytes for later
                                          * look-ups */
@@ -333,7 +421,15 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->src_len = src_len;
     res->dst_len = dst_len;
     res->tag = tag;
+    res->size = size;
     res->cur_size = 0;
+    memset(res->received, 0, sizeof(res->received));
+    memset(res->starts, 0, sizeof(res->starts));
+
+    res->next = *bucket;
+    *bucket = _link(res);
+    _rbuf_lru_append(res);
+    _mem_used += size;
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
@@ -346,4 +442,20 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     return res;
 }
 
+#ifdef TEST_SUITES
+void rbuf_reset(void)
+{
+    rbuf_t *entry;
+
+    while ((entry = _entry(_oldest)) != NULL) {
+        gnrc_pktbuf_release(entry->pkt);
+        _rbuf_rem(entry);
+    }
+    memset(rbuf, 0, sizeof(rbuf));
+    memset(_index, 0, sizeof(_index));
+    _free = 0;
+    _fresh = 0;
+}
+#endif
+
 /** @} */
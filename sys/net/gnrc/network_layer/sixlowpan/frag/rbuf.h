@@ -21,8 +21,10 @@
 
 #include <inttypes.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
 
 #include "net/gnrc/sixlowpan/frag.h"
 #ifdef __cplusplus
@@ -31,26 +33,57 @@ extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)               /**< maximum length for link-layer addresses */
-#define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
-#define RBUF_TIMEOUT        (3U * SEC_IN_USEC) /**< timeout for reassembly in microseconds */
 
 /**
- * @brief   Fragment intervals to identify limits of fragments.
- *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
- *
- * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
- *          RFC 4944, section 5.3
- *      </a>
+ * @brief   Maximum number of datagrams reassembled concurrently
+ */
+#ifndef RBUF_SIZE
+#define RBUF_SIZE           (4U)
+#endif
+
+/**
+ * @brief   Number of hash buckets to look up datagrams
+ */
+#ifndef RBUF_INDEX_SIZE
+#define RBUF_INDEX_SIZE     (RBUF_SIZE)
+#endif
+
+/**
+ * @brief   Maximum number of bytes of the packet buffer all datagrams under
+ *          reassembly may occupy
  *
- * @internal
+ * If a new datagram does not fit, the oldest incomplete datagrams are
+ * evicted. Defaults to half of a static packet buffer, so that datagrams
+ * under reassembly can't starve all other packets.
+ */
+#ifndef RBUF_MEM_BUDGET
+#if GNRC_PKTBUF_SIZE > 0
+#define RBUF_MEM_BUDGET     (GNRC_PKTBUF_SIZE / 2)
+#else
+#define RBUF_MEM_BUDGET     (RBUF_SIZE * RBUF_DATAGRAM_MAX)
+#endif
+#endif
+
+/**
+ * @brief   Maximum size of a datagram, datagrams announcing a bigger size
+ *          are dropped
  */
-typedef struct rbuf_int {
-    struct rbuf_int *next;  /**< next element in interval list */
-    uint16_t start;         /**< start byte of interval */
-    uint16_t end;           /**< end byte of interval */
-} rbuf_int_t;
+#ifndef RBUF_DATAGRAM_MAX
+#define RBUF_DATAGRAM_MAX   (SIXLOWPAN_FRAG_SIZE_MASK)
+#endif
+
+/**
+ * @brief   Timeout for reassembly in microseconds
+ */
+#ifndef RBUF_TIMEOUT
+#define RBUF_TIMEOUT        (3U * SEC_IN_USEC)
+#endif
+
+/**
+ * @brief   Number of 8 byte units of a datagram, the granularity of fragment
+ *          offsets
+ */
+#define RBUF_UNITS          ((RBUF_DATAGRAM_MAX + 7U) / 8U)
 
 /**
  * @brief   An entry in the 6LoWPAN reassembly buffer.
@@ -64,6 +97,11 @@ typedef struct rbuf_int {
  *
  * to identify all fragments that belong to the given datagram.
  *
+ * The received fragments are tracked in units of 8 byte: rbuf_t::received
+ * marks all units covered by a fragment, rbuf_t::starts the units a
+ * fragment starts at, so that duplicates can be told apart from fragments
+ * overlapping only partially.
+ *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
@@ -71,7 +109,6 @@ typedef struct rbuf_int {
  * @internal
  */
 typedef struct {
-    rbuf_int_t *ints;                   /**< intervals of the fragment */
     gnrc_pktsnip_t *pkt;                /**< the reassembled packet in packet buffer */
     uint32_t arrival;                   /**< time in microseconds of arrival of
                                          *   last received fragment */
@@ -80,7 +117,14 @@ typedef struct {
     uint8_t src_len;                    /**< length of source address */
     uint8_t dst_len;                    /**< length of destination address */
     uint16_t tag;                       /**< the datagram's tag */
+    uint16_t size;                      /**< the datagram's size */
     uint16_t cur_size;                  /**< the datagram's current size */
+    uint16_t next;                      /**< next entry + 1 in the hash bucket
+                                         *   or the free list, 0 for none */
+    uint16_t older;                     /**< next older entry + 1, 0 for none */
+    uint16_t newer;                     /**< next newer entry + 1, 0 for none */
+    BITFIELD(received, RBUF_UNITS);     /**< received units */
+    BITFIELD(starts, RBUF_UNITS);       /**< units fragments start at */
 } rbuf_t;
 
 /**
@@ -100,6 +144,17 @@ typedef struct {
 void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *frag,
               size_t frag_size, size_t offset);
 
+/* for testing */
+#ifdef TEST_SUITES
+/**
+ * @brief   Releases all datagrams under reassembly and empties the
+ *          reassembly buffer
+ *
+ * @internal
+ */
+void rbuf_reset(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -131,7 +131,8 @@ static void _receive(gnrc_pktsnip_t *pkt)
     else if (sixlowpan_iphc_is(dispatch)) {
         size_t dispatch_size, nh_len;
         gnrc_pktsnip_t *sixlowpan;
-        gnrc_pktsnip_t *dec_hdr = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
+        /* reserve space for decoding a compressed next header in place */
+        gnrc_pktsnip_t *dec_hdr = gnrc_pktbuf_add(NULL, NULL, GNRC_SIXLOWPAN_IPHC_DEC_HDR_LEN,
                                                   GNRC_NETTYPE_IPV6);
         if ((dec_hdr == NULL) ||
             (dispatch_size = gnrc_sixlowpan_iphc_decode(&dec_hdr, pkt, 0, 0,
@@ -340,6 +341,18 @@ static void *_event_loop(void *args)
                 _send((gnrc_pktsnip_t *)msg.content.ptr);
                 break;
 
+#ifdef MODULE_GNRC_NETAPI_BATCH
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _receive);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _send);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("6lo: reply to unsupported get/set\n");
@@ -95,7 +95,7 @@ static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
 {
     uint8_t byte_mask[] = {0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x01};
 
-    if ((ctx == NULL) || (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
+    if ((ctx == NULL) || !(ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
         return false;
     }
 
@@ -127,7 +127,14 @@ inline static size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **d
     uint8_t tmp;
     udp_hdr_t *udp_hdr;
 
-    if (datagram_size == 0) {    /* received packet is not fragmented */
+    if ((datagram_size == 0) &&  /* received packet is not fragmented */
+        (ipv6->size >= (sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t)))) {
+        /* decode into space reserved behind the IPv6 header, the header
+         * snip is split up below */
+        udp = ipv6;
+        udp_hdr = (udp_hdr_t *)(ipv6_hdr + 1);
+    }
+    else if (datagram_size == 0) {
         udp = gnrc_pktbuf_add(NULL, NULL, sizeof(udp_hdr_t),
                               snip_type);
         if (udp == NULL) {
@@ -181,7 +188,9 @@ inline static size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **d
 
     if ((udp_nhc & NHC_UDP_C_ELIDED) != 0) {
         DEBUG("6lo iphc nhc: unsupported elided checksum\n");
-        gnrc_pktbuf_release(udp);
+        if (udp != ipv6) {
+            gnrc_pktbuf_release(udp);
+        }
         return 0;
     }
     else {
@@ -199,7 +208,15 @@ inline static size_t iphc_nhc_udp_decode(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t **d
     ipv6_hdr->nh = PROTNUM_UDP;
     ipv6_hdr->len = udp_hdr->length;
 
-    if (udp != NULL) {  /* prepend udp header in case of packet not being fragmented */
+    if (udp == ipv6) {
+        /* split off IPv6 header, the remaining UDP header precedes it */
+        if (gnrc_pktbuf_mark(ipv6, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6) == NULL) {
+            DEBUG("6lo iphc nhc: error splitting UDP from IPv6 header\n");
+            return 0;
+        }
+        udp->type = snip_type;
+    }
+    else if (udp != NULL) { /* prepend udp header in case of packet not being fragmented */
         udp->next = ipv6;
         *dec_hdr = udp;
     }
@@ -236,17 +253,19 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
     switch (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_TF) {
         case IPHC_TF_ECN_DSCP_FL:
             ipv6_hdr_set_tc(ipv6_hdr, iphc_hdr[payload_offset++]);
+            ipv6_hdr->v_tc_fl.u8[1] &= 0xf0;
             ipv6_hdr->v_tc_fl.u8[1] |= iphc_hdr[payload_offset++] & 0x0f;
-            ipv6_hdr->v_tc_fl.u8[2] |= iphc_hdr[payload_offset++];
-            ipv6_hdr->v_tc_fl.u8[3] |= iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[2] = iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[3] = iphc_hdr[payload_offset++];
             break;
 
         case IPHC_TF_ECN_FL:
             ipv6_hdr_set_tc_ecn(ipv6_hdr, iphc_hdr[payload_offset] >> 6);
             ipv6_hdr_set_tc_dscp(ipv6_hdr, 0);
+            ipv6_hdr->v_tc_fl.u8[1] &= 0xf0;
             ipv6_hdr->v_tc_fl.u8[1] |= iphc_hdr[payload_offset++] & 0x0f;
-            ipv6_hdr->v_tc_fl.u8[2] |= iphc_hdr[payload_offset++];
-            ipv6_hdr->v_tc_fl.u8[3] |= iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[2] = iphc_hdr[payload_offset++];
+            ipv6_hdr->v_tc_fl.u8[3] = iphc_hdr[payload_offset++];
             break;
 
         case IPHC_TF_ECN_DSCP:
@@ -334,6 +353,8 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
 
         case IPHC_SAC_SAM_CTX_64:
             assert(ctx != NULL);
+            /* bits between prefix and inline bits are zero */
+            ipv6_hdr->src.u64[0].u64 = 0;
             memcpy(ipv6_hdr->src.u8 + 8, iphc_hdr + payload_offset, 8);
             ipv6_addr_init_prefix(&ipv6_hdr->src, &ctx->prefix,
                                   ctx->prefix_len);
@@ -342,6 +363,8 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
 
         case IPHC_SAC_SAM_CTX_16:
             assert(ctx != NULL);
+            /* bits between prefix and inline bits are zero */
+            ipv6_hdr->src.u64[0].u64 = 0;
             ipv6_hdr->src.u32[2] = byteorder_htonl(0x000000ff);
             ipv6_hdr->src.u16[6] = byteorder_htons(0xfe00);
             memcpy(ipv6_hdr->src.u8 + 14, iphc_hdr + payload_offset, 2);
@@ -352,6 +375,8 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
 
         case IPHC_SAC_SAM_CTX_L2:
             assert(ctx != NULL);
+            /* bits between prefix and inline bits are zero */
+            ipv6_hdr->src.u64[0].u64 = 0;
             ieee802154_get_iid((eui64_t *)(&ipv6_hdr->src.u64[1]),
                                gnrc_netif_hdr_get_src_addr(netif_hdr),
                                netif_hdr->src_l2addr_len);
@@ -367,7 +392,8 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
             dci = iphc_hdr[CID_EXT_IDX] & 0x0f;
         }
 
-        if (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_DAM) {
+        /* unicast prefix based multicast addresses use DAM == 0 */
+        if (iphc_hdr[IPHC2_IDX] & (SIXLOWPAN_IPHC2_M | SIXLOWPAN_IPHC2_DAM)) {
             ctx = gnrc_sixlowpan_ctx_lookup_id(dci);
 
             if (ctx == NULL) {
@@ -407,6 +433,8 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_64:
+            /* bits between prefix and inline bits are zero */
+            ipv6_hdr->dst.u64[0].u64 = 0;
             memcpy(ipv6_hdr->dst.u8 + 8, iphc_hdr + payload_offset, 8);
             ipv6_addr_init_prefix(&ipv6_hdr->dst, &ctx->prefix,
                                   ctx->prefix_len);
@@ -414,6 +442,8 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_16:
+            /* bits between prefix and inline bits are zero */
+            ipv6_hdr->dst.u64[0].u64 = 0;
             ipv6_hdr->dst.u32[2] = byteorder_htonl(0x000000ff);
             ipv6_hdr->dst.u16[6] = byteorder_htons(0xfe00);
             memcpy(ipv6_hdr->dst.u8 + 14, iphc_hdr + payload_offset, 2);
@@ -423,6 +453,8 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_L2:
+            /* bits between prefix and inline bits are zero */
+            ipv6_hdr->dst.u64[0].u64 = 0;
             ieee802154_get_iid((eui64_t *)(&ipv6_hdr->dst.u64[1]),
                                gnrc_netif_hdr_get_dst_addr(netif_hdr),
                                netif_hdr->dst_l2addr_len);
@@ -470,9 +502,9 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
                 ipv6_hdr->dst.u8[1] = iphc_hdr[payload_offset++];
                 ipv6_hdr->dst.u8[2] = iphc_hdr[payload_offset++];
                 ipv6_hdr->dst.u8[3] = ctx->prefix_len;
-                ipv6_addr_init_prefix((ipv6_addr_t *)ipv6_hdr->dst.u8 + 4,
+                ipv6_addr_init_prefix((ipv6_addr_t *)(ipv6_hdr->dst.u8 + 4),
                                       &ctx->prefix, ctx->prefix_len);
-                memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset + 2, 4);
+                memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset, 4);
 
                 payload_offset += 4;
                 ctx->prefix_len = orig_ctx_len;
@@ -511,6 +543,12 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
     (void)nh_len;
 #endif
 
+    if ((datagram_size == 0) && (ipv6->type == GNRC_NETTYPE_IPV6) &&
+        (ipv6->size > sizeof(ipv6_hdr_t))) {
+        /* give back space reserved for a next header that was not decoded */
+        gnrc_pktbuf_realloc_data(ipv6, sizeof(ipv6_hdr_t));
+    }
+
     return payload_offset;
 }
 
@@ -582,133 +620,92 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
 }
 #endif
 
-bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
-{
-    gnrc_netif_hdr_t *netif_hdr = pkt->data;
-    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
-    uint8_t *iphc_hdr;
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
-    bool addr_comp = false, nhc_comp = false;
-    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
-                                               GNRC_NETTYPE_SIXLOWPAN);
+#define IPHC_FLOW_CTX_NUMOF         (3U)    /* source, destination, multicast */
+#define IPHC_FLOW_CTX_NONE          (0xff)
+
+/* maximum length of the IPHC header: dispatch, CID extension, traffic class
+ * and flow label, next header, hop limit, and both addresses inline */
+#define IPHC_HDR_MAX_LEN            (SIXLOWPAN_IPHC_HDR_LEN + \
+                                     SIXLOWPAN_IPHC_CID_EXT_LEN + 4U + 1U + 1U + \
+                                     (2 * sizeof(ipv6_addr_t)))
+
+/* compressed addresses of a flow: they only depend on the addresses and the
+ * contexts that were valid when they were compressed */
+typedef struct {
+    uint8_t ctx_id[IPHC_FLOW_CTX_NUMOF];    /* contexts the result depends on */
+    uint8_t ctx_flags[IPHC_FLOW_CTX_NUMOF];
+    uint8_t ctx_len[IPHC_FLOW_CTX_NUMOF];
+    uint8_t iphc2;                          /* second IPHC dispatch byte */
+    uint8_t cid_ext;                        /* CID extension byte */
+    uint8_t addr_len;                       /* length of addr */
+    uint8_t addr[2 * sizeof(ipv6_addr_t)];  /* inline source and destination */
+} _iphc_addrs_t;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+typedef struct {
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    kernel_pid_t if_pid;
+    uint16_t ctx_gen;
+    uint8_t src_l2addr_len;
+    uint8_t dst_l2addr_len;
+    uint8_t src_l2addr[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t dst_l2addr[IEEE802154_LONG_ADDRESS_LEN];
+    _iphc_addrs_t addrs;
+} _iphc_flow_t;
+
+static _iphc_flow_t _flows[GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _flows_next;    /* entry to replace next */
+#endif
 
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        return false;
+static void _ctx_snapshot(_iphc_addrs_t *addrs, unsigned i,
+                          const gnrc_sixlowpan_ctx_t *ctx)
+{
+    if (ctx != NULL) {
+        addrs->ctx_id[i] = ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK;
+        addrs->ctx_flags[i] = ctx->flags_id;
+        addrs->ctx_len[i] = ctx->prefix_len;
     }
+}
 
-    iphc_hdr = dispatch->data;
+static void _compress_addrs(_iphc_addrs_t *addrs, gnrc_netif_hdr_t *netif_hdr,
+                            ipv6_hdr_t *ipv6_hdr)
+{
+    uint8_t *inline_addr = addrs->addr;
+    uint8_t inline_pos = 0;
+    bool addr_comp = false;
+    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
 
-    /* set initial dispatch value*/
-    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[IPHC2_IDX] = 0;
+    memset(addrs->ctx_id, IPHC_FLOW_CTX_NONE, sizeof(addrs->ctx_id));
+    addrs->iphc2 = 0;
+    addrs->cid_ext = 0;
 
     /* check for available contexts */
     if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
         src_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->src));
+        _ctx_snapshot(addrs, 0, src_ctx);
     }
 
     if (!ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
         dst_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->dst));
-    }
-
-    /* if contexts available and both != 0 */
-    /* since this moves inline_pos we have to do this ahead*/
-    if (((src_ctx != NULL) &&
-         ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) &&
-         (src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) ||
-        ((dst_ctx != NULL) &&
-         ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) &&
-         (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP))) {
-        /* add context identifier extension */
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
-        iphc_hdr[CID_EXT_IDX] = 0;
-
-        /* move position to behind CID extension */
-        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
-    }
-
-    /* compress flow label and traffic class */
-    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
-        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
-            /* elide both traffic class and flow label */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
-        }
-        else {
-            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-        }
-    }
-    else {
-        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
-            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
-                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
-        }
-        else {
-            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
-        }
-
-        /* copy remaining byteos of flow label */
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
-    }
-
-    /* compress next header */
-    switch (ipv6_hdr->nh) {
-#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-        case PROTNUM_UDP:
-            iphc_nhc_udp_encode(pkt->next->next, ipv6_hdr);
-            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
-            nhc_comp = true;
-            break;
-#endif
-
-        default:
-            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
-            break;
-    }
-
-    /* compress hop limit */
-    switch (ipv6_hdr->hl) {
-        case 1:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
-            break;
-
-        case 64:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
-            break;
-
-        case 255:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
-            break;
-
-        default:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
-            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
-            break;
+        _ctx_snapshot(addrs, 1, dst_ctx);
     }
 
     if (ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_UNSPEC;
+        addrs->iphc2 |= IPHC_SAC_SAM_UNSPEC;
     }
     else {
         if ((src_ctx != NULL) && (src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
             /* stateful source address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_SAC;
+            addrs->iphc2 |= SIXLOWPAN_IPHC2_SAC;
 
             if (((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
+                addrs->cid_ext |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
             }
         }
 
-        if ((src_ctx != NULL) || ipv6_addr_is_link_local(&(ipv6_hdr->src))) {
+        if (((src_ctx != NULL) && (src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) ||
+            ipv6_addr_is_link_local(&(ipv6_hdr->src))) {
             eui64_t iid;
             iid.uint64.u64 = 0;
 
@@ -728,21 +725,21 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
                 _context_overlaps_iid(src_ctx, &ipv6_hdr->src, &iid)) {
                 /* 0 bits. The address is derived from link-layer address */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_L2;
+                addrs->iphc2 |= IPHC_SAC_SAM_L2;
                 addr_comp = true;
             }
             else if ((byteorder_ntohl(ipv6_hdr->src.u32[2]) == 0x000000ff) &&
                      (byteorder_ntohs(ipv6_hdr->src.u16[6]) == 0xfe00)) {
                 /* 16 bits. The address is derived using 16 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_16;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
+                addrs->iphc2 |= IPHC_SAC_SAM_16;
+                memcpy(inline_addr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
                 inline_pos += 2;
                 addr_comp = true;
             }
             else {
                 /* 64 bits. The address is derived using 64 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_64;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
+                addrs->iphc2 |= IPHC_SAC_SAM_64;
+                memcpy(inline_addr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
                 inline_pos += 8;
                 addr_comp = true;
             }
@@ -750,8 +747,8 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
         if (!addr_comp) {
             /* full address is carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-            memcpy(iphc_hdr + inline_pos, &ipv6_hdr->src, 16);
+            addrs->iphc2 |= IPHC_SAC_SAM_FULL;
+            memcpy(inline_addr + inline_pos, &ipv6_hdr->src, 16);
             inline_pos += 16;
         }
     }
@@ -760,7 +757,7 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
     /* M: Multicast compression */
     if (ipv6_addr_is_multicast(&(ipv6_hdr->dst))) {
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_M;
+        addrs->iphc2 |= SIXLOWPAN_IPHC2_M;
 
         /* if multicast address is of format ffXX::XXXX:XXXX:XXXX */
         if ((ipv6_hdr->dst.u16[1].u16 == 0) &&
@@ -772,26 +769,26 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
                 (ipv6_hdr->dst.u16[6].u16 == 0) &&
                 (ipv6_hdr->dst.u8[14] == 0)) {
                 /* 8 bits. The address is derived using 8 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_8;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[15];
+                addrs->iphc2 |= IPHC_M_DAC_DAM_M_8;
+                inline_addr[inline_pos++] = ipv6_hdr->dst.u8[15];
                 addr_comp = true;
             }
             /* if multicast address is of format ffXX::XX:XXXX */
             else if ((ipv6_hdr->dst.u16[5].u16 == 0) &&
                      (ipv6_hdr->dst.u8[12] == 0)) {
                 /* 32 bits. The address is derived using 32 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_32;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
+                addrs->iphc2 |= IPHC_M_DAC_DAM_M_32;
+                inline_addr[inline_pos++] = ipv6_hdr->dst.u8[1];
+                memcpy(inline_addr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
                 inline_pos += 3;
                 addr_comp = true;
             }
             /* if multicast address is of format ffXX::XX:XXXX:XXXX */
             else if (ipv6_hdr->dst.u8[10] == 0) {
                 /* 48 bits. The address is derived using 48 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_48;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
+                addrs->iphc2 |= IPHC_M_DAC_DAM_M_48;
+                inline_addr[inline_pos++] = ipv6_hdr->dst.u8[1];
+                memcpy(inline_addr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
                 inline_pos += 5;
                 addr_comp = true;
             }
@@ -806,19 +803,20 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
             unicast_prefix.u16[3] = ipv6_hdr->dst.u16[5];
 
             ctx = gnrc_sixlowpan_ctx_lookup_addr(&unicast_prefix);
+            _ctx_snapshot(addrs, 2, ctx);
 
             if ((ctx != NULL) && (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) &&
                 (ctx->prefix_len == ipv6_hdr->dst.u8[3])) {
                 /* Unicast prefix based IPv6 multicast address
                  * (https://tools.ietf.org/html/rfc3306) with given context
                  * for unicast prefix -> context based compression */
-                iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+                addrs->iphc2 |= SIXLOWPAN_IPHC2_DAC;
                 if ((ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) {
-                    iphc_hdr[CID_EXT_IDX] |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+                    addrs->cid_ext |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
                 }
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
+                inline_addr[inline_pos++] = ipv6_hdr->dst.u8[1];
+                inline_addr[inline_pos++] = ipv6_hdr->dst.u8[2];
+                memcpy(inline_addr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
                 inline_pos += 4;
                 addr_comp = true;
             }
@@ -828,12 +826,12 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
               ipv6_addr_is_link_local(&ipv6_hdr->dst)) && (netif_hdr->dst_l2addr_len > 0)) {
         eui64_t iid;
 
-        if (dst_ctx != NULL) {
+        if ((dst_ctx != NULL) && (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
             /* stateful destination address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+            addrs->iphc2 |= SIXLOWPAN_IPHC2_DAC;
 
             if (((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+                addrs->cid_ext |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
             }
         }
 
@@ -843,21 +841,21 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
         if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
             _context_overlaps_iid(dst_ctx, &(ipv6_hdr->dst), &iid)) {
             /* 0 bits. The address is derived using the link-layer address */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_L2;
+            addrs->iphc2 |= IPHC_M_DAC_DAM_U_L2;
             addr_comp = true;
         }
         else if ((byteorder_ntohl(ipv6_hdr->dst.u32[2]) == 0x000000ff) &&
                  (byteorder_ntohs(ipv6_hdr->dst.u16[6]) == 0xfe00)) {
             /* 16 bits. The address is derived using 16 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_16;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
+            addrs->iphc2 |= IPHC_M_DAC_DAM_U_16;
+            memcpy(&(inline_addr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
             inline_pos += 2;
             addr_comp = true;
         }
         else {
             /* 64 bits. The address is derived using 64 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_64;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
+            addrs->iphc2 |= IPHC_M_DAC_DAM_U_64;
+            memcpy(&(inline_addr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
             inline_pos += 8;
             addr_comp = true;
         }
@@ -865,25 +863,227 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
     if (!addr_comp) {
         /* full destination address is carried inline */
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-        memcpy(iphc_hdr + inline_pos, &ipv6_hdr->dst, 16);
+        addrs->iphc2 |= IPHC_SAC_SAM_FULL;
+        memcpy(inline_addr + inline_pos, &ipv6_hdr->dst, 16);
         inline_pos += 16;
     }
 
+    /* any context with an ID != 0 requires the context identifier extension */
+    if (addrs->cid_ext != 0) {
+        addrs->iphc2 |= SIXLOWPAN_IPHC2_CID_EXT;
+    }
+
+    addrs->addr_len = inline_pos;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+static bool _flow_valid(const _iphc_flow_t *flow)
+{
+    if (flow->ctx_gen != gnrc_sixlowpan_ctx_generation()) {
+        /* contexts were added or changed since the flow was compressed */
+        return false;
+    }
+    for (unsigned i = 0; i < IPHC_FLOW_CTX_NUMOF; i++) {
+        if (flow->addrs.ctx_id[i] != IPHC_FLOW_CTX_NONE) {
+            /* also applies lifetime of the context */
+            gnrc_sixlowpan_ctx_t *ctx = gnrc_sixlowpan_ctx_lookup_id(flow->addrs.ctx_id[i]);
+
+            if ((ctx == NULL) || (ctx->flags_id != flow->addrs.ctx_flags[i]) ||
+                (ctx->prefix_len != flow->addrs.ctx_len[i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static const _iphc_addrs_t *_flow_addrs(_iphc_addrs_t *tmp,
+                                        gnrc_netif_hdr_t *netif_hdr,
+                                        ipv6_hdr_t *ipv6_hdr)
+{
+    _iphc_flow_t *flow = NULL;
+    unsigned i;
+
+    if ((netif_hdr->src_l2addr_len > IEEE802154_LONG_ADDRESS_LEN) ||
+        (netif_hdr->dst_l2addr_len > IEEE802154_LONG_ADDRESS_LEN)) {
+        /* not cacheable */
+        _compress_addrs(tmp, netif_hdr, ipv6_hdr);
+        return tmp;
+    }
+
+    for (i = 0; i < GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        flow = &_flows[i];
+        if ((flow->if_pid == netif_hdr->if_pid) &&
+            (flow->src_l2addr_len == netif_hdr->src_l2addr_len) &&
+            (flow->dst_l2addr_len == netif_hdr->dst_l2addr_len) &&
+            ipv6_addr_equal(&flow->src, &ipv6_hdr->src) &&
+            ipv6_addr_equal(&flow->dst, &ipv6_hdr->dst) &&
+            (memcmp(flow->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    flow->src_l2addr_len) == 0) &&
+            (memcmp(flow->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                    flow->dst_l2addr_len) == 0)) {
+            if (_flow_valid(flow)) {
+                DEBUG("6lo iphc: use cached flow %u\n", i);
+                return &flow->addrs;
+            }
+            break;  /* recompress into stale entry */
+        }
+    }
+
+    if (i == GNRC_SIXLOWPAN_IPHC_CACHE_SIZE) {
+        flow = &_flows[_flows_next];
+        _flows_next = (_flows_next + 1) % GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+    }
+    flow->if_pid = netif_hdr->if_pid;
+    flow->src_l2addr_len = netif_hdr->src_l2addr_len;
+    flow->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+    memcpy(flow->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+           flow->src_l2addr_len);
+    memcpy(flow->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           flow->dst_l2addr_len);
+    memcpy(&flow->src, &ipv6_hdr->src, sizeof(ipv6_addr_t));
+    memcpy(&flow->dst, &ipv6_hdr->dst, sizeof(ipv6_addr_t));
+    flow->ctx_gen = gnrc_sixlowpan_ctx_generation();
+    _compress_addrs(&flow->addrs, netif_hdr, ipv6_hdr);
+    return &flow->addrs;
+}
+
+void gnrc_sixlowpan_iphc_cache_flush(void)
+{
+    /* KERNEL_PID_UNDEF never matches an outgoing packet */
+    memset(_flows, 0, sizeof(_flows));
+}
+#else
+static inline const _iphc_addrs_t *_flow_addrs(_iphc_addrs_t *tmp,
+                                               gnrc_netif_hdr_t *netif_hdr,
+                                               ipv6_hdr_t *ipv6_hdr)
+{
+    _compress_addrs(tmp, netif_hdr, ipv6_hdr);
+    return tmp;
+}
+#endif
+
+bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    gnrc_pktsnip_t *ipv6 = pkt->next;
+    ipv6_hdr_t *ipv6_hdr = ipv6->data;
+    uint8_t iphc_hdr[IPHC_HDR_MAX_LEN];
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+    bool nhc_comp = false;
+    _iphc_addrs_t tmp;
+    const _iphc_addrs_t *addrs = _flow_addrs(&tmp, netif_hdr, ipv6_hdr);
+
+    /* set initial dispatch value*/
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+    iphc_hdr[IPHC2_IDX] = addrs->iphc2;
+
+    if (addrs->iphc2 & SIXLOWPAN_IPHC2_CID_EXT) {
+        /* add context identifier extension */
+        iphc_hdr[CID_EXT_IDX] = addrs->cid_ext;
+
+        /* move position to behind CID extension */
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+
+    /* compress flow label and traffic class */
+    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
+        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
+            /* elide both traffic class and flow label */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
+        }
+        else {
+            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+        }
+    }
+    else {
+        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
+            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
+                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
+        }
+        else {
+            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
+        }
+
+        /* copy remaining byteos of flow label */
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)(ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff);
+    }
+
+    /* compress next header */
+    switch (ipv6_hdr->nh) {
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+        case PROTNUM_UDP:
+            iphc_nhc_udp_encode(ipv6->next, ipv6_hdr);
+            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
+            nhc_comp = true;
+            break;
+#endif
+
+        default:
+            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
+            break;
+    }
+
+    /* compress hop limit */
+    switch (ipv6_hdr->hl) {
+        case 1:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
+            break;
+
+        case 64:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
+            break;
+
+        case 255:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
+            break;
+
+        default:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
+            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
+            break;
+    }
+
+    memcpy(iphc_hdr + inline_pos, addrs->addr, addrs->addr_len);
+    inline_pos += addrs->addr_len;
+
     if (nhc_comp) {
         iphc_hdr[inline_pos++] = ipv6_hdr->nh;
     }
 
-    /* shrink dispatch allocation to final size */
-    /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
-    gnrc_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
+    /* gnrc_pktbuf_start_write() copies data still shared with another snip */
+    if ((ipv6->users == 1) && (inline_pos <= ipv6->size) &&
+        (gnrc_pktbuf_start_write(ipv6) != NULL)) {
+        /* IPv6 header is not shared: compress it in place */
+        memcpy(ipv6->data, iphc_hdr, inline_pos);
+        /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
+        gnrc_pktbuf_realloc_data(ipv6, (size_t)inline_pos);
+        ipv6->type = GNRC_NETTYPE_SIXLOWPAN;
+    }
+    else {
+        gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, iphc_hdr, inline_pos,
+                                                   GNRC_NETTYPE_SIXLOWPAN);
+
+        if (dispatch == NULL) {
+            DEBUG("6lo iphc: error allocating dispatch space\n");
+            return false;
+        }
 
-    /* remove IPv6 header */
-    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+        /* remove IPv6 header */
+        pkt = gnrc_pktbuf_remove_snip(pkt, ipv6);
 
-    /* insert dispatch into packet */
-    dispatch->next = pkt->next;
-    pkt->next = dispatch;
+        /* insert dispatch into packet */
+        dispatch->next = pkt->next;
+        pkt->next = dispatch;
+    }
 
     return true;
 }
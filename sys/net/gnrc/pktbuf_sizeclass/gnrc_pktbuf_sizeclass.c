@@ -0,0 +1,1043 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation with segregated size classes
+ *
+ * The arena is split into 8-byte units. Free chunks are kept in one doubly
+ * linked list per size class: one class per size for chunks of up to
+ * eight units (snip descriptors and headers) and one class per
+ * power of two above that (payloads). Allocation takes the head of the
+ * smallest fitting class (located with a bitmap), freeing coalesces with the
+ * direct neighbors (located with boundary tags), so both are O(1).
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "bitarithm.h"
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _UNIT               (8U)    /**< allocation granularity in byte */
+#define _UNITS              (GNRC_PKTBUF_SIZE / _UNIT)
+#define _NIL                (UINT16_MAX)
+#define _FOOTER             ((_UNIT / sizeof(uint16_t)) - 1)
+#define _EXACT_CLASSES      (8U)    /**< classes with exactly one size */
+#define _EXACT_SHIFT        (3U)    /**< log2(_EXACT_CLASSES) */
+#define _CLASSES            (16U)   /**< must fit into _nonempty */
+
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+#define _HAS_CHUNK(pkt)     ((pkt)->chunk_offset != GNRC_PKTSNIP_NO_CHUNK)
+#define _CHUNK_OFFSET(pkt)  ((pkt)->chunk_offset)
+#else
+#define _HAS_CHUNK(pkt)     (true)
+#define _CHUNK_OFFSET(pkt)  (0U)
+#endif
+
+#if defined(MODULE_GNRC_PKTBUF_HEADROOM) || defined(MODULE_GNRC_PKTBUF_COW)
+#define _HAS_SHARED
+#define _OWNS_DATA(pkt)     ((pkt)->shared == NULL)
+/* pushed headers refer to the owner of their chunk, but their data is theirs */
+#define _SHARES_DATA(pkt)   (((pkt)->shared != NULL) && _HAS_CHUNK(pkt))
+#else
+#define _OWNS_DATA(pkt)     (true)
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+/* headers pushed into the headroom of pkt may still be in use */
+#define _HEADROOM_IN_USE(pkt)   (_OWNS_DATA(pkt) && ((pkt)->users > 1) && \
+                                 ((pkt)->chunk_offset != (pkt)->headroom))
+#else
+#define _HEADROOM_IN_USE(pkt)   (false)
+#endif
+
+#if (_UNITS >= _NIL)
+#error "gnrc_pktbuf_sizeclass: GNRC_PKTBUF_SIZE too large"
+#endif
+
+/**
+ * @brief   A unit of the arena
+ *
+ * The first unit of a free chunk holds its list header, the last one the
+ * chunk's length in units (at index _FOOTER) so the chunk can be found from
+ * its successor.
+ */
+typedef union {
+    struct {
+        uint16_t next;      /**< first unit of next chunk in the class */
+        uint16_t prev;      /**< first unit of previous chunk in the class */
+        uint16_t units;     /**< length of the chunk in units */
+    } free;
+    uint16_t u16[_UNIT / sizeof(uint16_t)];
+    uint64_t align;
+} _unit_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+static _unit_t _pktbuf[_UNITS];
+static uint16_t _heads[_CLASSES];
+static uint16_t _nonempty;
+/* bit is set for first and last unit of every free chunk */
+static uint8_t _bounds[(_UNITS + 7) / 8];
+
+#ifdef DEVELHELP
+enum {
+    _STATS_DESC = 0,    /**< snip descriptors */
+    _STATS_HDR,         /**< data chunks served from the exact classes */
+    _STATS_PAYLOAD,     /**< larger data chunks */
+    _STATS_NUMOF,
+};
+
+typedef struct {
+    uint16_t units;
+    uint16_t max_units;
+    uint16_t chunks;
+    uint16_t max_chunks;
+} _stats_t;
+
+static const char *_stats_names[] = { "descriptor", "header", "payload" };
+static _stats_t _stats[_STATS_NUMOF];
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data, size_t size);
+static gnrc_pktsnip_t *_snip_alloc(void);
+static void _snip_free(gnrc_pktsnip_t *pkt);
+static void _free_data(gnrc_pktsnip_t *pkt);
+#ifdef _HAS_SHARED
+static void _unshare(gnrc_pktsnip_t *pkt);
+#endif
+#ifdef MODULE_GNRC_PKTBUF_COW
+static gnrc_pktbuf_cow_stats_t _cow_stats;
+#endif
+
+static inline bool _pktbuf_contains(void *ptr)
+{
+    return ((uint8_t *)ptr >= (uint8_t *)&_pktbuf[0]) &&
+           ((uint8_t *)ptr < (uint8_t *)&_pktbuf[_UNITS]);
+}
+
+/* number of units required for size bytes */
+static inline uint16_t _units(size_t size)
+{
+    return (size == 0) ? 1 : (uint16_t)((size + _UNIT - 1) / _UNIT);
+}
+
+static inline uint16_t _index(void *ptr)
+{
+    assert(((uint8_t *)ptr - (uint8_t *)&_pktbuf[0]) % _UNIT == 0);
+    return (uint16_t)((_unit_t *)ptr - &_pktbuf[0]);
+}
+
+static inline unsigned _class(uint16_t units)
+{
+    unsigned class;
+
+    if (units <= _EXACT_CLASSES) {
+        return units - 1;
+    }
+    class = _EXACT_CLASSES + bitarithm_msb(units - 1) - _EXACT_SHIFT;
+    return (class < _CLASSES) ? class : (_CLASSES - 1);
+}
+
+static inline bool _bound_test(uint16_t idx)
+{
+    return _bounds[idx >> 3] & (1 << (idx & 0x7));
+}
+
+static inline void _bound_set(uint16_t idx)
+{
+    _bounds[idx >> 3] |= (1 << (idx & 0x7));
+}
+
+static inline void _bound_clr(uint16_t idx)
+{
+    _bounds[idx >> 3] &= ~(1 << (idx & 0x7));
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+    pkt->headroom = 0;
+    pkt->chunk_offset = 0;
+#endif
+#ifdef _HAS_SHARED
+    pkt->shared = NULL;
+#endif
+}
+
+#ifdef DEVELHELP
+/* class of a data chunk, descriptors are counted by _snip_alloc() */
+static inline unsigned _stats_class(uint16_t units)
+{
+    return (units <= _EXACT_CLASSES) ? _STATS_HDR : _STATS_PAYLOAD;
+}
+
+static void _stats_add(unsigned class, uint16_t units)
+{
+    _stats_t *stats = &_stats[class];
+
+    stats->units += units;
+    stats->chunks++;
+    if (stats->units > stats->max_units) {
+        stats->max_units = stats->units;
+    }
+    if (stats->chunks > stats->max_chunks) {
+        stats->max_chunks = stats->chunks;
+    }
+}
+
+static void _stats_sub(unsigned class, uint16_t units)
+{
+    _stats_t *stats = &_stats[class];
+
+    stats->units -= units;
+    stats->chunks--;
+}
+#else
+#define _stats_add(class, units)    (void)(units)
+#define _stats_sub(class, units)    (void)(units)
+#endif
+
+static void _list_add(uint16_t idx, uint16_t units)
+{
+    unsigned class = _class(units);
+    uint16_t last = idx + units - 1;
+
+    _pktbuf[idx].free.units = units;
+    _pktbuf[idx].free.prev = _NIL;
+    _pktbuf[idx].free.next = _heads[class];
+    if (_heads[class] != _NIL) {
+        _pktbuf[_heads[class]].free.prev = idx;
+    }
+    _heads[class] = idx;
+    _nonempty |= (1U << class);
+    _pktbuf[last].u16[_FOOTER] = units;
+    _bound_set(idx);
+    _bound_set(last);
+}
+
+static void _list_del(uint16_t idx)
+{
+    uint16_t units = _pktbuf[idx].free.units;
+    uint16_t next = _pktbuf[idx].free.next;
+    uint16_t prev = _pktbuf[idx].free.prev;
+    unsigned class = _class(units);
+
+    if (prev != _NIL) {
+        _pktbuf[prev].free.next = next;
+    }
+    else {
+        _heads[class] = next;
+        if (next == _NIL) {
+            _nonempty &= ~(1U << class);
+        }
+    }
+    if (next != _NIL) {
+        _pktbuf[next].free.prev = prev;
+    }
+    _bound_clr(idx);
+    _bound_clr(idx + units - 1);
+}
+
+static uint16_t _chunk_alloc(uint16_t units)
+{
+    unsigned class = _class(units);
+    uint16_t idx = _heads[class];
+
+    if ((idx == _NIL) || (_pktbuf[idx].free.units < units)) {
+        /* every chunk in a higher class fits */
+        uint16_t mask = _nonempty & ~((2U << class) - 1);
+
+        if (mask != 0) {
+            idx = _heads[bitarithm_lsb(mask)];
+        }
+        else {
+            /* memory is tight: fall back to first fit within own class */
+            while ((idx != _NIL) && (_pktbuf[idx].free.units < units)) {
+                idx = _pktbuf[idx].free.next;
+            }
+            if (idx == _NIL) {
+                DEBUG("pktbuf: no space left in packet buffer\n");
+                return _NIL;
+            }
+        }
+    }
+    _list_del(idx);
+    if (_pktbuf[idx].free.units > units) {
+        _list_add(idx + units, _pktbuf[idx].free.units - units);
+    }
+    return idx;
+}
+
+static void _chunk_free(uint16_t idx, uint16_t units)
+{
+    uint16_t end = idx + units;
+
+    if ((idx > 0) && _bound_test(idx - 1)) {
+        uint16_t prev_units = _pktbuf[idx - 1].u16[_FOOTER];
+
+        idx -= prev_units;
+        units += prev_units;
+        _list_del(idx);
+    }
+    if ((end < _UNITS) && _bound_test(end)) {
+        units += _pktbuf[end].free.units;
+        _list_del(end);
+    }
+    _list_add(idx, units);
+}
+
+/* tries to enlarge the chunk at idx into its free successor */
+static bool _chunk_grow(uint16_t idx, uint16_t units, uint16_t new_units)
+{
+    uint16_t end = idx + units, avail;
+
+    if ((end >= _UNITS) || !_bound_test(end)) {
+        return false;
+    }
+    avail = _pktbuf[end].free.units;
+    if ((units + avail) < new_units) {
+        return false;
+    }
+    _list_del(end);
+    if ((units + avail) > new_units) {
+        _list_add(idx + new_units, units + avail - new_units);
+    }
+    return true;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    memset(_bounds, 0, sizeof(_bounds));
+    memset(_heads, 0xff, sizeof(_heads));
+    _nonempty = 0;
+#ifdef DEVELHELP
+    memset(_stats, 0, sizeof(_stats));
+#endif
+    _list_add(0, _UNITS);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if ((size == 0) || (size > GNRC_PKTBUF_SIZE)) {
+        DEBUG("pktbuf: size (%u) == 0 || size == GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+    uint8_t *chunk;
+
+    /* keep the data on a unit boundary */
+    headroom = ((headroom + _UNIT - 1) / _UNIT) * _UNIT;
+    if ((size == 0) || (headroom >= GNRC_PKTSNIP_NO_CHUNK) ||
+        ((headroom + size) > GNRC_PKTBUF_SIZE)) {
+        DEBUG("pktbuf: size (%u) == 0 || size + headroom (%u) > "
+              "GNRC_PKTBUF_SIZE (%u)\n", (unsigned)size, (unsigned)headroom,
+              GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _snip_alloc();
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    chunk = _pktbuf_alloc(headroom + size);
+    if (chunk == NULL) {
+        DEBUG("pktbuf: error allocating data for new packet snip\n");
+        _snip_free(pkt);
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(pkt, next, chunk + headroom, size, type);
+    pkt->headroom = headroom;
+    pkt->chunk_offset = headroom;
+    if (data != NULL) {
+        memcpy(pkt->data, data, size);
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_push(gnrc_pktsnip_t *pkt, void *data, size_t size,
+                                 gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *hdr;
+
+    mutex_lock(&_mutex);
+    /* keep headers aligned, the layers access them as structs */
+    if ((pkt == NULL) || (size == 0) || (size > pkt->headroom) ||
+        (size & (sizeof(void *) - 1))) {
+        mutex_unlock(&_mutex);
+        return gnrc_pktbuf_add(pkt, data, size, type);
+    }
+    hdr = _snip_alloc();
+    if (hdr == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(hdr, pkt, ((uint8_t *)pkt->data) - size, size, type);
+    hdr->headroom = pkt->headroom - size;
+    hdr->chunk_offset = GNRC_PKTSNIP_NO_CHUNK;
+    /* keep the chunk the header lies in alive as long as the header */
+    hdr->shared = (_OWNS_DATA(pkt)) ? pkt : pkt->shared;
+    hdr->shared->users++;
+    pkt->headroom = 0;
+    if (data != NULL) {
+        memcpy(hdr->data, data, size);
+    }
+    mutex_unlock(&_mutex);
+    return hdr;
+}
+#endif
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    else if (size == pkt->size) {
+        pkt->type = type;
+        mutex_unlock(&_mutex);
+        return pkt;
+    }
+    /* the marked part would take the pushed headers in front of pkt along */
+    assert(!_HEADROOM_IN_USE(pkt));
+    marked_snip = _snip_alloc();
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* split would not end on a unit boundary => move data around */
+    if (_OWNS_DATA(pkt) && (!_pktbuf_contains(pkt->data) || (size % _UNIT))) {
+        void *new_data_rest;
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _snip_free(marked_snip);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        new_data_rest = _pktbuf_alloc(pkt->size - size);
+        if (new_data_rest == NULL) {
+            DEBUG("pktbuf: could not reallocate remaining section.\n");
+            _snip_free(marked_snip);
+            _pktbuf_free(new_data_marked, size);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        _free_data(pkt);
+        marked_snip->data = new_data_marked;
+        pkt->data = new_data_rest;
+        pkt->size -= size;
+        _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        pkt->headroom = 0;
+        pkt->chunk_offset = 0;
+#endif
+    }
+    else {
+        if (_OWNS_DATA(pkt)) {
+            uint16_t units = _units(_CHUNK_OFFSET(pkt) + pkt->size);
+            uint16_t marked_units = _units(_CHUNK_OFFSET(pkt) + size);
+
+            _stats_sub(_stats_class(units), units);
+            _stats_add(_stats_class(marked_units), marked_units);
+            _stats_add(_stats_class(units - marked_units), units - marked_units);
+        }
+        new_data_marked = pkt->data;
+        pkt->data = ((uint8_t *)pkt->data) + size;
+        pkt->size -= size;
+        _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        /* the marked part starts the chunk, so it takes over the headroom */
+        marked_snip->headroom = pkt->headroom;
+        marked_snip->chunk_offset = pkt->chunk_offset;
+        pkt->headroom = 0;
+        if (_OWNS_DATA(pkt)) {
+            pkt->chunk_offset = 0;
+        }
+#endif
+#ifdef _HAS_SHARED
+        if (pkt->shared != NULL) {
+            /* both parts keep the shared data alive */
+            marked_snip->shared = pkt->shared;
+            pkt->shared->users++;
+        }
+#endif
+    }
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+/* moves the data of pkt into a new chunk of size bytes */
+static int _move_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    void *new_data = _pktbuf_alloc(size);
+
+    if (new_data == NULL) {
+        DEBUG("pktbuf: error allocating new data section\n");
+        return ENOMEM;
+    }
+    memcpy(new_data, pkt->data, pkt->size);
+    /* would free the headers pushed into the headroom of pkt */
+    assert(!_HEADROOM_IN_USE(pkt));
+    _free_data(pkt);
+    pkt->data = new_data;
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+    pkt->headroom = 0;
+    pkt->chunk_offset = 0;
+#endif
+#ifdef _HAS_SHARED
+    if (pkt->shared != NULL) {
+        _unshare(pkt);
+    }
+#endif
+    return 0;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    uint16_t idx, units, new_units;
+
+    mutex_lock(&_mutex);
+    assert((pkt != NULL) && (pkt->data != NULL) && _pktbuf_contains(pkt->data));
+    if ((size == 0) || (size > GNRC_PKTBUF_SIZE)) {
+        DEBUG("pktbuf: size == 0 || size > GNRC_PKTBUF_SIZE\n");
+        mutex_unlock(&_mutex);
+        return ENOMEM;
+    }
+    if (size == pkt->size) {
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    if (!_OWNS_DATA(pkt)) {
+        /* data of another snip can't be freed in parts */
+        if ((size > pkt->size) && (_move_data(pkt, size) != 0)) {
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        pkt->size = size;
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* the chunk includes the headroom in front of the data */
+    idx = _index(((uint8_t *)pkt->data) - _CHUNK_OFFSET(pkt));
+    units = _units(_CHUNK_OFFSET(pkt) + pkt->size);
+    new_units = _units(_CHUNK_OFFSET(pkt) + size);
+    if (new_units < units) {
+        _chunk_free(idx + new_units, units - new_units);
+    }
+    else if ((new_units > units) && !_chunk_grow(idx, units, new_units)) {
+        int res = _move_data(pkt, size);
+
+        if (res == 0) {
+            pkt->size = size;
+        }
+        mutex_unlock(&_mutex);
+        return res;
+    }
+    _stats_sub(_stats_class(units), units);
+    _stats_add(_stats_class(new_units), new_units);
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _free_data(pkt);
+#ifdef _HAS_SHARED
+            if (pkt->shared != NULL) {
+                _unshare(pkt);
+            }
+#endif
+            _snip_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+#ifdef MODULE_GNRC_PKTBUF_COW
+    if (_SHARES_DATA(pkt)) {
+        /* only user of the snip, but not of its data: copy it now */
+        void *data = _pktbuf_alloc(pkt->size);
+
+        if (data == NULL) {
+            DEBUG("pktbuf: error allocating data for shared packet snip\n");
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(data, pkt->data, pkt->size);
+        pkt->data = data;
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        pkt->headroom = 0;
+        pkt->chunk_offset = 0;
+#endif
+        _unshare(pkt);
+        _cow_stats.copied++;
+    }
+#endif
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef MODULE_GNRC_PKTBUF_COW
+gnrc_pktsnip_t *gnrc_pktbuf_start_write_snip(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *new;
+
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users == 1) {
+        mutex_unlock(&_mutex);
+        return pkt;
+    }
+    new = _snip_alloc();
+    if (new == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(new, pkt->next, pkt->data, pkt->size, pkt->type);
+    if (_SHARES_DATA(pkt)) {
+        /* always refer to the owner of the data */
+        new->shared = pkt->shared;
+        new->shared->users++;
+        pkt->users--;
+    }
+    else {
+        /* the user given up by the caller becomes the reference of new */
+        new->shared = pkt;
+    }
+    _cow_stats.shared++;
+    _cow_stats.shared_bytes += pkt->size;
+    mutex_unlock(&_mutex);
+    return new;
+}
+
+void gnrc_pktbuf_cow_stats(gnrc_pktbuf_cow_stats_t *stats)
+{
+    mutex_lock(&_mutex);
+    *stats = _cow_stats;
+    mutex_unlock(&_mutex);
+}
+#endif
+
+gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
+{
+    size_t length;
+    gnrc_pktsnip_t *head;
+    struct iovec *vec;
+
+    if (pkt == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    /* count the number of snips in the packet and allocate the IOVEC */
+    length = gnrc_pkt_count(pkt);
+    head = gnrc_pktbuf_add(pkt, NULL, (length * sizeof(struct iovec)),
+                           GNRC_NETTYPE_IOVEC);
+    if (head == NULL) {
+        *len = 0;
+        return NULL;
+    }
+    vec = (struct iovec *)(head->data);
+    /* fill the IOVEC */
+    while (pkt != NULL) {
+        vec->iov_base = pkt->data;
+        vec->iov_len = pkt->size;
+        ++vec;
+        pkt = pkt->next;
+    }
+    *len = length;
+    return head;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    mutex_lock(&_mutex);
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&_pktbuf[0], (void *)&_pktbuf[_UNITS], GNRC_PKTBUF_SIZE);
+    for (unsigned i = 0; i < _STATS_NUMOF; i++) {
+        printf("  %-10s: in use: %5lu B (%3u chunks), high-water mark: "
+               "%5lu B (%3u chunks)\n", _stats_names[i],
+               (unsigned long)_stats[i].units * _UNIT, _stats[i].chunks,
+               (unsigned long)_stats[i].max_units * _UNIT,
+               _stats[i].max_chunks);
+    }
+    for (unsigned i = 0; i < _CLASSES; i++) {
+        unsigned count = 0;
+        unsigned long bytes = 0;
+
+        for (uint16_t idx = _heads[i]; idx != _NIL; idx = _pktbuf[idx].free.next) {
+            bytes += (unsigned long)_pktbuf[idx].free.units * _UNIT;
+            count++;
+        }
+        if (count > 0) {
+            printf("  free class %2u: %3u chunks, %5lu B\n", i, count, bytes);
+        }
+    }
+#ifdef MODULE_GNRC_PKTBUF_COW
+    printf("  shared snips: %" PRIu32 " (%" PRIu32 " B not copied), "
+           "copied on write: %" PRIu32 "\n", _cow_stats.shared,
+           _cow_stats.shared_bytes, _cow_stats.copied);
+#endif
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    unsigned class = _class(_UNITS);
+
+    return (_nonempty == (1U << class)) && (_heads[class] == 0) &&
+           (_pktbuf[0].free.units == _UNITS);
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    unsigned free_units = 0;
+
+    /* Invariants of this implementation:
+     *  - _nonempty has the bit of a class set iff its list is not empty
+     *  - forall chunks in class list c: _class(chunk->units) == c and the
+     *    chunk is completely within the arena
+     *  - forall chunks: the list is properly double linked
+     *  - forall chunks: first and last unit are marked in _bounds and the
+     *    footer repeats the chunk length
+     *  - forall chunks: neither neighbor is free (chunks are coalesced)
+     *  - sum of free units is at most the size of the arena
+     */
+    for (unsigned class = 0; class < _CLASSES; class++) {
+        uint16_t prev = _NIL;
+
+        if ((_heads[class] == _NIL) == ((_nonempty & (1U << class)) != 0)) {
+            return false;
+        }
+        for (uint16_t idx = _heads[class]; idx != _NIL;
+             idx = _pktbuf[idx].free.next) {
+            uint16_t units = _pktbuf[idx].free.units;
+            uint16_t end = idx + units;
+
+            if ((idx >= _UNITS) || (units == 0) || (units > (_UNITS - idx))) {
+                return false;
+            }
+            free_units += units;
+            if ((free_units > _UNITS) || (_class(units) != class) ||
+                (_pktbuf[idx].free.prev != prev)) {
+                return false;
+            }
+            if (!_bound_test(idx) || !_bound_test(end - 1) ||
+                (_pktbuf[end - 1].u16[_FOOTER] != units)) {
+                return false;
+            }
+            if (((idx > 0) && _bound_test(idx - 1)) ||
+                ((end < _UNITS) && _bound_test(end))) {
+                return false;
+            }
+            prev = idx;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _snip_alloc();
+    void *_data;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    _data = _pktbuf_alloc(size);
+    if (_data == NULL) {
+        DEBUG("pktbuf: error allocating data for new packet snip\n");
+        _snip_free(pkt);
+        return NULL;
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if (data != NULL) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    uint16_t units, idx;
+
+    if (size > GNRC_PKTBUF_SIZE) {
+        return NULL;
+    }
+    units = _units(size);
+    idx = _chunk_alloc(units);
+    if (idx == _NIL) {
+        return NULL;
+    }
+    _stats_add(_stats_class(units), units);
+    return &_pktbuf[idx];
+}
+
+static void _pktbuf_free(void *data, size_t size)
+{
+    uint16_t units;
+
+    if (!_pktbuf_contains(data)) {
+        return;
+    }
+    units = _units(size);
+    _stats_sub(_stats_class(units), units);
+    _chunk_free(_index(data), units);
+}
+
+static gnrc_pktsnip_t *_snip_alloc(void)
+{
+    uint16_t idx = _chunk_alloc(_units(sizeof(gnrc_pktsnip_t)));
+
+    if (idx == _NIL) {
+        return NULL;
+    }
+    _stats_add(_STATS_DESC, _units(sizeof(gnrc_pktsnip_t)));
+    return (gnrc_pktsnip_t *)&_pktbuf[idx];
+}
+
+static void _snip_free(gnrc_pktsnip_t *pkt)
+{
+    _stats_sub(_STATS_DESC, _units(sizeof(gnrc_pktsnip_t)));
+    _chunk_free(_index(pkt), _units(sizeof(gnrc_pktsnip_t)));
+}
+
+/* frees the data of pkt together with the headroom in front of it */
+static void _free_data(gnrc_pktsnip_t *pkt)
+{
+    if (_OWNS_DATA(pkt)) {
+        _pktbuf_free(((uint8_t *)pkt->data) - _CHUNK_OFFSET(pkt),
+                     _CHUNK_OFFSET(pkt) + pkt->size);
+    }
+}
+
+#ifdef _HAS_SHARED
+/* drops the reference of pkt to the snip whose data it shares or whose
+ * headroom it lies in */
+static void _unshare(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *owner = pkt->shared;
+
+    pkt->shared = NULL;
+    if (owner->users == 1) {
+        owner->users = 0;
+        _free_data(owner);
+        if (owner->shared != NULL) {
+            /* owner is a pushed header shared with start_write_snip() */
+            _unshare(owner);
+        }
+        _snip_free(owner);
+    }
+    else {
+        owner->users--;
+    }
+}
+#endif
+
+gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *snip)
+{
+    LL_DELETE(pkt, snip);
+    snip->next = NULL;
+    gnrc_pktbuf_release(snip);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *old, gnrc_pktsnip_t *add)
+{
+    /* If add is a list we need to preserve its tail */
+    if (add->next != NULL) {
+        gnrc_pktsnip_t *tail = add->next;
+        gnrc_pktsnip_t *back;
+        LL_SEARCH_SCALAR(tail, back, next, NULL); /* find the last snip in add */
+        /* Replace old */
+        LL_REPLACE_ELEM(pkt, old, add);
+        /* and wire in the tail between */
+        back->next = add->next;
+        add->next = tail;
+    }
+    else {
+        /* add is a single element, has no tail, simply replace */
+        LL_REPLACE_ELEM(pkt, old, add);
+    }
+    old->next = NULL;
+    gnrc_pktbuf_release(old);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
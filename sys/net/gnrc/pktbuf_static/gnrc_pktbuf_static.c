@@ -36,6 +36,31 @@
 
 #define _ALIGNMENT_MASK    (sizeof(void *) - 1)
 
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+#define _HAS_CHUNK(pkt)     ((pkt)->chunk_offset != GNRC_PKTSNIP_NO_CHUNK)
+#define _CHUNK_OFFSET(pkt)  ((pkt)->chunk_offset)
+#else
+#define _HAS_CHUNK(pkt)     (true)
+#define _CHUNK_OFFSET(pkt)  (0U)
+#endif
+
+#if defined(MODULE_GNRC_PKTBUF_HEADROOM) || defined(MODULE_GNRC_PKTBUF_COW)
+#define _HAS_SHARED
+#define _OWNS_DATA(pkt)     ((pkt)->shared == NULL)
+/* pushed headers refer to the owner of their chunk, but their data is theirs */
+#define _SHARES_DATA(pkt)   (((pkt)->shared != NULL) && _HAS_CHUNK(pkt))
+#else
+#define _OWNS_DATA(pkt)     (true)
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+/* headers pushed into the headroom of pkt may still be in use */
+#define _HEADROOM_IN_USE(pkt)   (_OWNS_DATA(pkt) && ((pkt)->users > 1) && \
+                                 ((pkt)->chunk_offset != (pkt)->headroom))
+#else
+#define _HEADROOM_IN_USE(pkt)   (false)
+#endif
+
 typedef struct _unused {
     struct _unused *next;
     unsigned int size;
@@ -55,6 +80,13 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t siz
                                     gnrc_nettype_t type);
 static void *_pktbuf_alloc(size_t size);
 static void _pktbuf_free(void *data, size_t size);
+static void _free_data(gnrc_pktsnip_t *pkt);
+#ifdef _HAS_SHARED
+static void _unshare(gnrc_pktsnip_t *pkt);
+#endif
+#ifdef MODULE_GNRC_PKTBUF_COW
+static gnrc_pktbuf_cow_stats_t _cow_stats;
+#endif
 
 static inline bool _pktbuf_contains(void *ptr)
 {
@@ -78,6 +110,13 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 #ifdef MODULE_GNRC_NETERR
     pkt->err_sub = KERNEL_PID_UNDEF;
 #endif
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+    pkt->headroom = 0;
+    pkt->chunk_offset = 0;
+#endif
+#ifdef _HAS_SHARED
+    pkt->shared = NULL;
+#endif
 }
 
 void gnrc_pktbuf_init(void)
@@ -105,6 +144,81 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
     return pkt;
 }
 
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+    uint8_t *chunk;
+
+    headroom = _align(headroom);
+    if ((size == 0) || (headroom >= GNRC_PKTSNIP_NO_CHUNK) ||
+        ((headroom + size) > GNRC_PKTBUF_SIZE)) {
+        DEBUG("pktbuf: size (%u) == 0 || size + headroom (%u) > "
+              "GNRC_PKTBUF_SIZE (%u)\n", (unsigned)size, (unsigned)headroom,
+              GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* the data needs the same space as without headroom, see _free_data() */
+    chunk = _pktbuf_alloc(headroom + ((size < sizeof(_unused_t)) ?
+                                      sizeof(_unused_t) : size));
+    if (chunk == NULL) {
+        DEBUG("pktbuf: error allocating data for new packet snip\n");
+        _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(pkt, next, chunk + headroom, size, type);
+    pkt->headroom = headroom;
+    pkt->chunk_offset = headroom;
+    if (data != NULL) {
+        memcpy(pkt->data, data, size);
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_push(gnrc_pktsnip_t *pkt, void *data, size_t size,
+                                 gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *hdr;
+
+    mutex_lock(&_mutex);
+    /* keep headers aligned, the layers access them as structs */
+    if ((pkt == NULL) || (size == 0) || (size > pkt->headroom) ||
+        (size & _ALIGNMENT_MASK)) {
+        mutex_unlock(&_mutex);
+        return gnrc_pktbuf_add(pkt, data, size, type);
+    }
+    hdr = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (hdr == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(hdr, pkt, ((uint8_t *)pkt->data) - size, size, type);
+    hdr->headroom = pkt->headroom - size;
+    hdr->chunk_offset = GNRC_PKTSNIP_NO_CHUNK;
+    /* keep the chunk the header lies in alive as long as the header */
+    hdr->shared = (_OWNS_DATA(pkt)) ? pkt : pkt->shared;
+    hdr->shared->users++;
+    pkt->headroom = 0;
+    if (data != NULL) {
+        memcpy(hdr->data, data, size);
+    }
+    mutex_unlock(&_mutex);
+    return hdr;
+}
+#endif
+
 gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
     gnrc_pktsnip_t *marked_snip;
@@ -127,6 +241,8 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         mutex_unlock(&_mutex);
         return pkt;
     }
+    /* the marked part would take the pushed headers in front of pkt along */
+    assert(!_HEADROOM_IN_USE(pkt));
     marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
@@ -134,7 +250,8 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         return NULL;
     }
     /* would not fit unused marker => move data around */
-    if ((size < required_new_size) || ((pkt->size - size) < sizeof(_unused_t))) {
+    if (_OWNS_DATA(pkt) &&
+        ((size < required_new_size) || ((pkt->size - size) < sizeof(_unused_t)))) {
         void *new_data_rest;
         new_data_marked = _pktbuf_alloc(size);
         if (new_data_marked == NULL) {
@@ -153,16 +270,38 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         }
         memcpy(new_data_marked, pkt->data, size);
         memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
-        _pktbuf_free(pkt->data, pkt->size);
+        _free_data(pkt);
         marked_snip->data = new_data_marked;
         pkt->data = new_data_rest;
+        pkt->size -= size;
+        _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        pkt->headroom = 0;
+        pkt->chunk_offset = 0;
+#endif
     }
     else {
         new_data_marked = pkt->data;
         pkt->data = ((uint8_t *)pkt->data) + size;
+        pkt->size -= size;
+        _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        /* the marked part starts the chunk, so it takes over the headroom */
+        marked_snip->headroom = pkt->headroom;
+        marked_snip->chunk_offset = pkt->chunk_offset;
+        pkt->headroom = 0;
+        if (_OWNS_DATA(pkt)) {
+            pkt->chunk_offset = 0;
+        }
+#endif
+#ifdef _HAS_SHARED
+        if (pkt->shared != NULL) {
+            /* both parts keep the shared data alive */
+            marked_snip->shared = pkt->shared;
+            pkt->shared->users++;
+        }
+#endif
     }
-    pkt->size -= size;
-    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
     pkt->next = marked_snip;
     mutex_unlock(&_mutex);
     return marked_snip;
@@ -184,6 +323,12 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         mutex_unlock(&_mutex);
         return 0;
     }
+    if (!_OWNS_DATA(pkt) && (size < pkt->size)) {
+        /* data of another snip can't be freed in parts */
+        pkt->size = size;
+        mutex_unlock(&_mutex);
+        return 0;
+    }
     if ((size > pkt->size) ||                               /* new size does not fit */
         ((pkt->size - aligned_size) < sizeof(_unused_t))) { /* resulting hole would not fit marker */
         void *new_data = _pktbuf_alloc(size);
@@ -193,8 +338,19 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
             return ENOMEM;
         }
         memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
-        _pktbuf_free(pkt->data, pkt->size);
+        /* would free the headers pushed into the headroom of pkt */
+        assert(!_HEADROOM_IN_USE(pkt));
+        _free_data(pkt);
         pkt->data = new_data;
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        pkt->headroom = 0;
+        pkt->chunk_offset = 0;
+#endif
+#ifdef _HAS_SHARED
+        if (pkt->shared != NULL) {
+            _unshare(pkt);
+        }
+#endif
     }
     else {
         if (_align(pkt->size) > aligned_size) {
@@ -225,7 +381,12 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
-            _pktbuf_free(pkt->data, pkt->size);
+            _free_data(pkt);
+#ifdef _HAS_SHARED
+            if (pkt->shared != NULL) {
+                _unshare(pkt);
+            }
+#endif
             _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
         }
         else {
@@ -260,10 +421,75 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
         mutex_unlock(&_mutex);
         return new;
     }
+#ifdef MODULE_GNRC_PKTBUF_COW
+    if (_SHARES_DATA(pkt)) {
+        /* only user of the snip, but not of its data: copy it now */
+        void *data = _pktbuf_alloc(pkt->size);
+
+        if (data == NULL) {
+            DEBUG("pktbuf: error allocating data for shared packet snip\n");
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(data, pkt->data, pkt->size);
+        pkt->data = data;
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        pkt->headroom = 0;
+        pkt->chunk_offset = 0;
+#endif
+        _unshare(pkt);
+        _cow_stats.copied++;
+    }
+#endif
     mutex_unlock(&_mutex);
     return pkt;
 }
 
+#ifdef MODULE_GNRC_PKTBUF_COW
+gnrc_pktsnip_t *gnrc_pktbuf_start_write_snip(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *new;
+
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users == 1) {
+        mutex_unlock(&_mutex);
+        return pkt;
+    }
+    new = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (new == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(new, pkt->next, pkt->data, pkt->size, pkt->type);
+    if (_SHARES_DATA(pkt)) {
+        /* always refer to the owner of the data */
+        new->shared = pkt->shared;
+        new->shared->users++;
+        pkt->users--;
+    }
+    else {
+        /* the user given up by the caller becomes the reference of new */
+        new->shared = pkt;
+    }
+    _cow_stats.shared++;
+    _cow_stats.shared_bytes += pkt->size;
+    mutex_unlock(&_mutex);
+    return new;
+}
+
+void gnrc_pktbuf_cow_stats(gnrc_pktbuf_cow_stats_t *stats)
+{
+    mutex_lock(&_mutex);
+    *stats = _cow_stats;
+    mutex_unlock(&_mutex);
+}
+#endif
+
 gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
 {
     size_t length;
@@ -322,6 +548,11 @@ void gnrc_pktbuf_stats(void)
     printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
            (void *)&_pktbuf[0], (void *)&_pktbuf[GNRC_PKTBUF_SIZE], GNRC_PKTBUF_SIZE);
     printf("  position of last byte used: %" PRIu16 "\n", max_byte_count);
+#ifdef MODULE_GNRC_PKTBUF_COW
+    printf("  shared snips: %" PRIu32 " (%" PRIu32 " B not copied), "
+           "copied on write: %" PRIu32 "\n", _cow_stats.shared,
+           _cow_stats.shared_bytes, _cow_stats.copied);
+#endif
     if (ptr == NULL) {  /* packet buffer is completely full */
         _print_chunk(chunk, GNRC_PKTBUF_SIZE, count++);
     }
@@ -457,6 +688,40 @@ static void *_pktbuf_alloc(size_t size)
     return (void *)ptr;
 }
 
+/* frees the data of pkt together with the headroom in front of it */
+static void _free_data(gnrc_pktsnip_t *pkt)
+{
+    if (_OWNS_DATA(pkt)) {
+        size_t size = (pkt->size < sizeof(_unused_t)) ? sizeof(_unused_t) : pkt->size;
+
+        _pktbuf_free(((uint8_t *)pkt->data) - _CHUNK_OFFSET(pkt),
+                     _CHUNK_OFFSET(pkt) + size);
+    }
+}
+
+#ifdef _HAS_SHARED
+/* drops the reference of pkt to the snip whose data it shares or whose
+ * headroom it lies in */
+static void _unshare(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *owner = pkt->shared;
+
+    pkt->shared = NULL;
+    if (owner->users == 1) {
+        owner->users = 0;
+        _free_data(owner);
+        if (owner->shared != NULL) {
+            /* owner is a pushed header shared with start_write_snip() */
+            _unshare(owner);
+        }
+        _pktbuf_free(owner, sizeof(gnrc_pktsnip_t));
+    }
+    else {
+        owner->users--;
+    }
+}
+#endif
+
 static inline bool _too_small_hole(_unused_t *a, _unused_t *b)
 {
     return sizeof(_unused_t) > (size_t)(((uint8_t *)b) - (((uint8_t *)a) + a->size));
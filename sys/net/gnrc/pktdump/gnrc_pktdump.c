@@ -140,6 +140,16 @@ static void *_eventloop(void *arg)
                 puts("PKTDUMP: data to send:");
                 _dump((gnrc_pktsnip_t *)msg.content.ptr);
                 break;
+#ifdef MODULE_GNRC_NETAPI_BATCH
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                puts("PKTDUMP: batch of data received:");
+                gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _dump);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                puts("PKTDUMP: batch of data to send:");
+                gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _dump);
+                break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 msg_reply(&msg, &reply);
@@ -104,8 +104,8 @@ static void _receive(gnrc_pktsnip_t *pkt)
     udp_hdr_t *hdr;
     uint32_t port;
 
-    /* mark UDP header */
-    udp = gnrc_pktbuf_start_write(pkt);
+    /* mark UDP header, the data itself is only read */
+    udp = gnrc_pktbuf_start_write_snip(pkt);
     if (udp == NULL) {
         DEBUG("udp: unable to get write access to packet\n");
         gnrc_pktbuf_release(pkt);
@@ -238,6 +238,16 @@ static void *_event_loop(void *arg)
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
                 _send((gnrc_pktsnip_t *)msg.content.ptr);
                 break;
+#ifdef MODULE_GNRC_NETAPI_BATCH
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV_BATCH\n");
+                gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _receive);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND_BATCH\n");
+                gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _send);
+                break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
             case GNRC_NETAPI_MSG_TYPE_GET:
                 msg_reply(&msg, &reply);
@@ -278,7 +288,7 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
     udp_hdr_t *hdr;
 
     /* allocate header */
-    res = gnrc_pktbuf_add(payload, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
+    res = gnrc_pktbuf_push(payload, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
     if (res == NULL) {
         return NULL;
     }
@@ -19,11 +19,13 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include "kernel_defines.h"
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
@@ -64,9 +66,321 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now64() + (ms * 1000);
 }
 
+/**
+ * @brief trie node types
+ */
+#define FIB_TRIE_ENTRY  (0) /**< node of a FIB entry linked into the trie */
+#define FIB_TRIE_DUP    (1) /**< node of a FIB entry with the prefix of another */
+#define FIB_TRIE_GLUE   (2) /**< branching node without FIB entry */
+
+static inline fib_entry_t *fib_trie_entry(fib_trie_node_t *node)
+{
+    return container_of(node, fib_entry_t, node);
+}
+
+static inline uint8_t *fib_trie_key(fib_trie_node_t *node)
+{
+    if (node->type == FIB_TRIE_GLUE) {
+        return container_of(node, fib_trie_glue_t, node)->key;
+    }
+    return fib_trie_entry(node)->global->address;
+}
+
+static inline unsigned fib_trie_bit(const uint8_t *key, unsigned pos)
+{
+    return (key[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/**
+ * @brief returns the position of the first bit in [from, to) that differs
+ *        between a and b, or to if there is none
+ */
+static unsigned fib_trie_common(const uint8_t *a, const uint8_t *b,
+                                unsigned from, unsigned to)
+{
+    unsigned pos = from;
+
+    while (pos < to) {
+        if (((pos & 0x7) == 0) && ((to - pos) >= 8)) {
+            if (a[pos >> 3] != b[pos >> 3]) {
+                /* find the differing bit below */
+                to = pos + 8;
+            }
+            else {
+                pos += 8;
+                continue;
+            }
+        }
+        if (fib_trie_bit(a, pos) != fib_trie_bit(b, pos)) {
+            break;
+        }
+        pos++;
+    }
+
+    return pos;
+}
+
+/**
+ * @brief returns the number of prefix bits of the entry's destination
+ *
+ * The all-zero address is the default route, addresses without
+ * FIB_FLAG_NET_PREFIX_MASK flags only match exactly.
+ */
+static unsigned fib_trie_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned len = global->address_size << 3;
+    size_t i = 0;
+
+    while ((i < global->address_size) && (global->address[i] == 0)) {
+        i++;
+    }
+    if (i == global->address_size) {
+        return 0;
+    }
+    if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        unsigned prefix = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                          >> FIB_FLAG_NET_PREFIX_SHIFT;
+        if (prefix < len) {
+            len = prefix;
+        }
+    }
+
+    return len;
+}
+
+/**
+ * @brief builds the free list of branching nodes of a table
+ *
+ * Every entry provides one branching node, which is sufficient since a trie
+ * over n entries never needs more than n - 1 of them.
+ */
+static void fib_trie_init(fib_table_t *table)
+{
+    table->trie = NULL;
+    table->trie_glue = NULL;
+
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_trie_node_t *glue = &table->data.entries[i].glue.node;
+        glue->parent = table->trie_glue;
+        table->trie_glue = glue;
+    }
+}
+
+static fib_trie_node_t *fib_trie_glue_alloc(fib_table_t *table,
+                                            const uint8_t *key, unsigned len)
+{
+    fib_trie_node_t *glue = table->trie_glue;
+
+    assert(glue != NULL);
+    table->trie_glue = glue->parent;
+    memcpy(container_of(glue, fib_trie_glue_t, node)->key, key,
+           UNIVERSAL_ADDRESS_SIZE);
+    glue->child[0] = glue->child[1] = glue->dup = NULL;
+    glue->len = len;
+    glue->type = FIB_TRIE_GLUE;
+
+    return glue;
+}
+
+static void fib_trie_glue_free(fib_table_t *table, fib_trie_node_t *glue)
+{
+    glue->parent = table->trie_glue;
+    table->trie_glue = glue;
+}
+
+/**
+ * @brief puts @p node (may be NULL) at the position of @p old in the trie
+ */
+static void fib_trie_replace(fib_table_t *table, fib_trie_node_t *old,
+                             fib_trie_node_t *node)
+{
+    fib_trie_node_t *parent = old->parent;
+
+    if (parent == NULL) {
+        table->trie = node;
+    }
+    else {
+        parent->child[parent->child[1] == old] = node;
+    }
+    if (node != NULL) {
+        node->parent = parent;
+    }
+}
+
+/**
+ * @brief puts @p node at the position of @p old and moves all children
+ */
+static void fib_trie_take(fib_table_t *table, fib_trie_node_t *old,
+                          fib_trie_node_t *node)
+{
+    fib_trie_replace(table, old, node);
+    for (unsigned i = 0; i < 2; i++) {
+        node->child[i] = old->child[i];
+        if (node->child[i] != NULL) {
+            node->child[i]->parent = node;
+        }
+    }
+}
+
+/**
+ * @brief links the entry into the trie of the table
+ */
+static void fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = &entry->node, *parent = NULL;
+    fib_trie_node_t **link = &table->trie;
+    uint8_t *key = entry->global->address;
+    unsigned len = fib_trie_len(entry);
+    unsigned common = 0;
+
+    node->child[0] = node->child[1] = node->dup = NULL;
+    node->len = len;
+    node->type = FIB_TRIE_ENTRY;
+
+    while (*link != NULL) {
+        fib_trie_node_t *cur = *link;
+        uint8_t *cur_key = fib_trie_key(cur);
+
+        common = fib_trie_common(key, cur_key, common,
+                                 (len < cur->len) ? len : cur->len);
+        if (common < cur->len) {
+            if (common == len) {
+                /* the new prefix covers cur */
+                node->child[fib_trie_bit(cur_key, len)] = cur;
+                node->parent = parent;
+            }
+            else {
+                /* the prefixes diverge, branch */
+                fib_trie_node_t *glue = fib_trie_glue_alloc(table, key, common);
+                glue->child[fib_trie_bit(key, common)] = node;
+                glue->child[fib_trie_bit(cur_key, common)] = cur;
+                glue->parent = parent;
+                node->parent = glue;
+                node = glue;
+            }
+            cur->parent = node;
+            *link = node;
+            return;
+        }
+        if (cur->len == len) {
+            if (cur->type == FIB_TRIE_GLUE) {
+                fib_trie_take(table, cur, node);
+                fib_trie_glue_free(table, cur);
+            }
+            else {
+                /* same prefix as cur, e.g. with different host bits */
+                node->type = FIB_TRIE_DUP;
+                node->parent = cur;
+                node->dup = cur->dup;
+                if (node->dup != NULL) {
+                    node->dup->parent = node;
+                }
+                cur->dup = node;
+            }
+            return;
+        }
+        parent = cur;
+        link = &cur->child[fib_trie_bit(key, cur->len)];
+    }
+
+    node->parent = parent;
+    *link = node;
+}
+
+/**
+ * @brief unlinks the entry from the trie of the table
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = &entry->node, *parent = node->parent, *child;
+
+    if (node->type == FIB_TRIE_DUP) {
+        parent->dup = node->dup;
+        if (node->dup != NULL) {
+            node->dup->parent = parent;
+        }
+        return;
+    }
+    if (node->dup != NULL) {
+        /* the next entry with this prefix takes over */
+        node->dup->type = FIB_TRIE_ENTRY;
+        fib_trie_take(table, node, node->dup);
+        return;
+    }
+    if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        fib_trie_take(table, node,
+                      fib_trie_glue_alloc(table, entry->global->address,
+                                          node->len));
+        return;
+    }
+
+    child = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    fib_trie_replace(table, node, child);
+    if ((child == NULL) && (parent != NULL) && (parent->type == FIB_TRIE_GLUE)) {
+        /* branching nodes always have two children */
+        fib_trie_replace(table, parent, (parent->child[0] != NULL) ?
+                         parent->child[0] : parent->child[1]);
+        fib_trie_glue_free(table, parent);
+    }
+}
+
+/**
+ * @brief removes the given entry
+ *
+ * @param[in] table the FIB table holding the entry
+ * @param[in] entry the entry to be removed
+ *
+ * @return 0 on success
+ */
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    if (entry->global != NULL) {
+        fib_trie_remove(table, entry);
+        universal_address_rem(entry->global);
+    }
+
+    if (entry->next_hop) {
+        universal_address_rem(entry->next_hop);
+    }
+
+    entry->global = NULL;
+    entry->global_flags = 0;
+    entry->next_hop = NULL;
+    entry->next_hop_flags = 0;
+
+    entry->iface_id = KERNEL_PID_UNDEF;
+    entry->lifetime = 0;
+
+    return 0;
+}
+
+/**
+ * @brief removes the entry if its lifetime expired
+ *
+ * @param[in] table the FIB table holding the entry
+ * @param[in] entry the entry to be checked
+ * @param[in] now   the current time
+ *
+ * @return true if the entry expired and was removed
+ */
+static bool fib_check_lifetime(fib_table_t *table, fib_entry_t *entry,
+                               uint64_t now)
+{
+    if ((entry->lifetime != 0) && (entry->lifetime != FIB_LIFETIME_NO_EXPIRE)
+        && (entry->lifetime < now)) {
+        fib_remove(table, entry);
+        return true;
+    }
+    return false;
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
+ * Walks the trie of the table along @p dst, so only entries covering @p dst
+ * are visited. Expired entries on the way are removed.
+ *
  * @param[in] table                the FIB table to search in
  * @param[in] dst                  the destination address
  * @param[in] dst_size             the destination address size
@@ -81,12 +395,9 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
     uint64_t now = xtimer_now64();
-
-    size_t count = 0;
-    size_t prefix_size = 0;
-    size_t match_size = dst_size << 3;
-    int ret = -EHOSTUNREACH;
-    bool is_all_zeros_addr = true;
+    unsigned bits = dst_size << 3;
+    fib_entry_t *best;
+    bool expired;
 
 #if ENABLE_DEBUG
     DEBUG("[fib_find_entry] dst =");
@@ -96,96 +407,55 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
-    for (size_t i = 0; i < dst_size; ++i) {
-        if (dst[i] != 0) {
-            is_all_zeros_addr = false;
-            break;
-        }
-    }
+    do {
+        fib_trie_node_t *node = table->trie;
+        unsigned matched = 0;
 
-    for (size_t i = 0; i < table->size; ++i) {
+        best = NULL;
+        expired = false;
 
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
-
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
+        while ((node != NULL) && (node->len <= bits) && !expired) {
+            matched = fib_trie_common(dst, fib_trie_key(node), matched, node->len);
+            if (matched < node->len) {
+                /* no entry below covers dst */
+                break;
+            }
+            for (fib_trie_node_t *dup = node; (node->type != FIB_TRIE_GLUE) &&
+                 (dup != NULL); dup = dup->dup) {
+                fib_entry_t *entry = fib_trie_entry(dup);
 
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
+                if (entry->global->address_size != dst_size) {
+                    continue;
                 }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
+                if (fib_check_lifetime(table, entry, now)) {
+                    /* the trie changed, start over */
+                    expired = true;
+                    break;
                 }
-            }
-        }
-
-        if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
-
-            int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
-            /* If we found an exact match */
-            if ((ret_comp == UNIVERSAL_ADDRESS_EQUAL)
-                || (is_all_zeros_addr && (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS))) {
-                entry_arr[0] = &(table->data.entries[i]);
-                *entry_arr_size = 1;
-                /* we will not find a better one so we return */
-                return 1;
-            }
-            else {
-                /* we try to find the most fitting prefix */
-                if (ret_comp == UNIVERSAL_ADDRESS_MATCHING_PREFIX) {
-                    if (table->data.entries[i].global_flags & FIB_FLAG_NET_PREFIX_MASK) {
-                        /* we shift the most upper flag byte back to get the number of prefix bits */
-                        size_t global_prefix_len = (table->data.entries[i].global_flags
-                                                    & FIB_FLAG_NET_PREFIX_MASK) >> FIB_FLAG_NET_PREFIX_SHIFT;
-
-                        if ((match_size >= global_prefix_len) &&
-                            ((prefix_size == 0) || (match_size > prefix_size))) {
-                            entry_arr[0] = &(table->data.entries[i]);
-                            /* we could find a better one so we move on */
-                            ret = 0;
-
-                            prefix_size = match_size;
-                            count = 1;
-                        }
-                    }
-                 }
-                 else if (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS) {
-                    /* we found the default gateway entry, e.g. ::/0 for IPv6
-                     * and we keep it only if there is no better one
-                     */
-                    if (prefix_size == 0) {
-                        entry_arr[0] = &(table->data.entries[i]);
-                        /* we could find a better one so we move on */
-                        ret = 0;
-                        count = 1;
-                    }
+                if (memcmp(entry->global->address, dst, dst_size) == 0) {
+                    /* we will not find a better one so we return */
+                    entry_arr[0] = entry;
+                    *entry_arr_size = 1;
+                    return 1;
                 }
-                match_size = dst_size<<3;
+                best = entry;
             }
+            if (node->len == bits) {
+                break;
+            }
+            node = node->child[fib_trie_bit(dst, node->len)];
         }
-    }
+    } while (expired);
 
-#if ENABLE_DEBUG
-    if (count > 0) {
-        DEBUG("[fib_find_entry] found prefix on interface %d:", entry_arr[0]->iface_id);
-        for (size_t i = 0; i < entry_arr[0]->global->address_size; i++) {
-            DEBUG(" %02x", entry_arr[0]->global->address[i]);
-        }
-        DEBUG("\n");
+    if (best == NULL) {
+        *entry_arr_size = 0;
+        return -EHOSTUNREACH;
     }
-#endif
 
-    *entry_arr_size = count;
-    return ret;
+    DEBUG("[fib_find_entry] found prefix on interface %d\n", best->iface_id);
+    entry_arr[0] = best;
+    *entry_arr_size = 1;
+    return 0;
 }
 
 /**
@@ -245,7 +515,12 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                             uint8_t *next_hop, size_t next_hop_size, uint32_t
                             next_hop_flags, uint32_t lifetime)
 {
+    uint64_t now = xtimer_now64();
+
     for (size_t i = 0; i < table->size; ++i) {
+        /* expired entries are only removed when looked up, recycle them */
+        fib_check_lifetime(table, &table->data.entries[i], now);
+
         if (table->data.entries[i].lifetime == 0) {
 
             table->data.entries[i].global = universal_address_add(dst, dst_size);
@@ -254,6 +529,13 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                 table->data.entries[i].global_flags = dst_flags;
                 table->data.entries[i].next_hop = universal_address_add(next_hop, next_hop_size);
                 table->data.entries[i].next_hop_flags = next_hop_flags;
+
+                if (table->data.entries[i].next_hop == NULL) {
+                    /* the entry is not in the trie yet */
+                    universal_address_rem(table->data.entries[i].global);
+                    table->data.entries[i].global = NULL;
+                    return -ENOMEM;
+                }
             }
 
             if (table->data.entries[i].next_hop != NULL) {
@@ -267,6 +549,7 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+                fib_trie_insert(table, &table->data.entries[i]);
                 return 0;
             }
         }
@@ -275,34 +558,6 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
     return -ENOMEM;
 }
 
-/**
- * @brief removes the given entry
- *
- * @param[in] entry the entry to be removed
- *
- * @return 0 on success
- */
-static int fib_remove(fib_entry_t *entry)
-{
-    if (entry->global != NULL) {
-        universal_address_rem(entry->global);
-    }
-
-    if (entry->next_hop) {
-        universal_address_rem(entry->next_hop);
-    }
-
-    entry->global = NULL;
-    entry->global_flags = 0;
-    entry->next_hop = NULL;
-    entry->next_hop_flags = 0;
-
-    entry->iface_id = KERNEL_PID_UNDEF;
-    entry->lifetime = 0;
-
-    return 0;
-}
-
 /**
  * @brief signals (sends a message to) all registered routing protocols
  *        registered with a matching prefix (usually this should be only one).
@@ -456,7 +711,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -476,7 +731,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -545,8 +800,10 @@ int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
     mutex_lock(&(table->mtx_access));
     int ret = -EHOSTUNREACH;
     size_t found_entries = 0;
+    uint64_t now = xtimer_now64();
 
     for (size_t i = 0; i < table->size; ++i) {
+        fib_check_lifetime(table, &table->data.entries[i], now);
         if ((table->data.entries[i].global != NULL) &&
             (universal_address_compare_prefix(table->data.entries[i].global, prefix, prefix_size<<3) >= UNIVERSAL_ADDRESS_EQUAL)) {
             if( (dst_set != NULL) && (found_entries < *dst_set_size) ) {
@@ -595,6 +852,7 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        fib_trie_init(table);
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -620,6 +878,7 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        fib_trie_init(table);
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
@@ -655,8 +914,10 @@ int fib_get_num_used_entries(fib_table_t *table)
 {
     mutex_lock(&(table->mtx_access));
     size_t used_entries = 0;
+    uint64_t now = xtimer_now64();
 
     for (size_t i = 0; i < table->size; ++i) {
+        fib_check_lifetime(table, &table->data.entries[i], now);
         used_entries += (size_t)(table->data.entries[i].global != NULL);
     }
 
@@ -737,7 +998,8 @@ static int fib_sr_new_entry(fib_table_t *table, uint8_t *addr, size_t addr_size,
                 return -ENOMEM;
             }
             else {
-                (void)new_entry;
+                /* the entry may have been used in another route before */
+                table->data.source_routes->entry_pool[i].next = NULL;
                 *new_entry = &table->data.source_routes->entry_pool[i];
                 return 0;
             }
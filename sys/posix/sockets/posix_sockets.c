@@ -785,6 +785,24 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
     switch (s->type) {
 #ifdef MODULE_CONN_UDP
         case SOCK_DGRAM:
+#ifdef MODULE_GNRC_CONN_UDP
+        {
+            void *data, *buf_ctx;
+
+            if ((res = conn_udp_recv_buf(&s->conn.udp, &data, &buf_ctx, CONN_UDP_NO_TIMEOUT,
+                                         addr, &addr_len, port)) < 0) {
+                errno = -res;
+                return -1;
+            }
+            /* excess bytes of a datagram are discarded */
+            if ((size_t)res > length) {
+                res = length;
+            }
+            memcpy(buffer, data, res);
+            conn_udp_recv_buf_release(&s->conn.udp, buf_ctx);
+            break;
+        }
+#else
             if ((res = conn_udp_recvfrom(&s->conn.udp, buffer, length, addr,
                                          &addr_len, port)) < 0) {
                 errno = -res;
@@ -792,6 +810,7 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
             }
             break;
 #endif
+#endif
 #ifdef MODULE_CONN_IP
         case SOCK_RAW:
             if ((res = conn_ip_recvfrom(&s->conn.raw, buffer, length, addr, &addr_len)) < 0) {
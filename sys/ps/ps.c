@@ -16,15 +16,15 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
+#include "bitfield.h"
+#include "irq.h"
 #include "thread.h"
 #include "sched.h"
 #include "thread.h"
 #include "kernel_types.h"
-
-#ifdef MODULE_SCHEDSTATISTICS
-#include "xtimer.h"
-#endif
+#include "ps.h"
 
 /* list of states copied from tcb.h */
 const char *state_names[] = {
@@ -35,9 +35,76 @@ const char *state_names[] = {
     [STATUS_MUTEX_BLOCKED] = "bl mutex",
     [STATUS_RECEIVE_BLOCKED] = "bl rx",
     [STATUS_SEND_BLOCKED] = "bl send",
-    [STATUS_REPLY_BLOCKED] = "bl reply"
+    [STATUS_REPLY_BLOCKED] = "bl reply",
+    [STATUS_MBOX_BLOCKED] = "bl mbox"
 };
 
+#ifdef MODULE_SCHEDSTATISTICS
+/* snapshot shared by ps() and ps_dump(), neither of them is reentrant */
+static schedstat _stats[KERNEL_PID_LAST + 1];
+static BITFIELD(_present, KERNEL_PID_LAST + 1);
+
+/* maps the thread status to the stable values of the dump format */
+static const uint8_t _dump_status[] = {
+    [STATUS_STOPPED] = PS_DUMP_STATUS_STOPPED,
+    [STATUS_SLEEPING] = PS_DUMP_STATUS_SLEEPING,
+    [STATUS_MUTEX_BLOCKED] = PS_DUMP_STATUS_MUTEX_BLOCKED,
+    [STATUS_RECEIVE_BLOCKED] = PS_DUMP_STATUS_RECEIVE_BLOCKED,
+    [STATUS_SEND_BLOCKED] = PS_DUMP_STATUS_SEND_BLOCKED,
+    [STATUS_REPLY_BLOCKED] = PS_DUMP_STATUS_REPLY_BLOCKED,
+    [STATUS_FLAG_BLOCKED_ANY] = PS_DUMP_STATUS_FLAG_BLOCKED_ANY,
+    [STATUS_FLAG_BLOCKED_ALL] = PS_DUMP_STATUS_FLAG_BLOCKED_ALL,
+    [STATUS_MBOX_BLOCKED] = PS_DUMP_STATUS_MBOX_BLOCKED,
+    [STATUS_RUNNING] = PS_DUMP_STATUS_RUNNING,
+    [STATUS_PENDING] = PS_DUMP_STATUS_PENDING,
+};
+
+/**
+ * @brief   Takes a consistent snapshot of the statistics of all threads
+ *
+ * The slice of the currently running thread is added to its runtime, the
+ * threads that exist at the time of the snapshot are marked in _present.
+ *
+ * @return  the sum of the runtime of all threads
+ */
+static uint64_t _snapshot(uint64_t *now, unsigned *numof)
+{
+    uint64_t total = 0;
+    unsigned state = irq_disable();
+
+    *now = schedstat_clock();
+    memcpy(_stats, sched_pidlist, sizeof(sched_pidlist));
+    memset(_present, 0, sizeof(_present));
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (sched_threads[i] != NULL) {
+            bf_set(_present, i);
+        }
+    }
+    if (sched_active_thread && _stats[sched_active_pid].laststart) {
+        _stats[sched_active_pid].runtime_ticks +=
+            *now - _stats[sched_active_pid].laststart;
+    }
+    irq_restore(state);
+
+    *numof = 0;
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        total += _stats[i].runtime_ticks;
+        *numof += bf_isset(_present, i);
+    }
+
+    return total;
+}
+
+static inline unsigned long _ticks_to_us(uint64_t ticks)
+{
+    /* convert whole seconds and the rest separately, ticks * 1000000 may
+     * overflow */
+    return (unsigned long)(((ticks / SCHEDSTAT_CLOCK_HZ) * 1000000LLU) +
+                           (((ticks % SCHEDSTAT_CLOCK_HZ) * 1000000LLU) /
+                            SCHEDSTAT_CLOCK_HZ));
+}
+#endif
+
 /**
  * @brief Prints a list of running threads including stack usage to stdout.
  */
@@ -47,6 +114,11 @@ void ps(void)
 #ifdef DEVELHELP
     int overall_stacksz = 0, overall_used = 0;
 #endif
+#ifdef MODULE_SCHEDSTATISTICS
+    uint64_t now;
+    unsigned numof;
+    uint64_t total = _snapshot(&now, &numof);
+#endif
 
     printf("\tpid | "
 #ifdef DEVELHELP
@@ -57,7 +129,7 @@ void ps(void)
            "| stack ( used) | location   "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-           "| runtime | switches"
+           "| runtime | switches (  vol/invol) | irq off us | max lat us"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -79,8 +151,8 @@ void ps(void)
             overall_used += stacksz;
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-            double runtime_ticks =  sched_pidlist[i].runtime_ticks / (double) xtimer_now() * 100;
-            int switches = sched_pidlist[i].schedules;
+            schedstat *st = &_stats[i];
+            double runtime = (total) ? (st->runtime_ticks * 100.0) / total : 0;
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -91,7 +163,7 @@ void ps(void)
                    " | %5i (%5i) | %p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   " | %6.3f%% |  %8d"
+                   " | %6.3f%% | %8u (%5u/%5u) | %10lu | %10lu"
 #endif
                    "\n",
                    p->pid,
@@ -103,7 +175,8 @@ void ps(void)
                    , p->stack_size, stacksz, (void *)p->stack_start
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   , runtime_ticks, switches
+                   , runtime, st->schedules, st->voluntary, st->involuntary,
+                   _ticks_to_us(st->irq_off_ticks), _ticks_to_us(st->max_latency)
 #endif
                   );
         }
@@ -114,3 +187,43 @@ void ps(void)
            overall_stacksz, overall_used);
 #endif
 }
+
+#ifdef MODULE_SCHEDSTATISTICS
+void ps_dump(ps_dump_cb_t cb, void *arg)
+{
+    ps_dump_hdr_t hdr;
+    ps_dump_rec_t rec;
+    uint64_t now;
+    unsigned numof;
+
+    _snapshot(&now, &numof);
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = PS_DUMP_MAGIC;
+    hdr.version = PS_DUMP_VERSION;
+    hdr.numof = numof;
+    hdr.clock_hz = SCHEDSTAT_CLOCK_HZ;
+    hdr.now = now;
+    cb(&hdr, sizeof(hdr), arg);
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        if (!bf_isset(_present, i)) {
+            continue;
+        }
+        /* the thread may have exited since the snapshot */
+        thread_t *p = (thread_t *)sched_threads[i];
+
+        memset(&rec, 0, sizeof(rec));
+        rec.runtime = _stats[i].runtime_ticks;
+        rec.irq_off = _stats[i].irq_off_ticks;
+        rec.schedules = _stats[i].schedules;
+        rec.voluntary = _stats[i].voluntary;
+        rec.involuntary = _stats[i].involuntary;
+        rec.max_latency = _stats[i].max_latency;
+        rec.pid = i;
+        rec.status = (p != NULL) ? _dump_status[p->status] : PS_DUMP_STATUS_STOPPED;
+        rec.priority = (p != NULL) ? p->priority : 0;
+        cb(&rec, sizeof(rec), arg);
+    }
+}
+#endif
@@ -97,6 +97,12 @@ static int _netif_stats(kernel_pid_t dev, bool reset)
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
                (unsigned) stats->tx_failed);
+#ifdef MODULE_GNRC_NETDEV2_TXQ
+        printf("           TX queue length %u (max: %u)  dropped %u\n",
+               (unsigned) stats->tx_queue_len,
+               (unsigned) stats->tx_queue_max,
+               (unsigned) stats->tx_queue_drops);
+#endif
     }
     return res;
 }
@@ -18,12 +18,46 @@
  * @}
  */
 
+#include <stdio.h>
+#include <string.h>
+
 #include "ps.h"
+#include "sched.h"
+
+#ifdef MODULE_SCHEDSTATISTICS
+static void _print_hex(const void *data, size_t len, void *arg)
+{
+    const uint8_t *bytes = data;
+    size_t *col = arg;
+
+    for (size_t i = 0; i < len; i++) {
+        printf("%02x", bytes[i]);
+        if ((++(*col) % 32) == 0) {
+            puts("");
+        }
+    }
+}
+
+static void _dump(void)
+{
+    size_t col = 0;
+
+    ps_dump(_print_hex, &col);
+    puts("");
+}
+#endif
 
 int _ps_handler(int argc, char **argv)
 {
+#ifdef MODULE_SCHEDSTATISTICS
+    if ((argc > 1) && (strcmp(argv[1], "-b") == 0)) {
+        _dump();
+        return 0;
+    }
+#else
     (void) argc;
     (void) argv;
+#endif
 
     ps();
 
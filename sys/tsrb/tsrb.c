@@ -17,22 +17,41 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
+/**
+ * @brief   Keeps the compiler from moving buffer accesses across updates of
+ *          the read and write counters
+ */
+static inline void _barrier(void)
+{
+    __asm__ volatile ("" : : : "memory");
+}
+
 static void _push(tsrb_t *rb, char c)
 {
-    rb->buf[rb->writes++ & (rb->size - 1)] = c;
+    rb->buf[rb->writes & (rb->size - 1)] = c;
+    _barrier();
+    rb->writes++;
 }
 
 static char _pop(tsrb_t *rb)
 {
-    return rb->buf[rb->reads++ & (rb->size - 1)];
+    char c;
+
+    _barrier();
+    c = rb->buf[rb->reads & (rb->size - 1)];
+    _barrier();
+    rb->reads++;
+    return c;
 }
 
 int tsrb_get_one(tsrb_t *rb)
 {
     if (!tsrb_empty(rb)) {
-        return _pop(rb);
+        return (unsigned char)_pop(rb);
     }
     else {
         return -1;
@@ -41,12 +60,25 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    char *src;
+    size_t len, res = 0;
+
+    /* the used space wraps around at most once */
+    for (int i = 0; (i < 2) && (n > 0); i++) {
+        len = tsrb_get_reserve(rb, &src);
+        if (len == 0) {
+            break;
+        }
+        if (len > n) {
+            len = n;
+        }
+        memcpy(dst, src, len);
+        tsrb_get_commit(rb, len);
+        dst += len;
+        n -= len;
+        res += len;
     }
-    return (n - tmp);
+    return res;
 }
 
 int tsrb_add_one(tsrb_t *rb, char c)
@@ -62,10 +94,62 @@ int tsrb_add_one(tsrb_t *rb, char c)
 
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    char *dst;
+    size_t len, res = 0;
+
+    /* the free space wraps around at most once */
+    for (int i = 0; (i < 2) && (n > 0); i++) {
+        len = tsrb_add_reserve(rb, &dst);
+        if (len == 0) {
+            break;
+        }
+        if (len > n) {
+            len = n;
+        }
+        memcpy(dst, src, len);
+        tsrb_add_commit(rb, len);
+        src += len;
+        n -= len;
+        res += len;
     }
-    return (n - tmp);
+    return res;
+}
+
+size_t tsrb_add_reserve(tsrb_t *rb, char **ptr)
+{
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t len = tsrb_free(rb);
+
+    if (len > (rb->size - pos)) {
+        len = rb->size - pos;
+    }
+    *ptr = &rb->buf[pos];
+    return len;
+}
+
+void tsrb_add_commit(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_free(rb));
+    _barrier();
+    rb->writes += n;
+}
+
+size_t tsrb_get_reserve(tsrb_t *rb, char **ptr)
+{
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t len = tsrb_avail(rb);
+
+    if (len > (rb->size - pos)) {
+        len = rb->size - pos;
+    }
+    _barrier();
+    *ptr = &rb->buf[pos];
+    return len;
+}
+
+void tsrb_get_commit(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_avail(rb));
+    _barrier();
+    rb->reads += n;
 }
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_uart_escape
+ * @{
+ *
+ * @file
+ * @brief       UART byte stuffing implementation
+ *
+ * @}
+ */
+
+#include "uart_escape.h"
+
+void uart_escape_write(uart_t uart, const uart_escape_t *escape,
+                       const uint8_t *data, size_t len)
+{
+    const uint8_t *start = data;
+    uint8_t out[2] = { escape->esc, 0 };
+
+    /* write everything between two escaped bytes with a single uart_write() */
+    while (len--) {
+        if (*data == escape->delim) {
+            out[1] = escape->delim_esc;
+        }
+        else if (*data == escape->esc) {
+            out[1] = escape->esc_esc;
+        }
+        else {
+            data++;
+            continue;
+        }
+        if (data > start) {
+            uart_write(uart, start, data - start);
+        }
+        uart_write(uart, out, sizeof(out));
+        start = ++data;
+    }
+    if (data > start) {
+        uart_write(uart, start, data - start);
+    }
+}
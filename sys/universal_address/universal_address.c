@@ -46,6 +46,25 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+#ifndef UNIVERSAL_ADDRESS_HASH_SIZE
+/**
+ * @brief Number of hash buckets indexing the entries
+ */
+#   if UNIVERSAL_ADDRESS_MAX_ENTRIES > 0
+#       define UNIVERSAL_ADDRESS_HASH_SIZE  (UNIVERSAL_ADDRESS_MAX_ENTRIES)
+#   else
+#       define UNIVERSAL_ADDRESS_HASH_SIZE  (1)
+#   endif
+#endif
+
+#if UNIVERSAL_ADDRESS_HASH_SIZE < 1
+#   error "universal_address: UNIVERSAL_ADDRESS_HASH_SIZE must be at least 1"
+#endif
+
+#if UNIVERSAL_ADDRESS_MAX_ENTRIES >= UINT16_MAX
+#   error "universal_address: UNIVERSAL_ADDRESS_MAX_ENTRIES too large"
+#endif
+
 /**
  * @brief counter indicating the number of entries allocated
  */
@@ -56,11 +75,53 @@ static size_t universal_address_table_filled = 0;
  */
 static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
 
+/**
+ * @brief Links of the entries in use in a hash bucket, or of the unused
+ *        entries in universal_address_free.
+ *
+ *  All links store the index in universal_address_table + 1, so 0 ends a
+ *  list and the zero-initialized state is an empty table.
+ */
+static uint16_t universal_address_next[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+/**
+ * @brief The first entry in use of each hash bucket
+ */
+static uint16_t universal_address_buckets[UNIVERSAL_ADDRESS_HASH_SIZE];
+
+/**
+ * @brief The released entries
+ */
+static uint16_t universal_address_free = 0;
+
+/**
+ * @brief The number of entries used at least once since initialization
+ */
+static uint16_t universal_address_fresh = 0;
+
 /**
  * @brief access mutex to control exclusive operations on calls
+ *
+ * The content of a container does not change while it is in use, so only
+ * adding and removing entries need the mutex.
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+/**
+ * @brief returns the hash bucket of the given address
+ */
+static uint16_t *universal_address_bucket(uint8_t *addr, size_t addr_size)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U ^ addr_size;
+
+    for (size_t i = 0; i < addr_size; ++i) {
+        hash = (hash ^ addr[i]) * 16777619U;
+    }
+
+    return &universal_address_buckets[hash % UNIVERSAL_ADDRESS_HASH_SIZE];
+}
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,12 +133,16 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        if (universal_address_table[i].address_size == addr_size) {
-            if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
-                return &(universal_address_table[i]);
-            }
+    uint16_t link = *universal_address_bucket(addr, addr_size);
+
+    while (link != 0) {
+        universal_address_container_t *entry = &universal_address_table[link - 1];
+
+        if ((entry->address_size == addr_size) &&
+            (memcmp(entry->address, addr, addr_size) == 0)) {
+            return entry;
         }
+        link = universal_address_next[link - 1];
     }
 
     return NULL;
@@ -91,12 +156,14 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
  */
 static universal_address_container_t *universal_address_get_next_unused_entry(void)
 {
-    if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
-        for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-            if (universal_address_table[i].use_count == 0) {
-                return &(universal_address_table[i]);
-            }
-        }
+    if (universal_address_free != 0) {
+        universal_address_container_t *entry = &universal_address_table[universal_address_free - 1];
+        universal_address_free = universal_address_next[universal_address_free - 1];
+        return entry;
+    }
+
+    if (universal_address_fresh < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
+        return &universal_address_table[universal_address_fresh++];
     }
 
     return NULL;
@@ -117,18 +184,24 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
-        /* look if the former memory has distinct size */
-        if (pEntry->address_size != addr_size) {
-            /* clean the address */
-            memset(pEntry->address, 0, UNIVERSAL_ADDRESS_SIZE);
+        /* clean the address */
+        memset(pEntry->address, 0, UNIVERSAL_ADDRESS_SIZE);
 
-            /* set the used bytes */
-            pEntry->address_size = addr_size;
-            pEntry->use_count = 0;
-        }
+        /* set the used bytes */
+        pEntry->address_size = addr_size;
+        pEntry->use_count = 0;
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+
+        /* and make it findable */
+        uint16_t *bucket = universal_address_bucket(addr, addr_size);
+        universal_address_next[pEntry - universal_address_table] = *bucket;
+        *bucket = (pEntry - universal_address_table) + 1;
+    }
+    else if (pEntry->use_count == UINT16_MAX) {
+        mutex_unlock(&mtx_access);
+        return NULL;
     }
 
     pEntry->use_count++;
@@ -154,6 +227,18 @@ void universal_address_rem(universal_address_container_t *entry)
             entry->use_count--;
 
             if (entry->use_count == 0) {
+                uint16_t link = (entry - universal_address_table) + 1;
+                uint16_t *prev = universal_address_bucket(entry->address,
+                                                          entry->address_size);
+
+                /* unlink from the bucket and put to the released entries */
+                while (*prev != link) {
+                    prev = &universal_address_next[*prev - 1];
+                }
+                *prev = universal_address_next[link - 1];
+                universal_address_next[link - 1] = universal_address_free;
+                universal_address_free = link;
+
                 universal_address_table_filled--;
             }
         }
@@ -169,30 +254,23 @@ void universal_address_rem(universal_address_container_t *entry)
 uint8_t* universal_address_get_address(universal_address_container_t *entry,
                                   uint8_t *addr, size_t *addr_size)
 {
-    mutex_lock(&mtx_access);
-
     if (*addr_size >= entry->address_size) {
         memcpy(addr, entry->address, entry->address_size);
         *addr_size = entry->address_size;
-        mutex_unlock(&mtx_access);
         return addr;
     }
 
     *addr_size = entry->address_size;
-    mutex_unlock(&mtx_access);
     return NULL;
 }
 
 int universal_address_compare(universal_address_container_t *entry,
                               uint8_t *addr, size_t *addr_size_in_bits)
 {
-    mutex_lock(&mtx_access);
-
     int ret = -ENOENT;
 
     /* If we have distinct sizes, the addresses are probably not comperable */
     if ((size_t)(entry->address_size<<3) != *addr_size_in_bits) {
-        mutex_unlock(&mtx_access);
         return ret;
     }
 
@@ -214,13 +292,11 @@ int universal_address_compare(universal_address_container_t *entry,
     /* if the address is all 0 its a default route address */
     if (test_all_zeros) {
         *addr_size_in_bits = 0;
-        mutex_unlock(&mtx_access);
         return UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS;
     }
 
     /* if we have no distinct bytes the addresses are equal */
     if (idx == -1) {
-        mutex_unlock(&mtx_access);
         return UNIVERSAL_ADDRESS_EQUAL;
     }
 
@@ -237,18 +313,15 @@ int universal_address_compare(universal_address_container_t *entry,
     *addr_size_in_bits = (idx << 3) + j;
     ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
 
-    mutex_unlock(&mtx_access);
     return ret;
 }
 
 int universal_address_compare_prefix(universal_address_container_t *entry,
                               uint8_t *prefix, size_t prefix_size_in_bits)
 {
-    mutex_lock(&mtx_access);
     int ret = -ENOENT;
     /* If we have distinct sizes, the prefix is not comperable */
     if ((size_t)(entry->address_size<<3) != prefix_size_in_bits) {
-        mutex_unlock(&mtx_access);
         return ret;
     }
 
@@ -286,14 +359,26 @@ int universal_address_compare_prefix(universal_address_container_t *entry,
         }
     }
 
-    mutex_unlock(&mtx_access);
     return ret;
 }
 
+/**
+ * @brief marks all entries as unused, the mutex must be held
+ */
+static void universal_address_clear(void)
+{
+    memset(universal_address_buckets, 0, sizeof(universal_address_buckets));
+    universal_address_free = 0;
+    universal_address_fresh = 0;
+    universal_address_table_filled = 0;
+}
+
 void universal_address_init(void)
 {
     mutex_lock(&mtx_access);
 
+    universal_address_clear();
+
     for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
         universal_address_table[i].use_count = 0;
         universal_address_table[i].address_size = 0;
@@ -311,14 +396,12 @@ void universal_address_reset(void)
         universal_address_table[i].use_count = 0;
     }
 
-    universal_address_table_filled = 0;
+    universal_address_clear();
     mutex_unlock(&mtx_access);
 }
 
 void universal_address_print_entry(universal_address_container_t *entry)
 {
-    mutex_lock(&mtx_access);
-
     if (entry != NULL) {
         printf("[universal_address_print_entry] entry@: %p, use_count: %d, \
 address_size: %d, content: ", \
@@ -331,16 +414,11 @@ address_size: %d, content: ", \
 
         puts("");
     }
-
-    mutex_unlock(&mtx_access);
 }
 
 int universal_address_get_num_used_entries(void)
 {
-    mutex_lock(&mtx_access);
-    size_t ret = universal_address_table_filled;
-    mutex_unlock(&mtx_access);
-    return ret;
+    return universal_address_table_filled;
 }
 
 void universal_address_print_table(void)
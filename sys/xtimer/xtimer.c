@@ -59,6 +59,7 @@ void xtimer_usleep_until(uint32_t *last_wakeup, uint32_t interval) {
 
     timer.callback = _callback_unlock_mutex;
     timer.arg = (void*) &mutex;
+    timer.target = timer.long_target = 0;
 
     uint32_t target = *last_wakeup + interval;
 
@@ -200,3 +201,42 @@ int xtimer_msg_receive_timeout(msg_t *msg, uint32_t us)
     xtimer_set_msg(&t, us, &tmsg, sched_active_pid);
     return _msg_wait(msg, &tmsg, &t);
 }
+
+#ifdef MODULE_CORE_MBOX
+typedef struct {
+    mbox_t *mbox;
+    thread_t *thread;
+    volatile int expired;
+} _mbox_timeout_t;
+
+static void _callback_mbox_timeout(void *arg)
+{
+    _mbox_timeout_t *to = (_mbox_timeout_t *) arg;
+
+    /* a thread that isn't waiting yet sees the flag before it blocks */
+    to->expired = 1;
+    mbox_abort_get(to->mbox, to->thread);
+}
+
+int xtimer_mbox_get_timeout(mbox_t *mbox, msg_t *msg, uint32_t us)
+{
+    if (mbox_try_get(mbox, msg)) {
+        return 1;
+    }
+
+    _mbox_timeout_t to = {
+        .mbox = mbox,
+        .thread = (thread_t *) sched_active_thread,
+        .expired = 0,
+    };
+    xtimer_t t;
+    t.target = t.long_target = 0;
+    t.callback = _callback_mbox_timeout;
+    t.arg = (void *) &to;
+    xtimer_set(&t, us);
+
+    int res = mbox_get_abortable(mbox, msg, &to.expired);
+    xtimer_remove(&t);
+    return res ? 1 : -1;
+}
+#endif
@@ -0,0 +1,572 @@
+/**
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup xtimer
+ * @{
+ * @file
+ * @brief xtimer core functionality, hierarchical timing wheel backend
+ *
+ * Timers are hashed into one of XTIMER_WHEEL_LEVELS levels of
+ * XTIMER_WHEEL_SLOTS unsorted, doubly linked buckets. Level 0 buckets span
+ * one wheel tick each, every following level spans XTIMER_WHEEL_SLOTS ticks
+ * of the level below. Whenever the wheel's cursor crosses a bucket boundary
+ * of a higher level, that bucket is cascaded into the lower levels. Timers of
+ * the tick the cursor is currently in are kept in a short sorted list, from
+ * which they are fired with full precision.
+ *
+ * The low-level timer is only programmed for the next point in time at which
+ * something happens: the first timer of the sorted list, the next non-empty
+ * bucket or the end of the current low-level timer period.
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "bitarithm.h"
+#include "xtimer.h"
+#include "irq.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if XTIMER_WHEEL_BITS > 5
+#error "XTIMER_WHEEL_BITS must not exceed 5"
+#endif
+
+#define XTIMER_WHEEL_SLOTS  (1U << XTIMER_WHEEL_BITS)
+#define XTIMER_WHEEL_MASK   (XTIMER_WHEEL_SLOTS - 1)
+#define XTIMER_WHEEL_RANGE  (1ULL << (XTIMER_WHEEL_BITS * XTIMER_WHEEL_LEVELS))
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+#if XTIMER_MASK
+volatile uint32_t _high_cnt = 0;
+#endif
+
+/* low-level timer value seen last, used to detect period overflows */
+static uint32_t _ll_last = 0;
+/* absolute time the low-level timer is currently programmed for */
+static uint64_t _armed = 0;
+
+/* timers expiring within the current wheel tick, sorted by target */
+static xtimer_t *_near_head = NULL;
+/* current position of the wheel in wheel ticks */
+static uint64_t _wheel_tick = 0;
+static xtimer_t *_wheel[XTIMER_WHEEL_LEVELS][XTIMER_WHEEL_SLOTS];
+/* hints which buckets are non-empty, cleared lazily */
+static uint32_t _wheel_map[XTIMER_WHEEL_LEVELS];
+
+static void _insert(xtimer_t *timer);
+static void _remove(xtimer_t *timer);
+static void _reschedule(void);
+static void _shoot(xtimer_t *timer);
+static inline void _lltimer_set(uint32_t target);
+
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target);
+}
+
+static inline uint64_t _target64(xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline uint64_t _now64(void)
+{
+    return ((uint64_t)_long_cnt << 32) | xtimer_now();
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER, XTIMER_USEC_TO_TICKS(1000000ul), _periph_timer_callback, NULL);
+
+    /* register initial overflow tick */
+    _armed = _lltimer_mask(0xFFFFFFFF);
+    _lltimer_set(0xFFFFFFFF);
+}
+
+static void _xtimer_now64(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t before, after, long_value;
+
+    /* loop to cope with possible overflow of xtimer_now() */
+    do {
+        before = xtimer_now();
+        long_value = _long_cnt;
+        after = xtimer_now();
+
+    } while(before > after);
+
+    *short_term = after;
+    *long_term = long_value;
+}
+
+uint64_t xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+    _xtimer_now64(&short_term, &long_term);
+
+    return ((uint64_t)long_term<<32) + short_term;
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    if (!long_offset) {
+        /* timer fits into the short timer */
+        xtimer_set(timer, (uint32_t) offset);
+    }
+    else {
+        int state = irq_disable();
+        if (_is_set(timer)) {
+            _remove(timer);
+        }
+
+        _xtimer_now64(&timer->target, &timer->long_target);
+        timer->target += offset;
+        timer->long_target += long_offset;
+        if (timer->target < offset) {
+            timer->long_target++;
+        }
+
+        _insert(timer);
+        _reschedule();
+        irq_restore(state);
+        DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
+                timer->long_target, timer->target);
+    }
+}
+
+void xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n", offset, xtimer_now(), _lltimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (offset < XTIMER_BACKOFF) {
+        xtimer_spin(offset);
+        _shoot(timer);
+    }
+    else {
+        uint32_t target = xtimer_now() + offset;
+        _xtimer_set_absolute(timer, target);
+    }
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+static void _shoot(xtimer_t *timer)
+{
+    timer->callback(timer->arg);
+}
+
+static inline void _lltimer_set(uint32_t target)
+{
+    if (_in_handler) {
+        return;
+    }
+    DEBUG("_lltimer_set(): setting %" PRIu32 "\n", _lltimer_mask(target));
+#ifdef XTIMER_SHIFT
+    target = XTIMER_USEC_TO_TICKS(target);
+    if (!target) {
+        target++;
+    }
+#endif
+    timer_set_absolute(XTIMER, XTIMER_CHAN, _lltimer_mask(target));
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    uint32_t now = xtimer_now();
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
+
+    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+        /* backoff */
+        xtimer_spin_until(target + XTIMER_BACKOFF);
+        _shoot(timer);
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+
+    timer->target = target;
+    timer->long_target = _long_cnt;
+    if (target < now) {
+        timer->long_target++;
+    }
+
+    _insert(timer);
+    _reschedule();
+
+    irq_restore(state);
+
+    return 0;
+}
+
+static inline void _link(xtimer_t **list_head, xtimer_t *timer)
+{
+    timer->next = *list_head;
+    if (timer->next) {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = list_head;
+    *list_head = timer;
+}
+
+static inline void _unlink(xtimer_t *timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next) {
+        timer->next->pprev = timer->pprev;
+    }
+}
+
+/**
+ * @brief insert a timer into the sorted list of the current wheel tick
+ *
+ * This list only holds timers of one wheel tick, so it stays short.
+ */
+static void _near_insert(xtimer_t *timer)
+{
+    xtimer_t **list_head = &_near_head;
+    uint64_t target = _target64(timer);
+
+    while (*list_head && _target64(*list_head) <= target) {
+        list_head = &((*list_head)->next);
+    }
+
+    _link(list_head, timer);
+}
+
+/**
+ * @brief hash a timer into the wheel, relative to the wheel's cursor
+ */
+static void _insert(xtimer_t *timer)
+{
+    uint64_t expiry = _target64(timer) >> XTIMER_WHEEL_SHIFT;
+    uint64_t delta;
+    unsigned level = 0;
+
+    if (expiry <= _wheel_tick) {
+        _near_insert(timer);
+        return;
+    }
+
+    delta = expiry - _wheel_tick;
+    while ((level < (XTIMER_WHEEL_LEVELS - 1)) &&
+           (delta >> ((level + 1) * XTIMER_WHEEL_BITS))) {
+        level++;
+    }
+    if (delta >= XTIMER_WHEEL_RANGE) {
+        /* park in the last bucket within range, will be re-hashed from there */
+        expiry = _wheel_tick + XTIMER_WHEEL_RANGE - 1;
+    }
+
+    unsigned slot = (expiry >> (level * XTIMER_WHEEL_BITS)) & XTIMER_WHEEL_MASK;
+    _link(&_wheel[level][slot], timer);
+    _wheel_map[level] |= ((uint32_t)1 << slot);
+}
+
+static void _remove(xtimer_t *timer)
+{
+    /* the bucket's bit in _wheel_map is cleared lazily by _next_tick() */
+    _unlink(timer);
+    timer->target = 0;
+    timer->long_target = 0;
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    int state = irq_disable();
+    if (_is_set(timer)) {
+        _remove(timer);
+    }
+    irq_restore(state);
+}
+
+/**
+ * @brief bitarithm_lsb() for 32bit values on platforms with 16bit integers
+ */
+static inline unsigned _lsb32(uint32_t v)
+{
+    unsigned res = 0;
+
+    if (!(v & 0xffff)) {
+        v >>= 16;
+        res = 16;
+    }
+
+    return res + bitarithm_lsb((unsigned)(v & 0xffff));
+}
+
+/**
+ * @brief get the wheel tick at which the next non-empty bucket is due
+ *
+ * @return  UINT64_MAX if the wheel is empty
+ */
+static uint64_t _next_tick(void)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        unsigned shift = level * XTIMER_WHEEL_BITS;
+        uint64_t pos = _wheel_tick >> shift;
+        unsigned cur = pos & XTIMER_WHEEL_MASK;
+
+        while (_wheel_map[level]) {
+            /* rotate the map so bit 0 represents the bucket following cur */
+            uint64_t map = ((uint64_t)_wheel_map[level] << XTIMER_WHEEL_SLOTS) |
+                           _wheel_map[level];
+            unsigned dist = _lsb32((uint32_t)(map >> (cur + 1))) + 1;
+            unsigned slot = (cur + dist) & XTIMER_WHEEL_MASK;
+
+            if (!_wheel[level][slot]) {
+                /* stale hint left behind by _remove() */
+                _wheel_map[level] &= ~((uint32_t)1 << slot);
+                continue;
+            }
+
+            uint64_t tick = (pos + dist) << shift;
+            if (tick < next) {
+                next = tick;
+            }
+            break;
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @brief move the cursor to @p tick and process all buckets due at it
+ */
+static void _process_tick(uint64_t tick)
+{
+    _wheel_tick = tick;
+
+    /* cascade higher levels first, their timers may be due right now */
+    for (unsigned level = XTIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+        unsigned shift = level * XTIMER_WHEEL_BITS;
+        if (tick & ((1ULL << shift) - 1)) {
+            continue;
+        }
+
+        unsigned slot = (tick >> shift) & XTIMER_WHEEL_MASK;
+        xtimer_t *timer = _wheel[level][slot];
+        _wheel[level][slot] = NULL;
+        _wheel_map[level] &= ~((uint32_t)1 << slot);
+
+        while (timer) {
+            xtimer_t *next = timer->next;
+            _insert(timer);
+            timer = next;
+        }
+    }
+
+    unsigned slot = tick & XTIMER_WHEEL_MASK;
+    xtimer_t *timer = _wheel[0][slot];
+    _wheel[0][slot] = NULL;
+    _wheel_map[0] &= ~((uint32_t)1 << slot);
+
+    while (timer) {
+        xtimer_t *next = timer->next;
+        _near_insert(timer);
+        timer = next;
+    }
+}
+
+/**
+ * @brief advance the wheel's cursor to @p now_tick, skipping empty buckets
+ */
+static void _advance(uint64_t now_tick)
+{
+    while (_wheel_tick < now_tick) {
+        uint64_t next = _next_tick();
+
+        if (next > now_tick) {
+            _wheel_tick = now_tick;
+            break;
+        }
+
+        _process_tick(next);
+    }
+}
+
+/**
+ * @brief get the absolute time of the next event the wheel has to handle
+ */
+static uint64_t _next_event(void)
+{
+    uint64_t next = _next_tick();
+
+    if (next != UINT64_MAX) {
+        next <<= XTIMER_WHEEL_SHIFT;
+    }
+    if (_near_head && (_target64(_near_head) < next)) {
+        next = _target64(_near_head);
+    }
+
+    return next;
+}
+
+/**
+ * @brief program the low-level timer for @p next, at most until the end of
+ *        the current low-level timer period
+ */
+static void _arm(uint64_t next, uint64_t now)
+{
+    uint64_t period_end = now | _lltimer_mask(0xFFFFFFFF);
+
+    if (next >= period_end) {
+        next = period_end;
+    }
+    else if ((next - now) > (XTIMER_OVERHEAD + XTIMER_ISR_BACKOFF)) {
+        next -= XTIMER_OVERHEAD;
+    }
+
+    _armed = next;
+    _lltimer_set((uint32_t)next);
+}
+
+/**
+ * @brief re-program the low-level timer after a timer got added in thread
+ *        context, if that timer needs an earlier interrupt
+ */
+static void _reschedule(void)
+{
+    if (_in_handler) {
+        /* _timer_callback() will pick up the change */
+        return;
+    }
+
+    uint64_t now = _now64();
+    uint64_t next = _next_event();
+
+    if (next < (now + XTIMER_ISR_BACKOFF)) {
+        next = now + XTIMER_ISR_BACKOFF;
+    }
+    if (next < _armed) {
+        _arm(next, now);
+    }
+}
+
+/**
+ * @brief handle low-level timer overflow, advance to next short timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _high_cnt += ~XTIMER_MASK_SHIFTED + 1;
+    if (! _high_cnt) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief detect whether the low-level timer overflowed since the last call
+ */
+static void _update_period(void)
+{
+    uint32_t now = _lltimer_now();
+    int overflowed = (now < _ll_last);
+
+    if (now == _lltimer_mask(0xFFFFFFFF)) {
+        /* make sure the timer counter also arrived in the next period */
+        while (_lltimer_now() == _lltimer_mask(0xFFFFFFFF));
+        now = _lltimer_now();
+        overflowed = 1;
+    }
+    else if (!overflowed) {
+        /* A whole period may have passed since _ll_last was taken. As the
+         * low-level timer never fires early, a time way before the armed one
+         * means it overflowed in between. */
+#if XTIMER_MASK
+        uint64_t now64 = ((uint64_t)_long_cnt << 32) | _high_cnt | now;
+#else
+        uint64_t now64 = ((uint64_t)_long_cnt << 32) | now;
+#endif
+        overflowed = (_armed > now64) &&
+                     ((_armed - now64) > (_lltimer_mask(0xFFFFFFFF) >> 1));
+    }
+
+    if (overflowed) {
+        _next_period();
+    }
+    _ll_last = now;
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+    uint64_t now, next;
+
+    _in_handler = 1;
+
+    while (1) {
+        _update_period();
+        now = _now64();
+        _advance(now >> XTIMER_WHEEL_SHIFT);
+
+        xtimer_t *timer = _near_head;
+        if (timer && (_target64(timer) < (now + XTIMER_ISR_BACKOFF))) {
+            uint64_t target = _target64(timer);
+
+            /* make sure we don't fire too early */
+            if (target > now) {
+                xtimer_spin((uint32_t)(target - now));
+            }
+
+            /* make sure timer is recognized as being already fired */
+            _remove(timer);
+
+            /* fire timer */
+            _shoot(timer);
+            continue;
+        }
+
+        next = _next_event();
+        if (next >= (now + XTIMER_ISR_BACKOFF)) {
+            break;
+        }
+    }
+
+    _in_handler = 0;
+
+    /* set low level timer */
+    _arm(next, now);
+}
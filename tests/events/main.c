@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for event queues
+ *
+ * Checks posting, cancelling, timeouts and callback events, then passes
+ * packets through a stack of layers, once with a thread per layer and once
+ * with all layers sharing one event queue.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "event.h"
+#include "event/callback.h"
+#include "event/timeout.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define THREAD_FLAG_DONE    (0x2)
+
+#define TIMEOUT             (10000U)
+#define LAYER_NUMOF         (4U)
+#define PACKET_NUMOF        (1000U)
+
+static char event_stack[THREAD_STACKSIZE_DEFAULT];
+static char layer_stacks[LAYER_NUMOF][THREAD_STACKSIZE_DEFAULT];
+
+static event_queue_t queue = EVENT_QUEUE_INIT;
+static thread_t *main_thread;
+static unsigned errors;
+
+static unsigned counts[2];
+static uint32_t fired_at;
+
+static void _count(event_t *event);
+static void _fired(event_t *event);
+static void _done(event_t *event);
+
+static event_t count_events[2] = { { .handler = _count }, { .handler = _count } };
+static event_t fired_event = { .handler = _fired };
+static event_t done_event = { .handler = _done };
+
+static void _count(event_t *event)
+{
+    counts[event - count_events]++;
+}
+
+static void _fired(event_t *event)
+{
+    (void)event;
+    fired_at = xtimer_now();
+    thread_flags_set(main_thread, THREAD_FLAG_DONE);
+}
+
+static void _done(event_t *event)
+{
+    (void)event;
+    thread_flags_set(main_thread, THREAD_FLAG_DONE);
+}
+
+static void _callback(void *arg)
+{
+    (*((unsigned *) arg))++;
+    thread_flags_set(main_thread, THREAD_FLAG_DONE);
+}
+
+static void *event_thread(void *arg)
+{
+    (void)arg;
+    /* the statically initialized queue is bound to this thread here */
+    event_loop(&queue);
+    return NULL;
+}
+
+/* one layer per thread, every layer hands the packet to the next one */
+static kernel_pid_t layer_pids[LAYER_NUMOF];
+
+static void *layer_thread(void *arg)
+{
+    unsigned layer = (uintptr_t)arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+        if (layer + 1 < LAYER_NUMOF) {
+            msg_send(&m, layer_pids[layer + 1]);
+        }
+        else {
+            thread_flags_set(main_thread, THREAD_FLAG_DONE);
+        }
+    }
+    return NULL;
+}
+
+/* all layers on one event queue */
+static void _layer_handler(event_t *event);
+static event_t layer_events[LAYER_NUMOF];
+
+static void _layer_handler(event_t *event)
+{
+    unsigned layer = event - layer_events;
+
+    if (layer + 1 < LAYER_NUMOF) {
+        event_post(&queue, &layer_events[layer + 1]);
+    }
+    else {
+        thread_flags_set(main_thread, THREAD_FLAG_DONE);
+    }
+}
+
+static void _check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("failed: %s\n", what);
+        errors++;
+    }
+}
+
+int main(void)
+{
+    puts("event queue test");
+    main_thread = (thread_t *) sched_active_thread;
+
+    /* lower priority than main, so events pile up until main waits */
+    thread_create(event_stack, sizeof(event_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, event_thread, NULL, "events");
+    xtimer_usleep(TIMEOUT);
+
+    event_post(&queue, &count_events[0]);
+    event_post(&queue, &count_events[0]);
+    event_post(&queue, &count_events[1]);
+    event_cancel(&queue, &count_events[1]);
+    event_post(&queue, &done_event);
+    thread_flags_wait_any(THREAD_FLAG_DONE);
+    _check((counts[0] == 1) && (counts[1] == 0), "post and cancel");
+
+    event_timeout_t timeout;
+    event_timeout_init(&timeout, &queue, &fired_event);
+    uint32_t start = xtimer_now();
+    event_timeout_set(&timeout, TIMEOUT);
+    thread_flags_wait_any(THREAD_FLAG_DONE);
+    _check((fired_at - start) >= TIMEOUT, "timeout");
+
+    event_timeout_set(&timeout, TIMEOUT);
+    event_timeout_clear(&timeout);
+    fired_at = 0;
+    xtimer_usleep(2 * TIMEOUT);
+    _check(fired_at == 0, "cleared timeout");
+
+    unsigned calls = 0;
+    event_callback_t callback = EVENT_CALLBACK_INIT(_callback, &calls);
+    event_post(&queue, &callback.super);
+    thread_flags_wait_any(THREAD_FLAG_DONE);
+    _check(calls == 1, "callback");
+
+    /* packets through LAYER_NUMOF layers */
+    for (unsigned i = 0; i < LAYER_NUMOF; i++) {
+        layer_pids[i] = thread_create(layer_stacks[i], sizeof(layer_stacks[i]),
+                                      THREAD_PRIORITY_MAIN + 1,
+                                      THREAD_CREATE_STACKTEST, layer_thread,
+                                      (void *)(uintptr_t)i, "layer");
+        layer_events[i].handler = _layer_handler;
+    }
+
+    msg_t m;
+    start = xtimer_now();
+    for (unsigned i = 0; i < PACKET_NUMOF; i++) {
+        m.content.value = i;
+        msg_send(&m, layer_pids[0]);
+        thread_flags_wait_any(THREAD_FLAG_DONE);
+    }
+    uint32_t threads = xtimer_now() - start;
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < PACKET_NUMOF; i++) {
+        event_post(&queue, &layer_events[0]);
+        thread_flags_wait_any(THREAD_FLAG_DONE);
+    }
+    uint32_t events = xtimer_now() - start;
+
+    printf("%u packets through %u layers:\n", PACKET_NUMOF, LAYER_NUMOF);
+    printf("thread per layer: %" PRIu32 " us, %u bytes of stack\n",
+           threads, (unsigned) sizeof(layer_stacks));
+    printf("one event queue:  %" PRIu32 " us, %u bytes of stack\n",
+           events, (unsigned) sizeof(event_stack));
+
+    puts(errors ? "[FAILURE]" : "[SUCCESS]");
+    return 0;
+}
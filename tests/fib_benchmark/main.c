@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       FIB and universal address benchmark
+ *
+ * Fills a FIB with 16 to 512 host routes sharing a few next hops and times
+ * interning an address with universal_address_add() and looking up a next
+ * hop with fib_get_next_hop(). Both should stay roughly constant with the
+ * number of entries.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/fib.h"
+#include "random.h"
+#include "universal_address.h"
+
+#define MAX_ENTRIES     (512U)
+#define NEXT_HOPS       (4U)
+#define ADDR_SIZE       (16U)
+#define LOOKUPS         (10000U)
+
+static const unsigned numofs[] = { 16, 64, 256, 512 };
+
+static fib_entry_t entries[MAX_ENTRIES];
+static fib_table_t table;
+
+static void _set_addr(uint8_t *addr, uint8_t type, uint32_t id)
+{
+    memset(addr, 0, ADDR_SIZE);
+    addr[0] = 0x20;
+    addr[1] = type;
+    addr[12] = id >> 24;
+    addr[13] = id >> 16;
+    addr[14] = id >> 8;
+    addr[15] = id;
+}
+
+static unsigned _add(uint32_t id)
+{
+    uint8_t dst[ADDR_SIZE], next_hop[ADDR_SIZE];
+
+    _set_addr(dst, 0xd, id);
+    _set_addr(next_hop, 0xe, id % NEXT_HOPS);
+    return (fib_add_entry(&table, 6, dst, ADDR_SIZE, 0, next_hop, ADDR_SIZE, 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) != 0);
+}
+
+static void _intern(uint32_t id)
+{
+    uint8_t addr[ADDR_SIZE];
+
+    _set_addr(addr, 0xd, id);
+    universal_address_rem(universal_address_add(addr, ADDR_SIZE));
+}
+
+static unsigned _lookup(uint32_t id)
+{
+    uint8_t dst[ADDR_SIZE], next_hop[ADDR_SIZE];
+    kernel_pid_t iface;
+    size_t next_hop_size = sizeof(next_hop);
+    uint32_t next_hop_flags;
+
+    _set_addr(dst, 0xd, id);
+    return (fib_get_next_hop(&table, &iface, next_hop, &next_hop_size,
+                             &next_hop_flags, dst, ADDR_SIZE, 0) != 0);
+}
+
+static int _run(unsigned numof)
+{
+    unsigned failed = 0;
+
+    table.data.entries = entries;
+    table.table_type = FIB_TABLE_TYPE_SH;
+    table.size = numof;
+    mutex_init(&table.mtx_access);
+    fib_init(&table);
+
+    printf("%u entries:\n", numof);
+    BENCHMARK_FUNC("fib add", numof, failed += _add(i));
+    if (failed != 0) {
+        printf("ERROR: could not add %u entries\n", failed);
+        return 1;
+    }
+    BENCHMARK_FUNC("addr intern", LOOKUPS,
+                   _intern(random_uint32_range(0, numof)));
+    BENCHMARK_FUNC("fib lookup", LOOKUPS,
+                   failed += _lookup(random_uint32_range(0, numof)));
+    if (failed != 0) {
+        printf("ERROR: %u of %u lookups failed\n", failed, LOOKUPS);
+        return 1;
+    }
+
+    fib_deinit(&table);
+
+    return 0;
+}
+
+int main(void)
+{
+    puts("FIB benchmark");
+
+    for (unsigned i = 0; i < sizeof(numofs) / sizeof(numofs[0]); i++) {
+        if (_run(numofs[i]) != 0) {
+            puts("[FAILURE]");
+            return 1;
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
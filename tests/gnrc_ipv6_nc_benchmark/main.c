@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       IPv6 neighbor cache lookup benchmark
+ *
+ * Fills the neighbor cache with 8, 64, and 512 link-local neighbors and
+ * times gnrc_ipv6_nc_get() for cached and for unknown addresses.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "random.h"
+
+#define IFACE           (6)
+#define LOOKUPS         (100000U)
+
+static const unsigned numofs[] = { 8, 64, 512 };
+
+static ipv6_addr_t addrs[GNRC_IPV6_NC_SIZE];
+
+static void _set_addr(ipv6_addr_t *addr, uint32_t iid)
+{
+    ipv6_addr_set_link_local_prefix(addr);
+    addr->u32[2] = byteorder_htonl(0x02000000);
+    addr->u32[3] = byteorder_htonl(iid);
+}
+
+static bool _get(const ipv6_addr_t *addr)
+{
+    return (gnrc_ipv6_nc_get(IFACE, addr) != NULL);
+}
+
+static bool _get_unknown(uint32_t i)
+{
+    ipv6_addr_t unknown;
+
+    /* the upper bits never collide with a cached address */
+    _set_addr(&unknown, 0xffff0000 | i);
+    return _get(&unknown);
+}
+
+static int _run(unsigned numof)
+{
+    unsigned found = 0;
+
+    gnrc_ipv6_nc_init();
+    for (unsigned i = 0; i < numof; i++) {
+        _set_addr(&addrs[i], (i << 16) | (random_uint32() & 0xffff));
+        if (gnrc_ipv6_nc_add(IFACE, &addrs[i], NULL, 0,
+                             GNRC_IPV6_NC_STATE_REACHABLE) == NULL) {
+            printf("ERROR: could not add entry %u\n", i);
+            return 1;
+        }
+    }
+
+    printf("%u entries:\n", numof);
+    BENCHMARK_FUNC("hit", LOOKUPS,
+                   found += _get(&addrs[random_uint32_range(0, numof)]));
+    if (found != LOOKUPS) {
+        printf("ERROR: %u of %u lookups failed\n", LOOKUPS - found, LOOKUPS);
+        return 1;
+    }
+    BENCHMARK_FUNC("miss", LOOKUPS, found += _get_unknown(i));
+    if (found != LOOKUPS) {
+        puts("ERROR: found unknown address");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    puts("IPv6 neighbor cache benchmark");
+
+    for (unsigned i = 0; i < sizeof(numofs) / sizeof(numofs[0]); i++) {
+        if (_run(numofs[i]) != 0) {
+            puts("[FAILURE]");
+            return 1;
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       gnrc_netreg demultiplexing benchmark
+ *
+ * Registers 1 to 256 ports and measures gnrc_netapi_dispatch() for
+ * registered and unregistered ports. All ports are registered for this
+ * thread, which takes the dispatched message off its queue again.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "random.h"
+#include "thread.h"
+
+#define MAX_ENTRIES     (256U)
+#define LOOKUPS         (10000U)
+#define FIRST_PORT      (5683U)
+/* GNRC_NETTYPE_UDP would pull in gnrc_udp, the registry is the same for
+ * all types */
+#define NETTYPE         (GNRC_NETTYPE_UNDEF)
+
+static const unsigned numofs[] = { 1, 16, 64, 256 };
+
+static gnrc_netreg_entry_t entries[MAX_ENTRIES];
+static msg_t msg_queue[4];
+
+static unsigned _dispatch(uint32_t port)
+{
+    int numof = gnrc_netapi_dispatch(NETTYPE, port, GNRC_NETAPI_MSG_TYPE_RCV, NULL);
+    msg_t msg;
+
+    for (int i = 0; i < numof; i++) {
+        msg_try_receive(&msg);
+    }
+    return numof;
+}
+
+static int _run(unsigned numof)
+{
+    unsigned res = 0;
+
+    gnrc_netreg_init();
+    for (unsigned i = 0; i < numof; i++) {
+        entries[i].demux_ctx = FIRST_PORT + i;
+        entries[i].pid = thread_getpid();
+        gnrc_netreg_register(NETTYPE, &entries[i]);
+    }
+
+    printf("%u ports:\n", numof);
+    BENCHMARK_FUNC("registered", LOOKUPS,
+                   res += _dispatch(FIRST_PORT + random_uint32_range(0, numof)));
+    if (res != LOOKUPS) {
+        printf("ERROR: %u of %u dispatches failed\n", LOOKUPS - res, LOOKUPS);
+        return 1;
+    }
+    BENCHMARK_FUNC("unregistered", LOOKUPS,
+                   res += _dispatch(FIRST_PORT + MAX_ENTRIES +
+                                    random_uint32_range(0, numof)));
+    if (res != LOOKUPS) {
+        puts("ERROR: dispatched to an unregistered port");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    msg_init_queue(msg_queue, sizeof(msg_queue) / sizeof(msg_queue[0]));
+
+    printf("gnrc_netreg benchmark (%u buckets)\n", GNRC_NETREG_BUCKETS);
+
+    for (unsigned i = 0; i < sizeof(numofs) / sizeof(numofs[0]); i++) {
+        if (_run(numofs[i]) != 0) {
+            puts("[FAILURE]");
+            return 1;
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       6LoWPAN context lookup benchmark
+ *
+ * Fills all context slots with prefixes of different lengths and times
+ * gnrc_sixlowpan_ctx_lookup_addr() compared to the former linear search,
+ * which compared every context with ipv6_addr_match_prefix() and recomputed
+ * its lifetime on every lookup.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define LOOKUPS         (100000U)
+
+static ipv6_addr_t addrs[GNRC_SIXLOWPAN_CTX_SIZE];
+static gnrc_sixlowpan_ctx_t *(*lookup)(const ipv6_addr_t *);
+
+static gnrc_sixlowpan_ctx_t *_linear_lookup(const ipv6_addr_t *addr)
+{
+    gnrc_sixlowpan_ctx_t *res = NULL;
+    uint8_t best = 0;
+
+    for (unsigned id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+        gnrc_sixlowpan_ctx_t *ctx = gnrc_sixlowpan_ctx_lookup_id(id);
+        uint8_t match;
+
+        if (ctx == NULL) {
+            continue;
+        }
+        /* the lifetime used to be recomputed from the current time here */
+        (void)xtimer_now();
+        match = ipv6_addr_match_prefix(&ctx->prefix, addr);
+        if ((match >= ctx->prefix_len) && (ctx->prefix_len > best)) {
+            res = ctx;
+            best = ctx->prefix_len;
+        }
+    }
+
+    return res;
+}
+
+static unsigned _hit(unsigned id)
+{
+    gnrc_sixlowpan_ctx_t *ctx = lookup(&addrs[id]);
+
+    return ((ctx != NULL) &&
+            ((ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) == id));
+}
+
+static unsigned _miss(uint32_t i)
+{
+    ipv6_addr_t unknown = IPV6_ADDR_UNSPECIFIED;
+
+    /* fe80::/10 is never used as a context */
+    unknown.u8[0] = 0xfe;
+    unknown.u8[1] = 0x80;
+    unknown.u32[3].u32 = i;
+    return (lookup(&unknown) != NULL);
+}
+
+static int _run(const char *what,
+                gnrc_sixlowpan_ctx_t *(*func)(const ipv6_addr_t *))
+{
+    unsigned found = 0;
+
+    puts(what);
+    lookup = func;
+    BENCHMARK_FUNC("hit", LOOKUPS,
+                   found += _hit(random_uint32_range(0, GNRC_SIXLOWPAN_CTX_SIZE)));
+    if (found != LOOKUPS) {
+        printf("ERROR: %u of %u lookups failed\n", LOOKUPS - found, LOOKUPS);
+        return 1;
+    }
+    BENCHMARK_FUNC("miss", LOOKUPS, found += _miss(i));
+    if (found != LOOKUPS) {
+        puts("ERROR: found unknown address");
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    puts("6LoWPAN context lookup benchmark");
+
+    for (unsigned id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+        /* 2001:db8:<id>::/48 up to 2001:db8:<id>::/(48 + 4 * id), so every
+         * context is the longest match for its own addresses */
+        ipv6_addr_from_str(&addrs[id], "2001:db8::");
+        addrs[id].u8[4] = id;
+        addrs[id].u32[2].u32 = random_uint32();
+        addrs[id].u32[3].u32 = random_uint32();
+        if (gnrc_sixlowpan_ctx_update(id, &addrs[id], 48 + (4 * id), UINT16_MAX,
+                                      true) == NULL) {
+            printf("ERROR: could not add context %u\n", id);
+            puts("[FAILURE]");
+            return 1;
+        }
+    }
+
+    if ((_run("linear search:", _linear_lookup) != 0) ||
+        (_run("gnrc_sixlowpan_ctx_lookup_addr():",
+              gnrc_sixlowpan_ctx_lookup_addr) != 0)) {
+        puts("[FAILURE]");
+        return 1;
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       6LoWPAN IPHC encoding and decoding benchmark
+ *
+ * Encodes and decodes a trace of UDP/CoAP traffic between a border router
+ * and a few nodes, as it is seen by the border router: CoAP requests and
+ * responses using a compressible global prefix, link-local neighbor
+ * discovery, and multicast. Every packet is decoded again and compared to
+ * the original header.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ieee802154.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define IFACE           (6)
+#define NODES           (4U)
+#define TRACE_LEN       (64U)
+#define ROUNDS          (200U)
+#define COAP_PORT       (5683U)
+#define PAYLOAD_LEN     (32U)
+
+typedef struct {
+    ipv6_hdr_t ipv6;
+    udp_hdr_t udp;
+    uint8_t src_l2[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t dst_l2[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t src_l2_len;
+    uint8_t dst_l2_len;
+} trace_pkt_t;
+
+static trace_pkt_t trace[TRACE_LEN];
+static uint8_t payload[PAYLOAD_LEN];
+static gnrc_pktsnip_t *pkts[TRACE_LEN];
+static uint32_t enc_time, dec_time, bytes;
+
+static void _node_addr(ipv6_addr_t *addr, uint8_t *l2, unsigned node, bool global)
+{
+    memset(l2, 0, IEEE802154_LONG_ADDRESS_LEN);
+    l2[0] = 0x02;
+    l2[7] = node + 1;
+    memset(addr, 0, sizeof(ipv6_addr_t));
+    if (global) {
+        addr->u8[0] = 0x20;
+        addr->u8[1] = 0x01;
+        addr->u8[2] = 0x0d;
+        addr->u8[3] = 0xb8;
+    }
+    else {
+        ipv6_addr_set_link_local_prefix(addr);
+    }
+    ieee802154_get_iid((eui64_t *)&addr->u64[1], l2, IEEE802154_LONG_ADDRESS_LEN);
+}
+
+static void _build_trace(void)
+{
+    /* node 0 is the border router */
+    for (unsigned i = 0; i < TRACE_LEN; i++) {
+        trace_pkt_t *pkt = &trace[i];
+        unsigned node = random_uint32_range(1, NODES);
+        unsigned kind = random_uint32_range(0, 8);
+        bool request = random_uint32() & 1;
+
+        memset(pkt, 0, sizeof(trace_pkt_t));
+        ipv6_hdr_set_version(&pkt->ipv6);
+        pkt->ipv6.hl = 64;
+        pkt->ipv6.nh = PROTNUM_UDP;
+        pkt->ipv6.len = byteorder_htons(sizeof(udp_hdr_t) + PAYLOAD_LEN);
+        pkt->src_l2_len = IEEE802154_LONG_ADDRESS_LEN;
+        pkt->dst_l2_len = IEEE802154_LONG_ADDRESS_LEN;
+        pkt->udp.length = pkt->ipv6.len;
+        pkt->udp.checksum = byteorder_htons(random_uint32());
+        if (kind < 6) {
+            /* CoAP request or response with a global address */
+            _node_addr(&pkt->ipv6.src, pkt->src_l2, request ? 0 : node, true);
+            _node_addr(&pkt->ipv6.dst, pkt->dst_l2, request ? node : 0, true);
+            pkt->udp.src_port = byteorder_htons(request ? 49152 + node : COAP_PORT);
+            pkt->udp.dst_port = byteorder_htons(request ? COAP_PORT : 49152 + node);
+        }
+        else if (kind == 6) {
+            /* link-local neighbor discovery, short source address */
+            _node_addr(&pkt->ipv6.src, pkt->src_l2, node, false);
+            _node_addr(&pkt->ipv6.dst, pkt->dst_l2, 0, false);
+            pkt->src_l2_len = IEEE802154_SHORT_ADDRESS_LEN;
+            pkt->src_l2[0] = 0;
+            pkt->src_l2[1] = node + 1;
+            pkt->ipv6.nh = PROTNUM_ICMPV6;
+            pkt->ipv6.hl = 255;
+        }
+        else {
+            /* CoAP resource discovery to all CoAP nodes */
+            _node_addr(&pkt->ipv6.src, pkt->src_l2, 0, false);
+            ipv6_addr_from_str(&pkt->ipv6.dst, "ff02::fd");
+            pkt->dst_l2_len = IEEE802154_SHORT_ADDRESS_LEN;
+            pkt->dst_l2[0] = 0xff;
+            pkt->dst_l2[1] = 0xff;
+            pkt->udp.src_port = byteorder_htons(COAP_PORT);
+            pkt->udp.dst_port = byteorder_htons(COAP_PORT);
+        }
+    }
+}
+
+static gnrc_pktsnip_t *_build_pkt(const trace_pkt_t *tpkt)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, payload, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *netif;
+
+    if ((pkt != NULL) && (tpkt->ipv6.nh == PROTNUM_UDP)) {
+        pkt = gnrc_pktbuf_add(pkt, (void *)&tpkt->udp, sizeof(udp_hdr_t),
+                              GNRC_NETTYPE_UNDEF);
+    }
+    if (pkt != NULL) {
+        pkt = gnrc_pktbuf_add(pkt, (void *)&tpkt->ipv6, sizeof(ipv6_hdr_t),
+                              GNRC_NETTYPE_IPV6);
+    }
+    if (pkt == NULL) {
+        return NULL;
+    }
+    netif = gnrc_netif_hdr_build((uint8_t *)tpkt->src_l2, tpkt->src_l2_len,
+                                 (uint8_t *)tpkt->dst_l2, tpkt->dst_l2_len);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = IFACE;
+    netif->next = pkt;
+    return netif;
+}
+
+/* turns an encoded packet into a received frame */
+static gnrc_pktsnip_t *_to_frame(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = pkt, *frame;
+    uint8_t *data;
+
+    frame = gnrc_pktbuf_add(NULL, NULL, gnrc_pkt_len(pkt->next),
+                            GNRC_NETTYPE_SIXLOWPAN);
+    if (frame == NULL) {
+        return NULL;
+    }
+    data = frame->data;
+    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL; snip = snip->next) {
+        memcpy(data, snip->data, snip->size);
+        data += snip->size;
+    }
+    gnrc_pktbuf_release(pkt->next);
+    netif->next = NULL;
+    frame->next = netif;
+    return frame;
+}
+
+/* encodes and decodes the trace once */
+static int _run(void)
+{
+    uint32_t start;
+
+    for (unsigned i = 0; i < TRACE_LEN; i++) {
+        pkts[i] = _build_pkt(&trace[i]);
+        if (pkts[i] == NULL) {
+            puts("ERROR: packet buffer full");
+            return 1;
+        }
+    }
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < TRACE_LEN; i++) {
+        if (!gnrc_sixlowpan_iphc_encode(pkts[i])) {
+            puts("ERROR: encoding failed");
+            return 1;
+        }
+    }
+    enc_time += xtimer_now() - start;
+
+    for (unsigned i = 0; i < TRACE_LEN; i++) {
+        pkts[i] = _to_frame(pkts[i]);
+        if (pkts[i] == NULL) {
+            puts("ERROR: packet buffer full");
+            return 1;
+        }
+        bytes += pkts[i]->size - PAYLOAD_LEN;
+    }
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < TRACE_LEN; i++) {
+        gnrc_pktsnip_t *dec_hdr = gnrc_pktbuf_add(NULL, NULL,
+                                                  GNRC_SIXLOWPAN_IPHC_DEC_HDR_LEN,
+                                                  GNRC_NETTYPE_IPV6);
+        size_t nh_len = 0;
+
+        if ((dec_hdr == NULL) ||
+            (gnrc_sixlowpan_iphc_decode(&dec_hdr, pkts[i], 0, 0, &nh_len) == 0)) {
+            puts("ERROR: decoding failed");
+            return 1;
+        }
+        /* keep for comparison, released with the frame */
+        pkts[i]->next->next = dec_hdr;
+    }
+    dec_time += xtimer_now() - start;
+
+    for (unsigned i = 0; i < TRACE_LEN; i++) {
+        gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkts[i]->next->next,
+                                                        GNRC_NETTYPE_IPV6);
+        ipv6_hdr_t *hdr = ipv6->data;
+
+        if (!ipv6_addr_equal(&hdr->src, &trace[i].ipv6.src) ||
+            !ipv6_addr_equal(&hdr->dst, &trace[i].ipv6.dst) ||
+            (hdr->hl != trace[i].ipv6.hl)) {
+            printf("ERROR: packet %u decoded wrongly\n", i);
+            return 1;
+        }
+        gnrc_pktbuf_release(pkts[i]);
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    ipv6_addr_t prefix;
+
+    puts("6LoWPAN IPHC benchmark");
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    printf("flow cache with %u entries\n", GNRC_SIXLOWPAN_IPHC_CACHE_SIZE);
+#else
+    puts("no flow cache");
+#endif
+
+    gnrc_pktbuf_init();
+    ipv6_addr_from_str(&prefix, "2001:db8::");
+    gnrc_sixlowpan_ctx_update(0, &prefix, 64, UINT16_MAX, true);
+    _build_trace();
+
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        if (_run() != 0) {
+            puts("[FAILURE]");
+            return 1;
+        }
+    }
+
+    benchmark_print_time(enc_time, ROUNDS * TRACE_LEN, "encode");
+    benchmark_print_time(dec_time, ROUNDS * TRACE_LEN, "decode");
+    printf("headers: avg %" PRIu32 " bytes/packet\n", bytes / (ROUNDS * TRACE_LEN));
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Internet checksum benchmark
+ *
+ * Compares inet_csum_slice() to a 16-bit word at a time implementation for
+ * buffers of different lengths and alignments.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "net/inet_csum.h"
+
+#define MAX_LEN         (1280U)
+#define RUNS            (1000U)
+
+static const unsigned lens[] = { 8, 40, 128, 512, 1280 };
+
+static uint32_t mem[(MAX_LEN + 4) / sizeof(uint32_t)];
+
+/* checksum as it was calculated before word-wise summing */
+static uint16_t _csum_words(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (int i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        uint16_t carry = csum >> 16;
+        csum = (csum & 0xffff) + carry;
+    }
+    return csum;
+}
+
+static int _run(unsigned len, unsigned offset)
+{
+    const uint8_t *buf = (uint8_t *)mem + offset;
+    uint16_t ref = 0, res = 0;
+
+    printf("%u bytes, offset %u:\n", len, offset);
+    BENCHMARK_FUNC("16-bit", RUNS, ref = _csum_words(ref, buf, len));
+    BENCHMARK_FUNC("inet_csum", RUNS, res = inet_csum(res, buf, len));
+    if (ref != res) {
+        printf("ERROR: checksum 0x%04x, expected 0x%04x\n", res, ref);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    uint8_t *data = (uint8_t *)mem;
+
+    puts("inet_csum benchmark");
+
+    for (unsigned i = 0; i < sizeof(mem); i++) {
+        data[i] = (uint8_t)((i * 7) + 0xa5);
+    }
+
+    for (unsigned i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        for (unsigned offset = 0; offset < 3; offset++) {
+            if (_run(lens[i], offset) != 0) {
+                puts("[FAILURE]");
+                return 1;
+            }
+        }
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
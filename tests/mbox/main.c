@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for mailboxes shared by a pool of workers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mbox.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define WORKER_NUMOF        (3U)
+#define JOB_NUMOF           (30U)
+#define QUEUE_SIZE          (4U)
+#define JOB_DURATION        (2000U)
+#define TIMEOUT             (10000U)
+
+#define MSG_TYPE_JOB        (0x4a4f)
+#define MSG_TYPE_DONE       (0x444e)
+
+static char stacks[WORKER_NUMOF][THREAD_STACKSIZE_DEFAULT];
+
+static msg_t queue[QUEUE_SIZE];
+static mbox_t work = MBOX_INIT(queue, QUEUE_SIZE);
+/* no queue: a finishing worker waits until main takes its message */
+static mbox_t finished = MBOX_INIT(NULL, 0);
+
+static unsigned jobs_done[WORKER_NUMOF];
+static unsigned errors;
+static kernel_pid_t main_pid;
+
+static void *worker(void *arg)
+{
+    unsigned id = (uintptr_t)arg;
+    uint32_t expected = 0;
+    msg_t m;
+
+    while (1) {
+        mbox_get(&work, &m);
+        if (m.type == MSG_TYPE_DONE) {
+            break;
+        }
+        if ((m.type != MSG_TYPE_JOB) || (m.sender_pid != main_pid) ||
+            (m.content.value < expected)) {
+            /* every worker sees the jobs in the order they were put */
+            errors++;
+        }
+        expected = m.content.value;
+        jobs_done[id]++;
+        xtimer_usleep(JOB_DURATION);
+    }
+    printf("worker %u: %u jobs\n", id, jobs_done[id]);
+    m.content.value = id;
+    mbox_put(&finished, &m);
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t m;
+    unsigned total = 0;
+
+    puts("mbox test");
+    main_pid = thread_getpid();
+
+    /* nothing to get yet */
+    if (mbox_try_get(&work, &m) ||
+        (xtimer_mbox_get_timeout(&work, &m, TIMEOUT) >= 0)) {
+        puts("got message from empty mailbox");
+        errors++;
+    }
+
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        thread_create(stacks[i], sizeof(stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, worker, (void *)(uintptr_t)i, "worker");
+    }
+
+    /* blocks whenever all workers are busy and the queue is full */
+    for (uint32_t i = 0; i < JOB_NUMOF; i++) {
+        m.type = MSG_TYPE_JOB;
+        m.content.value = i;
+        mbox_put(&work, &m);
+    }
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        m.type = MSG_TYPE_DONE;
+        mbox_put(&work, &m);
+    }
+
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        if (xtimer_mbox_get_timeout(&finished, &m, JOB_NUMOF * JOB_DURATION) < 0) {
+            puts("worker did not finish");
+            errors++;
+        }
+    }
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        if (jobs_done[i] == 0) {
+            printf("worker %u was idle\n", i);
+            errors++;
+        }
+        total += jobs_done[i];
+    }
+    if ((total != JOB_NUMOF) || (mbox_avail(&work) != 0)) {
+        printf("%u of %u jobs done\n", total, JOB_NUMOF);
+        errors++;
+    }
+
+    /* a message put before the timeout is received */
+    m.type = MSG_TYPE_JOB;
+    m.content.value = 42;
+    mbox_try_put(&work, &m);
+    if ((xtimer_mbox_get_timeout(&work, &m, TIMEOUT) < 0) ||
+        (m.content.value != 42)) {
+        puts("did not get queued message");
+        errors++;
+    }
+
+    puts(errors ? "[FAILURE]" : "[SUCCESS]");
+    return 0;
+}
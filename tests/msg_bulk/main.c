@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for msg_try_send_bulk() and msg_receive_bulk()
+ *
+ * A producer sends TEST_MSG_NUM messages to a consumer of lower priority,
+ * once one message at a time and once in batches. The consumer checks the
+ * order of the messages.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_MSG_NUM
+#define TEST_MSG_NUM        (10000U)
+#endif
+
+#define BATCH_SIZE          (8U)
+#define QUEUE_SIZE          (16U)
+
+#define PRODUCER_PRIO       (THREAD_PRIORITY_MAIN - 2)
+#define CONSUMER_PRIO       (THREAD_PRIORITY_MAIN - 1)
+
+static char producer_stack[THREAD_STACKSIZE_DEFAULT];
+static char consumer_stack[THREAD_STACKSIZE_DEFAULT];
+
+static msg_t consumer_queue[QUEUE_SIZE];
+static kernel_pid_t main_pid, consumer_pid;
+static unsigned errors;
+
+static void *producer(void *arg)
+{
+    msg_t batch[BATCH_SIZE];
+    unsigned bulk = (uintptr_t)arg;
+    uint32_t next = 0;
+
+    while (next < TEST_MSG_NUM) {
+        if (!bulk) {
+            msg_t m = { .content.value = next++ };
+            msg_send(&m, consumer_pid);
+            continue;
+        }
+
+        unsigned num = TEST_MSG_NUM - next;
+        if (num > BATCH_SIZE) {
+            num = BATCH_SIZE;
+        }
+        for (unsigned i = 0; i < num; i++) {
+            batch[i].content.value = next + i;
+        }
+        int sent = msg_try_send_bulk(batch, num, consumer_pid);
+        if (sent < (int)num) {
+            /* queue is full: block on the first message that didn't fit */
+            msg_send(&batch[sent], consumer_pid);
+            sent++;
+        }
+        next += sent;
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    msg_t batch[QUEUE_SIZE];
+    unsigned bulk = (uintptr_t)arg;
+    uint32_t expected = 0;
+
+    msg_init_queue(consumer_queue, QUEUE_SIZE);
+
+    while (expected < TEST_MSG_NUM) {
+        int num = 1;
+
+        if (bulk) {
+            num = msg_receive_bulk(batch, QUEUE_SIZE);
+        }
+        else {
+            msg_receive(batch);
+        }
+        for (int i = 0; i < num; i++) {
+            if (batch[i].content.value != expected++) {
+                errors++;
+            }
+        }
+    }
+
+    msg_t done = { .type = 0 };
+    msg_send(&done, main_pid);
+    return NULL;
+}
+
+static void run(const char *name, unsigned bulk)
+{
+    msg_t done;
+    uint32_t start = xtimer_now();
+
+    consumer_pid = thread_create(consumer_stack, sizeof(consumer_stack),
+                                 CONSUMER_PRIO, THREAD_CREATE_STACKTEST,
+                                 consumer, (void *)(uintptr_t)bulk, "consumer");
+    thread_create(producer_stack, sizeof(producer_stack), PRODUCER_PRIO,
+                  THREAD_CREATE_STACKTEST, producer, (void *)(uintptr_t)bulk, "producer");
+    msg_receive(&done);
+
+    uint32_t duration = xtimer_now() - start;
+    if (duration == 0) {
+        duration = 1;
+    }
+    printf("%-6s %u messages in %" PRIu32 " us: %" PRIu32 " messages/s\n",
+           name, TEST_MSG_NUM, duration,
+           (uint32_t)(((uint64_t)TEST_MSG_NUM * 1000000U) / duration));
+}
+
+int main(void)
+{
+    puts("msg bulk benchmark");
+    main_pid = thread_getpid();
+
+    run("single", 0);
+    run("bulk", 1);
+
+    if (errors) {
+        printf("%u messages out of order\n", errors);
+        puts("[FAILURE]");
+    }
+    else {
+        puts("[SUCCESS]");
+    }
+    return 0;
+}
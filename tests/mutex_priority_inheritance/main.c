@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the bound on priority inversion of
+ *              mutexes with priority inheritance
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ROUNDS                  (5U)
+#define CRITICAL_SECTION        (10 * 1000U)        /* 10ms, two halves */
+#define MEDIUM_SPIN             (100 * 1000U)       /* 100ms */
+#define HIGH_DELAY              (1 * 1000U)         /* 1ms */
+#define MEDIUM_DELAY            (2 * 1000U)         /* 2ms */
+#define TOLERANCE               (CRITICAL_SECTION / 4)
+
+#define PRIO_HIGH               (THREAD_PRIORITY_MAIN - 3)
+#define PRIO_MEDIUM             (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_LOW                (THREAD_PRIORITY_MAIN - 1)
+
+extern volatile thread_t *sched_active_thread;
+
+static char stacks[3][THREAD_STACKSIZE_MAIN];
+
+static mutex_t outer;
+static mutex_t inner;
+
+static uint32_t latency;
+static int prio_between;
+static int prio_after;
+
+static void *low(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&outer);
+    mutex_lock(&inner);
+    xtimer_spin(CRITICAL_SECTION / 2);
+    mutex_unlock(&inner);
+    /* still holding outer, the high priority thread is waiting for */
+    prio_between = sched_active_thread->priority;
+    xtimer_spin(CRITICAL_SECTION / 2);
+    mutex_unlock(&outer);
+    prio_after = sched_active_thread->priority;
+
+    return NULL;
+}
+
+static void *medium(void *arg)
+{
+    (void)arg;
+
+    xtimer_usleep(MEDIUM_DELAY);
+    /* preempts the low priority thread, unless it inherited a higher one */
+    xtimer_spin(MEDIUM_SPIN);
+
+    return NULL;
+}
+
+static void *high(void *arg)
+{
+    (void)arg;
+
+    xtimer_usleep(HIGH_DELAY);
+    uint32_t start = xtimer_now();
+    mutex_lock(&outer);
+    latency = xtimer_now() - start;
+    mutex_unlock(&outer);
+
+    return NULL;
+}
+
+int main(void)
+{
+    uint32_t max_latency = 0;
+    int failed = 0;
+
+    puts("Mutex priority inheritance test");
+    puts("Please refer to the README.md for more information\n");
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        mutex_init(&outer);
+        mutex_init(&inner);
+
+        /* the low priority thread runs first and takes the mutexes */
+        thread_create(stacks[0], sizeof(stacks[0]), PRIO_LOW,
+                      THREAD_CREATE_WOUT_YIELD, low, NULL, "low");
+        thread_create(stacks[1], sizeof(stacks[1]), PRIO_MEDIUM,
+                      THREAD_CREATE_WOUT_YIELD, medium, NULL, "medium");
+        thread_create(stacks[2], sizeof(stacks[2]), PRIO_HIGH,
+                      THREAD_CREATE_WOUT_YIELD, high, NULL, "high");
+
+        /* all three are done before main, the lowest priority, runs again */
+        thread_yield();
+
+        printf("round %u: high waited %" PRIu32 " us, low ran with priority %i "
+               "between the unlocks and with %i after\n", i, latency,
+               prio_between, prio_after);
+        if (latency > max_latency) {
+            max_latency = latency;
+        }
+        if ((prio_between != PRIO_HIGH) || (prio_after != PRIO_LOW)) {
+            failed = 1;
+        }
+    }
+
+    printf("\nmaximum wait of high: %" PRIu32 " us, bound: %u us\n", max_latency,
+           CRITICAL_SECTION + TOLERANCE);
+    if (failed || (max_latency > (CRITICAL_SECTION + TOLERANCE))) {
+        puts("[FAILURE]");
+    }
+    else {
+        puts("[SUCCESS]");
+    }
+
+    return 0;
+}
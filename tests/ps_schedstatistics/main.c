@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the scheduler statistics
+ *
+ * Starts a busy thread that is preempted by the shell and a thread that
+ * sleeps periodically. Use `ps` to see the statistics and `ps -b` for a
+ * binary dump of them.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "irq.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SLEEP_INTERVAL  (10U * 1000U)
+
+static char busy_stack[THREAD_STACKSIZE_DEFAULT];
+static char sleep_stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *busy_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        /* keep interrupts off for a while now and then */
+        unsigned state = irq_disable();
+        for (volatile unsigned i = 0; i < 1000; i++) {}
+        irq_restore(state);
+        thread_yield();
+    }
+
+    return NULL;
+}
+
+static void *sleep_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        xtimer_usleep(SLEEP_INTERVAL);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    puts("schedstatistics test application");
+
+    thread_create(busy_stack, sizeof(busy_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, busy_thread, NULL, "busy");
+    thread_create(sleep_stack, sizeof(sleep_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, sleep_thread, NULL, "sleep");
+
+    shell_run(NULL, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
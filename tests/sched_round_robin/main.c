@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Fairness test for round-robin time slicing
+ *
+ * Busy threads of equal priority count as fast as they can, main checks
+ * that they all got a similar share of the CPU.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#define THREAD_NUMOF        (3U)
+#define ROUNDS              (5U)
+#define ROUND_DURATION      (1000U * 1000U)
+
+/* the smallest share must be at least this fraction of the largest one */
+#define MIN_SHARE_PERCENT   (70U)
+
+static char stacks[THREAD_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static volatile uint32_t counters[THREAD_NUMOF];
+
+static void *busy_thread(void *arg)
+{
+    volatile uint32_t *counter = arg;
+
+    while (1) {
+        (*counter)++;
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+
+    puts("Round-robin time slicing test");
+    puts("Please refer to the README.md for more information\n");
+
+    /* lower priority than main, so main gets to check the counters */
+    for (unsigned i = 0; i < THREAD_NUMOF; i++) {
+        thread_create(stacks[i], sizeof(stacks[i]), THREAD_PRIORITY_MAIN + 1,
+                      THREAD_CREATE_STACKTEST, busy_thread,
+                      (void *)&counters[i], "busy");
+    }
+
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        uint32_t min = UINT32_MAX, max = 0;
+
+        for (unsigned i = 0; i < THREAD_NUMOF; i++) {
+            counters[i] = 0;
+        }
+        xtimer_usleep(ROUND_DURATION);
+
+        printf("round %u:", round);
+        for (unsigned i = 0; i < THREAD_NUMOF; i++) {
+            uint32_t count = counters[i];
+            printf(" %" PRIu32, count);
+            if (count < min) {
+                min = count;
+            }
+            if (count > max) {
+                max = count;
+            }
+        }
+        puts("");
+
+        if ((uint64_t)min * 100 < (uint64_t)max * MIN_SHARE_PERCENT) {
+            errors++;
+        }
+    }
+
+    puts(errors ? "[FAILURE]" : "[SUCCESS]");
+    return 0;
+}
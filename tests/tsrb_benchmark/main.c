@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Ringbuffer throughput benchmark
+ *
+ * Pushes data through a ringbuffer in chunks, alternating between producer
+ * and consumer, and times a chunk for
+ *
+ * - ringbuffer_add_one()/ringbuffer_get_one() with interrupts disabled
+ *   around every call, as needed when an ISR shares a ringbuffer_t
+ * - tsrb_add_one()/tsrb_get_one()
+ * - tsrb_add()/tsrb_get()
+ * - tsrb_add_reserve()/tsrb_get_reserve(), accessing the buffer in place
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "irq.h"
+#include "ringbuffer.h"
+#include "tsrb.h"
+
+#define BUF_SIZE        (256U)
+#define TOTAL           (4U * 1024U * 1024U)
+
+static const unsigned chunks[] = { 1, 16, 64, 200 };
+
+static char rb_mem[BUF_SIZE];
+static char src[BUF_SIZE];
+static char dst[BUF_SIZE];
+static ringbuffer_t rb;
+static tsrb_t tsrb;
+static unsigned sum;
+
+static void _ringbuffer(unsigned chunk)
+{
+    for (unsigned i = 0; i < chunk; i++) {
+        unsigned state = irq_disable();
+        ringbuffer_add_one(&rb, src[i]);
+        irq_restore(state);
+    }
+    for (unsigned i = 0; i < chunk; i++) {
+        unsigned state = irq_disable();
+        dst[i] = ringbuffer_get_one(&rb);
+        irq_restore(state);
+    }
+    sum += dst[0];
+}
+
+static void _tsrb_one(unsigned chunk)
+{
+    for (unsigned i = 0; i < chunk; i++) {
+        tsrb_add_one(&tsrb, src[i]);
+    }
+    for (unsigned i = 0; i < chunk; i++) {
+        dst[i] = tsrb_get_one(&tsrb);
+    }
+    sum += dst[0];
+}
+
+static void _tsrb_bulk(unsigned chunk)
+{
+    tsrb_add(&tsrb, src, chunk);
+    tsrb_get(&tsrb, dst, chunk);
+    sum += dst[0];
+}
+
+static void _tsrb_inplace(unsigned chunk)
+{
+    char *ptr;
+    size_t len;
+
+    for (unsigned left = chunk; left > 0; left -= len) {
+        len = tsrb_add_reserve(&tsrb, &ptr);
+        if (len > left) {
+            len = left;
+        }
+        memset(ptr, (int)left, len);
+        tsrb_add_commit(&tsrb, len);
+    }
+    for (unsigned left = chunk; left > 0; left -= len) {
+        len = tsrb_get_reserve(&tsrb, &ptr);
+        if (len > left) {
+            len = left;
+        }
+        sum += ptr[0];
+        tsrb_get_commit(&tsrb, len);
+    }
+}
+
+static void _run(const char *what, void (*func)(unsigned))
+{
+    printf("%s:\n", what);
+    for (unsigned i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        char name[sizeof("chunk 123")];
+
+        ringbuffer_init(&rb, rb_mem, sizeof(rb_mem));
+        tsrb_init(&tsrb, rb_mem, sizeof(rb_mem));
+        snprintf(name, sizeof(name), "chunk %u", chunks[i]);
+        BENCHMARK_FUNC(name, TOTAL / chunks[i], func(chunks[i]));
+    }
+}
+
+int main(void)
+{
+    puts("ringbuffer throughput benchmark");
+
+    for (unsigned i = 0; i < sizeof(src); i++) {
+        src[i] = i;
+    }
+
+    _run("ringbuffer+irq", _ringbuffer);
+    _run("tsrb_add/get_one", _tsrb_one);
+    _run("tsrb_add/get", _tsrb_bulk);
+    _run("tsrb_*_reserve", _tsrb_inplace);
+
+    /* keep the compiler from dropping the copies */
+    printf("checksum %u\n", sum);
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -92,6 +92,59 @@ static void test_clist_advance(void)
     TEST_ASSERT(list->next->next == &tests_clist_buf[0]);
 }
 
+static void test_clist_lpush(void)
+{
+    list_node_t *list = &test_clist;
+
+    test_clist_add_two();
+
+    clist_lpush(list, &tests_clist_buf[2]);
+
+    TEST_ASSERT(list->next == &tests_clist_buf[1]);
+    TEST_ASSERT(list->next->next == &tests_clist_buf[2]);
+    TEST_ASSERT(list->next->next->next == &tests_clist_buf[0]);
+}
+
+static void test_clist_lpush_empty(void)
+{
+    list_node_t *list = &test_clist;
+    list->next = NULL;
+
+    clist_lpush(list, &tests_clist_buf[0]);
+
+    TEST_ASSERT(list->next == &tests_clist_buf[0]);
+    TEST_ASSERT(list->next->next == &tests_clist_buf[0]);
+}
+
+static void test_clist_remove(void)
+{
+    list_node_t *list = &test_clist;
+
+    test_clist_add_two();
+    clist_insert(list, &tests_clist_buf[2]);
+
+    /* middle, last and only element */
+    TEST_ASSERT(clist_remove(list, &tests_clist_buf[1]) == &tests_clist_buf[1]);
+    TEST_ASSERT(list->next == &tests_clist_buf[2]);
+    TEST_ASSERT(list->next->next == &tests_clist_buf[0]);
+    TEST_ASSERT(clist_remove(list, &tests_clist_buf[2]) == &tests_clist_buf[2]);
+    TEST_ASSERT(list->next == &tests_clist_buf[0]);
+    TEST_ASSERT(list->next->next == &tests_clist_buf[0]);
+    TEST_ASSERT(clist_remove(list, &tests_clist_buf[0]) == &tests_clist_buf[0]);
+    TEST_ASSERT_NULL(list->next);
+}
+
+static void test_clist_remove_not_found(void)
+{
+    list_node_t *list = &test_clist;
+
+    test_clist_add_two();
+
+    TEST_ASSERT_NULL(clist_remove(list, &tests_clist_buf[2]));
+    TEST_ASSERT(list->next == &tests_clist_buf[1]);
+    TEST_ASSERT(list->next->next->next == &tests_clist_buf[1]);
+}
+
 Test *tests_core_clist_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -100,6 +153,10 @@ Test *tests_core_clist_tests(void)
         new_TestFixture(test_clist_remove_head),
         new_TestFixture(test_clist_remove_two),
         new_TestFixture(test_clist_advance),
+        new_TestFixture(test_clist_lpush),
+        new_TestFixture(test_clist_lpush_empty),
+        new_TestFixture(test_clist_remove),
+        new_TestFixture(test_clist_remove_not_found),
     };
 
     EMB_UNIT_TESTCALLER(core_clist_tests, set_up, NULL,
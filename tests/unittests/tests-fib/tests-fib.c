@@ -976,6 +976,46 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief testing addresses shared between entries
+* It is expected to keep a shared address until the last entry using it
+* is removed and to recycle released addresses
+*/
+static void test_fib_21_shared_addresses(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dst[add_buf_size];
+
+    /* all entries use "Test address 00" as next hop */
+    _fill_FIB_multiple(20, 1);
+
+    TEST_ASSERT_EQUAL_INT(20, fib_get_num_used_entries(&test_fib_table));
+    TEST_ASSERT_EQUAL_INT(20, universal_address_get_num_used_entries());
+
+    /* the next hop is still used by the remaining entries */
+    snprintf(addr_dst, add_buf_size, "Test address %02d", 0);
+    fib_remove_entry(&test_fib_table, (uint8_t *)addr_dst, add_buf_size - 1);
+
+    TEST_ASSERT_EQUAL_INT(19, fib_get_num_used_entries(&test_fib_table));
+    TEST_ASSERT_EQUAL_INT(20, universal_address_get_num_used_entries());
+
+    fib_flush(&test_fib_table, KERNEL_PID_UNDEF);
+
+    TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&test_fib_table));
+    TEST_ASSERT_EQUAL_INT(0, universal_address_get_num_used_entries());
+
+    /* released addresses must be reusable for new ones */
+    for (size_t i = 0; i < 10; ++i) {
+        _fill_FIB_unique(20);
+        TEST_ASSERT_EQUAL_INT(20, fib_get_num_used_entries(&test_fib_table));
+        TEST_ASSERT_EQUAL_INT(40, universal_address_get_num_used_entries());
+        fib_flush(&test_fib_table, KERNEL_PID_UNDEF);
+        TEST_ASSERT_EQUAL_INT(0, universal_address_get_num_used_entries());
+    }
+
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1040,7 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_shared_addresses),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
@@ -700,6 +700,44 @@ static void test_fib_sr_12_get_consecutive_sr(void)
     fib_deinit(&test_fib_sr_table);
 }
 
+/*
+ * @brief create source routes sharing hops and delete them
+ * It is expected to store every hop address only once and to release it
+ * with the last source route using it
+ */
+static void test_fib_sr_13_shared_hops(void)
+{
+    fib_sr_t *local_sourceroutes[2];
+
+    for (size_t i = 0; i < 2; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, fib_sr_create(&test_fib_sr_table, &local_sourceroutes[i],
+                                               42, 0x0, 10000));
+        TEST_ASSERT_EQUAL_INT(0, _create_sr("Some address X", 0, 10,
+                                            local_sourceroutes[i], 16));
+    }
+
+    TEST_ASSERT_EQUAL_INT(10, universal_address_get_num_used_entries());
+
+    TEST_ASSERT_EQUAL_INT(0, fib_sr_delete(&test_fib_sr_table, local_sourceroutes[0]));
+    TEST_ASSERT_EQUAL_INT(10, universal_address_get_num_used_entries());
+
+    TEST_ASSERT_EQUAL_INT(0, fib_sr_delete(&test_fib_sr_table, local_sourceroutes[1]));
+    TEST_ASSERT_EQUAL_INT(0, universal_address_get_num_used_entries());
+
+    /* released addresses must be reusable for new ones */
+    for (size_t i = 1; i < 10; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, fib_sr_create(&test_fib_sr_table, &local_sourceroutes[0],
+                                               42, 0x0, 10000));
+        TEST_ASSERT_EQUAL_INT(0, _create_sr("Some addressY", i * 10, (i + 1) * 10,
+                                            local_sourceroutes[0], 16));
+        TEST_ASSERT_EQUAL_INT(10, universal_address_get_num_used_entries());
+        TEST_ASSERT_EQUAL_INT(0, fib_sr_delete(&test_fib_sr_table, local_sourceroutes[0]));
+        TEST_ASSERT_EQUAL_INT(0, universal_address_get_num_used_entries());
+    }
+
+    fib_deinit(&test_fib_sr_table);
+}
+
 Test *tests_fib_sr_tests(void)
 {
     test_fib_sr_table.data.source_routes = &_entries_sr;
@@ -722,6 +760,7 @@ Test *tests_fib_sr_tests(void)
         new_TestFixture(test_fib_sr_10_create_sr_with_hops_and_get_a_route),
         new_TestFixture(test_fib_sr_11_create_sr_with_hops_and_get_a_partial_route),
         new_TestFixture(test_fib_sr_12_get_consecutive_sr),
+        new_TestFixture(test_fib_sr_13_shared_hops),
     };
 
     EMB_UNIT_TESTCALLER(fib_sr_tests, NULL, NULL, fixtures);
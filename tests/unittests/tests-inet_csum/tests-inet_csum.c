@@ -12,15 +12,23 @@
  * @file
  */
 #include <errno.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "embUnit.h"
 
 #include "net/inet_csum.h"
+#include "random.h"
 
 #include "unittests-constants.h"
 #include "tests-inet_csum.h"
 
+static void set_up(void)
+{
+    /* the same test data on every run */
+    random_init(TEST_UINT32);
+}
+
 static void test_inet_csum__rfc_example(void)
 {
     /* source: https://tools.ietf.org/html/rfc1071#section-3 */
@@ -165,6 +173,69 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* straight forward byte-wise implementation to compare against */
+static uint16_t _csum_ref(uint16_t sum, const uint8_t *buf, uint16_t len,
+                          size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (uint16_t i = 0; i < len; i++, accum_len++) {
+        csum += (accum_len & 1) ? buf[i] : (uint16_t)(buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void test_inet_csum__random_equivalence(void)
+{
+    /* aligned so that the tests cover all offsets relative to a word */
+    static uint32_t mem[80];
+    uint8_t *data = (uint8_t *)mem;
+
+    for (unsigned run = 0; run < 500; run++) {
+        unsigned offset = random_uint32() % 8;
+        uint16_t len = random_uint32() % (sizeof(mem) - offset);
+        uint16_t sum = random_uint32();
+        size_t accum_len = random_uint32() % 4;
+
+        /* mostly fill with 0xff to provoke carries */
+        for (unsigned i = 0; i < sizeof(mem); i++) {
+            data[i] = (random_uint32() & 1) ? 0xff : random_uint32();
+        }
+        TEST_ASSERT_EQUAL_INT(_csum_ref(sum, data + offset, len, accum_len),
+                              inet_csum_slice(sum, data + offset, len, accum_len));
+    }
+}
+
+static void test_inet_csum__random_slices(void)
+{
+    static uint32_t mem[80];
+    uint8_t *data = (uint8_t *)mem;
+
+    for (unsigned run = 0; run < 200; run++) {
+        uint16_t len = random_uint32() % sizeof(mem);
+        uint16_t expected, sum = 0;
+        size_t accum_len = 0;
+
+        for (unsigned i = 0; i < sizeof(mem); i++) {
+            data[i] = random_uint32();
+        }
+        expected = _csum_ref(0, data, len, 0);
+        /* split the domain into slices of random, possibly odd length */
+        while (accum_len < len) {
+            uint16_t slice = (random_uint32() % 17) + 1;
+            if (slice > (len - accum_len)) {
+                slice = len - accum_len;
+            }
+            sum = inet_csum_slice(sum, data + accum_len, slice, accum_len);
+            accum_len += slice;
+        }
+        TEST_ASSERT_EQUAL_INT(expected, sum);
+    }
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,9 +247,11 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__random_equivalence),
+        new_TestFixture(test_inet_csum__random_slices),
     };
 
-    EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
+    EMB_UNIT_TESTCALLER(inet_csum_tests, set_up, NULL, fixtures);
 
     return (Test *)&inet_csum_tests;
 }
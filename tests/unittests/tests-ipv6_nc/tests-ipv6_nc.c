@@ -118,6 +118,58 @@ static void test_ipv6_nc_add__full(void)
                                       sizeof(TEST_STRING4), 0));
 }
 
+static void _fill(uint8_t flags)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4), flags));
+        addr.u16[7].u16++;
+    }
+}
+
+static void test_ipv6_nc_add__full_evict_stale(void)
+{
+    ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t addr = OTHER_TEST_IPV6_ADDR;
+
+    _fill(GNRC_IPV6_NC_STATE_STALE);
+    /* replaces the least recently used entry */
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4), 0));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+}
+
+static void test_ipv6_nc_add__full_registered(void)
+{
+    ipv6_addr_t addr = OTHER_TEST_IPV6_ADDR;
+
+    /* 6LoWPAN-ND registers neighbors in stale state */
+    _fill(GNRC_IPV6_NC_STATE_STALE | GNRC_IPV6_NC_TYPE_REGISTERED);
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                      sizeof(TEST_STRING4), 0));
+}
+
+static void test_ipv6_nc_add__full_tentative(void)
+{
+    ipv6_addr_t addr = OTHER_TEST_IPV6_ADDR;
+
+    _fill(GNRC_IPV6_NC_STATE_STALE | GNRC_IPV6_NC_TYPE_TENTATIVE);
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                      sizeof(TEST_STRING4), 0));
+}
+
+static void test_ipv6_nc_add__full_router(void)
+{
+    ipv6_addr_t addr = OTHER_TEST_IPV6_ADDR;
+
+    _fill(GNRC_IPV6_NC_STATE_STALE | GNRC_IPV6_NC_IS_ROUTER);
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                      sizeof(TEST_STRING4), 0));
+}
+
 static void test_ipv6_nc_add__success(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
@@ -449,6 +501,10 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_add__addr_unspecified),
         new_TestFixture(test_ipv6_nc_add__l2addr_too_long),
         new_TestFixture(test_ipv6_nc_add__full),
+        new_TestFixture(test_ipv6_nc_add__full_evict_stale),
+        new_TestFixture(test_ipv6_nc_add__full_registered),
+        new_TestFixture(test_ipv6_nc_add__full_tentative),
+        new_TestFixture(test_ipv6_nc_add__full_router),
         new_TestFixture(test_ipv6_nc_add__success),
         new_TestFixture(test_ipv6_nc_add__address_update_despite_free_entry),
         new_TestFixture(test_ipv6_nc_remove__no_entry_pid),
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "sched.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+
+#include "unittests-constants.h"
+#include "tests-netapi.h"
+
+#define QUEUE_SIZE      (4U)
+#define CTX             (TEST_UINT16)
+
+static msg_t msg_queue[QUEUE_SIZE];
+static gnrc_netreg_entry_t entries[2];
+static gnrc_netapi_batch_t batch;
+static unsigned drained;
+
+static gnrc_pktsnip_t *_pkt(void)
+{
+    return gnrc_pktbuf_add(NULL, NULL, TEST_UINT8, GNRC_NETTYPE_UNDEF);
+}
+
+static void _register(unsigned i, uint32_t demux_ctx, kernel_pid_t pid)
+{
+    entries[i].next = NULL;
+    entries[i].demux_ctx = demux_ctx;
+    entries[i].pid = pid;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[i]));
+}
+
+static void _add(uint32_t demux_ctx, int numof)
+{
+    gnrc_pktsnip_t *pkt = _pkt();
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(numof, gnrc_netapi_batch_add(&batch, GNRC_NETTYPE_TEST,
+                                                       demux_ctx,
+                                                       GNRC_NETAPI_MSG_TYPE_RCV,
+                                                       pkt));
+}
+
+static void _drain(gnrc_pktsnip_t *pkt)
+{
+    drained++;
+    gnrc_pktbuf_release(pkt);
+}
+
+/* leaves only free slots in the message queue */
+static void _fill_queue(unsigned free)
+{
+    msg_t msg = { .type = TEST_UINT16 };
+
+    for (unsigned i = free; i < QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(1, msg_try_send(&msg, sched_active_pid));
+    }
+}
+
+/* receives the messages of _fill_queue() */
+static void _empty_queue(unsigned free)
+{
+    msg_t msg;
+
+    for (unsigned i = free; i < QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+        TEST_ASSERT_EQUAL_INT(TEST_UINT16, msg.type);
+    }
+}
+
+/* receives one batch and releases it with its packets */
+static void _receive_batch(unsigned numof)
+{
+    msg_t msg;
+
+    TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV_BATCH, msg.type);
+    drained = 0;
+    gnrc_netapi_batch_drain((gnrc_pktsnip_t *)msg.content.ptr, _drain);
+    TEST_ASSERT_EQUAL_INT(numof, drained);
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_netreg_init();
+    msg_init_queue(msg_queue, QUEUE_SIZE);
+    memset(&batch, 0, sizeof(batch));
+}
+
+static void test_netapi_dispatch__partial_failure(void)
+{
+    gnrc_pktsnip_t *pkt = _pkt();
+    msg_t msg;
+
+    /* the second message does not fit into the queue */
+    _register(0, CTX, sched_active_pid);
+    _register(1, CTX, sched_active_pid);
+    _fill_queue(1);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netapi_dispatch(GNRC_NETTYPE_TEST, CTX,
+                                                  GNRC_NETAPI_MSG_TYPE_RCV, pkt));
+    _empty_queue(1);
+    TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+    TEST_ASSERT((gnrc_pktsnip_t *)msg.content.ptr == pkt);
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    gnrc_pktbuf_release(pkt);
+    /* the reference of the failed subscriber was released */
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_netapi_batch_add__no_subscribers(void)
+{
+    gnrc_pktsnip_t *pkt = _pkt();
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netapi_batch_add(&batch, GNRC_NETTYPE_TEST, CTX,
+                                                   GNRC_NETAPI_MSG_TYPE_RCV, pkt));
+    TEST_ASSERT_NULL(batch.batch);
+    /* the packet still belongs to the caller */
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_netapi_batch_add__full(void)
+{
+    _register(0, CTX, sched_active_pid);
+    for (unsigned i = 0; i < GNRC_NETAPI_BATCH_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, msg_avail());
+        _add(CTX, 1);
+    }
+    TEST_ASSERT_NULL(batch.batch);
+    _receive_batch(GNRC_NETAPI_BATCH_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_netapi_batch_add__other_subscribers(void)
+{
+    _register(0, CTX, sched_active_pid);
+    _register(1, CTX + 1, sched_active_pid);
+    _add(CTX, 1);
+    _add(CTX, 1);
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    _add(CTX + 1, 1);
+    _receive_batch(2);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_batch_flush(&batch));
+    _receive_batch(1);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_netapi_batch_flush__empty(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netapi_batch_flush(&batch));
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+}
+
+static void test_netapi_batch_flush__partial_failure(void)
+{
+    /* the second message does not fit into the queue */
+    _register(0, CTX, sched_active_pid);
+    _register(1, CTX, sched_active_pid);
+    _add(CTX, 2);
+    _add(CTX, 2);
+    _fill_queue(1);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netapi_batch_flush(&batch));
+    TEST_ASSERT_NULL(batch.batch);
+    _empty_queue(1);
+    _receive_batch(2);
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    /* the references of the failed subscriber were released */
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_netapi_batch_flush__queue_full(void)
+{
+    _register(0, CTX, sched_active_pid);
+    _add(CTX, 1);
+    _add(CTX, 1);
+    _fill_queue(0);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_batch_flush(&batch));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    _empty_queue(0);
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+}
+
+static void test_netapi_batch_flush__unregistered(void)
+{
+    _register(0, CTX, sched_active_pid);
+    _add(CTX, 1);
+    _add(CTX, 1);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &entries[0]);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netapi_batch_flush(&batch));
+    TEST_ASSERT_NULL(batch.batch);
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *tests_netapi_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netapi_dispatch__partial_failure),
+        new_TestFixture(test_netapi_batch_add__no_subscribers),
+        new_TestFixture(test_netapi_batch_add__full),
+        new_TestFixture(test_netapi_batch_add__other_subscribers),
+        new_TestFixture(test_netapi_batch_flush__empty),
+        new_TestFixture(test_netapi_batch_flush__partial_failure),
+        new_TestFixture(test_netapi_batch_flush__queue_full),
+        new_TestFixture(test_netapi_batch_flush__unregistered),
+    };
+
+    EMB_UNIT_TESTCALLER(netapi_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netapi_tests;
+}
+
+void tests_netapi(void)
+{
+    TESTS_RUN(tests_netapi_tests());
+}
+/** @} */
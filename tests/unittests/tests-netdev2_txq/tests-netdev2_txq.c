@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/netdev2.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+
+#include "tests-netdev2_txq.h"
+
+static gnrc_netdev2_t gnrc_netdev2;
+static netdev2_t netdev2;
+static gnrc_pktsnip_t *sent[GNRC_NETDEV2_TXQ_SIZE + 1];
+static unsigned sent_numof;
+
+static int _send(gnrc_netdev2_t *dev, gnrc_pktsnip_t *pkt)
+{
+    (void)dev;
+    sent[sent_numof++] = pkt;
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+static gnrc_pktsnip_t *_pkt(bool ctrl)
+{
+    gnrc_pktsnip_t *pkt = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+
+    if ((pkt != NULL) && ctrl) {
+        ((gnrc_netif_hdr_t *)pkt->data)->flags |= GNRC_NETIF_HDR_FLAGS_CTRL;
+    }
+    return pkt;
+}
+
+/* fills the queue and returns the packets in the order they were added */
+static void _fill(gnrc_pktsnip_t **pkts, bool ctrl)
+{
+    for (unsigned i = 0; i < GNRC_NETDEV2_TXQ_SIZE; i++) {
+        pkts[i] = _pkt(ctrl);
+        gnrc_netdev2_txq_add(&gnrc_netdev2, pkts[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_TXQ_SIZE, gnrc_netdev2.txq_numof);
+}
+
+static void _flush(void)
+{
+    while (gnrc_netdev2_txq_send(&gnrc_netdev2)) {}
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netdev2.txq_numof);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    memset(&gnrc_netdev2, 0, sizeof(gnrc_netdev2));
+    gnrc_netdev2.send = _send;
+    gnrc_netdev2.dev = &netdev2;
+    gnrc_netdev2_txq_init(&gnrc_netdev2);
+    sent_numof = 0;
+}
+
+static void test_txq_send__empty(void)
+{
+    TEST_ASSERT(!gnrc_netdev2_txq_send(&gnrc_netdev2));
+    TEST_ASSERT_EQUAL_INT(0, sent_numof);
+}
+
+static void test_txq_send__ctrl_first(void)
+{
+    gnrc_pktsnip_t *data = _pkt(false), *ctrl = _pkt(true);
+
+    gnrc_netdev2_txq_add(&gnrc_netdev2, data);
+    gnrc_netdev2_txq_add(&gnrc_netdev2, ctrl);
+    _flush();
+    TEST_ASSERT_EQUAL_INT(2, sent_numof);
+    TEST_ASSERT(sent[0] == ctrl);
+    TEST_ASSERT(sent[1] == data);
+}
+
+static void test_txq_add__full_drop_tail(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_NETDEV2_TXQ_SIZE];
+
+    _fill(pkts, false);
+    gnrc_netdev2_txq_add(&gnrc_netdev2, _pkt(false));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_TXQ_SIZE, gnrc_netdev2.txq_numof);
+    _flush();
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_TXQ_SIZE, sent_numof);
+    for (unsigned i = 0; i < GNRC_NETDEV2_TXQ_SIZE; i++) {
+        TEST_ASSERT(sent[i] == pkts[i]);
+    }
+}
+
+static void test_txq_add__full_drop_head(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_NETDEV2_TXQ_SIZE], *pkt;
+
+    gnrc_netdev2.txq_policy = GNRC_NETDEV2_TXQ_DROP_HEAD;
+    _fill(pkts, false);
+    pkt = _pkt(false);
+    gnrc_netdev2_txq_add(&gnrc_netdev2, pkt);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_TXQ_SIZE, gnrc_netdev2.txq_numof);
+    _flush();
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_TXQ_SIZE, sent_numof);
+    for (unsigned i = 1; i < GNRC_NETDEV2_TXQ_SIZE; i++) {
+        TEST_ASSERT(sent[i - 1] == pkts[i]);
+    }
+    TEST_ASSERT(sent[GNRC_NETDEV2_TXQ_SIZE - 1] == pkt);
+}
+
+static void test_txq_add__full_drop_tail_ctrl(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_NETDEV2_TXQ_SIZE], *ctrl;
+
+    _fill(pkts, false);
+    ctrl = _pkt(true);
+    gnrc_netdev2_txq_add(&gnrc_netdev2, ctrl);
+    _flush();
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_TXQ_SIZE, sent_numof);
+    TEST_ASSERT(sent[0] == ctrl);
+    /* the newest data packet made room */
+    for (unsigned i = 1; i < GNRC_NETDEV2_TXQ_SIZE; i++) {
+        TEST_ASSERT(sent[i] == pkts[i - 1]);
+    }
+}
+
+static void test_txq_add__full_drop_head_ctrl(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_NETDEV2_TXQ_SIZE], *ctrl;
+
+    gnrc_netdev2.txq_policy = GNRC_NETDEV2_TXQ_DROP_HEAD;
+    _fill(pkts, false);
+    ctrl = _pkt(true);
+    gnrc_netdev2_txq_add(&gnrc_netdev2, ctrl);
+    _flush();
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_TXQ_SIZE, sent_numof);
+    TEST_ASSERT(sent[0] == ctrl);
+    /* the oldest data packet made room */
+    for (unsigned i = 1; i < GNRC_NETDEV2_TXQ_SIZE; i++) {
+        TEST_ASSERT(sent[i] == pkts[i]);
+    }
+}
+
+static void test_txq_add__full_of_ctrl(void)
+{
+    gnrc_pktsnip_t *pkts[GNRC_NETDEV2_TXQ_SIZE];
+
+    /* a data packet never makes room in a higher class, whatever the policy */
+    gnrc_netdev2.txq_policy = GNRC_NETDEV2_TXQ_DROP_HEAD;
+    _fill(pkts, true);
+    gnrc_netdev2_txq_add(&gnrc_netdev2, _pkt(false));
+    _flush();
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_TXQ_SIZE, sent_numof);
+    for (unsigned i = 0; i < GNRC_NETDEV2_TXQ_SIZE; i++) {
+        TEST_ASSERT(sent[i] == pkts[i]);
+    }
+}
+
+Test *tests_netdev2_txq_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_txq_send__empty),
+        new_TestFixture(test_txq_send__ctrl_first),
+        new_TestFixture(test_txq_add__full_drop_tail),
+        new_TestFixture(test_txq_add__full_drop_head),
+        new_TestFixture(test_txq_add__full_drop_tail_ctrl),
+        new_TestFixture(test_txq_add__full_drop_head_ctrl),
+        new_TestFixture(test_txq_add__full_of_ctrl),
+    };
+
+    EMB_UNIT_TESTCALLER(netdev2_txq_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netdev2_txq_tests;
+}
+
+void tests_netdev2_txq(void)
+{
+    TESTS_RUN(tests_netdev2_txq_tests());
+}
+/** @} */
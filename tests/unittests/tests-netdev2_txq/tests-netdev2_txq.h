@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``gnrc_netdev2_txq`` module
+ */
+#ifndef TESTS_NETDEV2_TXQ_H_
+#define TESTS_NETDEV2_TXQ_H_
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_netdev2_txq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_NETDEV2_TXQ_H_ */
+/** @} */
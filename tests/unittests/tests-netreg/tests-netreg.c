@@ -22,8 +22,8 @@
 #include "tests-netreg.h"
 
 static gnrc_netreg_entry_t entries[] = {
-    { NULL, TEST_UINT16, TEST_UINT8 },
-    { NULL, TEST_UINT16, TEST_UINT8 + 1 }
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
 static void set_up(void)
@@ -139,6 +139,40 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_num__many_contexts(void)
+{
+    /* more contexts than buckets, so some of them share a bucket */
+    static gnrc_netreg_entry_t many[2 * 4 * GNRC_NETREG_BUCKETS];
+    const unsigned ctxs = sizeof(many) / sizeof(many[0]) / 2;
+
+    for (unsigned i = 0; i < sizeof(many) / sizeof(many[0]); i++) {
+        many[i].demux_ctx = TEST_UINT16 + (i % ctxs);
+        many[i].pid = TEST_UINT8;
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &many[i]));
+    }
+    for (unsigned i = 0; i < ctxs; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + i);
+
+        TEST_ASSERT(res == &many[i + ctxs]);
+        TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_entry_num(res));
+        TEST_ASSERT(gnrc_netreg_getnext(res) == &many[i]);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(&many[i]));
+    }
+    /* remove the first entry of even and the second of odd contexts */
+    for (unsigned i = 0; i < ctxs; i++) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many[(i & 1) ? i : (i + ctxs)]);
+    }
+    for (unsigned i = 0; i < ctxs; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + i);
+
+        TEST_ASSERT(res == &many[(i & 1) ? (i + ctxs) : i]);
+        TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, res);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -153,6 +187,7 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__wrong_type_undef),
         new_TestFixture(test_netreg_num__wrong_type_numof),
         new_TestFixture(test_netreg_num__2_entries),
+        new_TestFixture(test_netreg_num__many_contexts),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
     };
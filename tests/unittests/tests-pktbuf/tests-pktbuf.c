@@ -14,6 +14,7 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/uio.h>
 
 #include "embUnit.h"
@@ -281,7 +282,9 @@ static void test_pktbuf_mark__pkt_NOT_NULL__size_greater_than_pkt_size(void)
 
 static void test_pktbuf_mark__pkt_NOT_NULL__pkt_data_NULL(void)
 {
-    gnrc_pktsnip_t pkt = { 1, NULL, NULL, sizeof(TEST_STRING16), GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .users = 1, .next = NULL, .data = NULL,
+                           .size = sizeof(TEST_STRING16),
+                           .type = GNRC_NETTYPE_TEST };
 
     TEST_ASSERT_NULL(gnrc_pktbuf_mark(&pkt, sizeof(TEST_STRING16) - 1,
                                       GNRC_NETTYPE_TEST));
@@ -567,7 +570,9 @@ static void test_pktbuf_hold__pkt_null(void)
 
 static void test_pktbuf_hold__pkt_external(void)
 {
-    gnrc_pktsnip_t pkt = { 1, NULL, TEST_STRING8, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .users = 1, .next = NULL, .data = TEST_STRING8,
+                           .size = sizeof(TEST_STRING8),
+                           .type = GNRC_NETTYPE_TEST };
 
     gnrc_pktbuf_hold(&pkt, 1);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
@@ -724,6 +729,271 @@ static void test_pktbuf_get_iovec__null(void)
     TEST_ASSERT_EQUAL_INT(0, len);
 }
 
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+static void test_pktbuf_add_headroom__size_0(void)
+{
+    TEST_ASSERT_NULL(gnrc_pktbuf_add_headroom(NULL, NULL, 0, 8, GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_push__contiguous(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr1, *hdr2;
+
+    pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                   24, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    TEST_ASSERT_NOT_NULL((hdr1 = gnrc_pktbuf_push(pkt, TEST_STRING8, 8,
+                                                   GNRC_NETTYPE_TEST)));
+    TEST_ASSERT_NOT_NULL((hdr2 = gnrc_pktbuf_push(hdr1, TEST_STRING16, 16,
+                                                   GNRC_NETTYPE_TEST)));
+    TEST_ASSERT(hdr2->next == hdr1);
+    TEST_ASSERT(hdr1->next == pkt);
+    TEST_ASSERT(((uint8_t *)hdr1->data + 8) == pkt->data);
+    TEST_ASSERT(((uint8_t *)hdr2->data + 16) == hdr1->data);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING8, hdr1->data, 8));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr2->data, 16));
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(hdr2);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_push__no_headroom(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                   8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* does not fit into the headroom */
+    TEST_ASSERT_NOT_NULL((hdr = gnrc_pktbuf_push(pkt, TEST_STRING16, 16,
+                                                  GNRC_NETTYPE_TEST)));
+    TEST_ASSERT(hdr->next == pkt);
+    TEST_ASSERT(((uint8_t *)hdr->data + 16) != pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr->data, 16));
+    /* would not be aligned */
+    TEST_ASSERT_NOT_NULL((hdr = gnrc_pktbuf_push(hdr, TEST_STRING4, 3,
+                                                  GNRC_NETTYPE_TEST)));
+    TEST_ASSERT(((uint8_t *)hdr->data + 3) != hdr->next->data);
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_push__realloc_data(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING64, sizeof(TEST_STRING64),
+                                   16, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL((hdr = gnrc_pktbuf_push(pkt, TEST_STRING16, 16,
+                                                  GNRC_NETTYPE_TEST)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(hdr, 8));
+    TEST_ASSERT_EQUAL_INT(8, hdr->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr->data, 8));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(hdr, 32));
+    TEST_ASSERT_EQUAL_INT(32, hdr->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr->data, 8));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 8));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING64, pkt->data, 8));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, sizeof(TEST_STRING64) * 2));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING64, pkt->data, 8));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_push__mark(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr, *marked;
+
+    pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING64, sizeof(TEST_STRING64),
+                                   16, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_hold(pkt, 1);
+    TEST_ASSERT_NOT_NULL((hdr = gnrc_pktbuf_push(pkt, TEST_STRING16, 16,
+                                                  GNRC_NETTYPE_TEST)));
+    TEST_ASSERT_NOT_NULL((marked = gnrc_pktbuf_mark(hdr, 5, GNRC_NETTYPE_UNDEF)));
+    TEST_ASSERT(hdr->next == marked);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, marked->data, 5));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16 + 5, hdr->data, 11));
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT_EQUAL_INT(1, pkt->users);
+    /* no header uses the headroom anymore, so pkt can be split */
+    TEST_ASSERT_NOT_NULL((marked = gnrc_pktbuf_mark(pkt, 16, GNRC_NETTYPE_UNDEF)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING64, marked->data, 16));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING64 + 16, pkt->data,
+                                    sizeof(TEST_STRING64) - 16));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_push__release_pkt_first(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr1, *hdr2;
+
+    pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                   24, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL((hdr1 = gnrc_pktbuf_push(pkt, TEST_STRING8, 8,
+                                                   GNRC_NETTYPE_TEST)));
+    TEST_ASSERT_NOT_NULL((hdr2 = gnrc_pktbuf_push(hdr1, TEST_STRING16, 16,
+                                                   GNRC_NETTYPE_TEST)));
+    /* both headers keep the chunk of pkt alive */
+    TEST_ASSERT_EQUAL_INT(3, pkt->users);
+    TEST_ASSERT(gnrc_pktbuf_remove_snip(hdr2, pkt) == hdr2);
+    TEST_ASSERT(hdr1->next == NULL);
+    TEST_ASSERT_EQUAL_INT(2, pkt->users);
+    TEST_ASSERT(gnrc_pktbuf_remove_snip(hdr2, hdr1) == hdr2);
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr2->data, 16));
+    gnrc_pktbuf_release(hdr2);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_push__start_write(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr, *copy;
+
+    pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                   16, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL((hdr = gnrc_pktbuf_push(pkt, TEST_STRING16, 16,
+                                                  GNRC_NETTYPE_TEST)));
+    gnrc_pktbuf_hold(hdr, 1);
+    TEST_ASSERT_NOT_NULL((copy = gnrc_pktbuf_start_write(hdr)));
+    TEST_ASSERT(copy != hdr);
+    TEST_ASSERT(copy->next == pkt);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, copy->data, 16));
+    gnrc_pktbuf_release(copy);
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_COW
+static void test_pktbuf_start_write_snip__pkt_users_1(void)
+{
+    gnrc_pktsnip_t *pkt_copy, *pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                                     GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL((pkt_copy = gnrc_pktbuf_start_write_snip(pkt)));
+    TEST_ASSERT(pkt == pkt_copy);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_start_write_snip__pkt_users_2(void)
+{
+    gnrc_pktbuf_cow_stats_t before, after;
+    gnrc_pktsnip_t *hdr, *pkt_copy, *pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                                           GNRC_NETTYPE_TEST);
+
+    gnrc_pktbuf_cow_stats(&before);
+    gnrc_pktbuf_hold(pkt, 1);
+    TEST_ASSERT_NOT_NULL((pkt_copy = gnrc_pktbuf_start_write_snip(pkt)));
+    TEST_ASSERT(pkt != pkt_copy);
+    TEST_ASSERT(pkt->data == pkt_copy->data);
+    TEST_ASSERT_EQUAL_INT(1, pkt_copy->users);
+    gnrc_pktbuf_cow_stats(&after);
+    TEST_ASSERT_EQUAL_INT(1, after.shared - before.shared);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16), after.shared_bytes - before.shared_bytes);
+    TEST_ASSERT_NOT_NULL((hdr = gnrc_pktbuf_mark(pkt_copy, 4, GNRC_NETTYPE_UNDEF)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr->data, 4));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16 + 4, pkt_copy->data,
+                                    sizeof(TEST_STRING16) - 4));
+    /* the original is untouched */
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16), pkt->size);
+    TEST_ASSERT(pkt->next == NULL);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16 + 4, pkt_copy->data);
+    gnrc_pktbuf_release(pkt_copy);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_start_write_snip__start_write(void)
+{
+    gnrc_pktbuf_cow_stats_t before, after;
+    gnrc_pktsnip_t *pkt_copy, *pkt_write, *pkt = gnrc_pktbuf_add(NULL, TEST_STRING16,
+                                                                 sizeof(TEST_STRING16),
+                                                                 GNRC_NETTYPE_TEST);
+
+    gnrc_pktbuf_hold(pkt, 2);
+    TEST_ASSERT_NOT_NULL((pkt_copy = gnrc_pktbuf_start_write_snip(pkt)));
+    /* a duplicate of a duplicate shares the same data */
+    TEST_ASSERT_NOT_NULL((pkt_write = gnrc_pktbuf_start_write_snip(pkt)));
+    TEST_ASSERT(pkt_write->data == pkt->data);
+    gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_cow_stats(&before);
+    TEST_ASSERT(pkt_write == gnrc_pktbuf_start_write(pkt_write));
+    gnrc_pktbuf_cow_stats(&after);
+    TEST_ASSERT_EQUAL_INT(1, after.copied - before.copied);
+    TEST_ASSERT(pkt_write->data != pkt_copy->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt_write->data);
+    ((char *)pkt_write->data)[0] = '\0';
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt_copy->data);
+    gnrc_pktbuf_release(pkt_copy);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt_write, sizeof(TEST_STRING64)));
+    gnrc_pktbuf_release(pkt_write);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_start_write_snip__realloc_data(void)
+{
+    gnrc_pktsnip_t *pkt_copy, *pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                                     GNRC_NETTYPE_TEST);
+
+    gnrc_pktbuf_hold(pkt, 1);
+    TEST_ASSERT_NOT_NULL((pkt_copy = gnrc_pktbuf_start_write_snip(pkt)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt_copy, 8));
+    TEST_ASSERT(pkt->data == pkt_copy->data);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16), pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt_copy, sizeof(TEST_STRING64)));
+    TEST_ASSERT(pkt->data != pkt_copy->data);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, pkt_copy->data, 8));
+    gnrc_pktbuf_release(pkt_copy);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+static void test_pktbuf_start_write_snip__push(void)
+{
+    gnrc_pktsnip_t *pkt, *hdr, *hdr_copy;
+
+    pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                   16, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL((hdr = gnrc_pktbuf_push(pkt, TEST_STRING16, 16,
+                                                  GNRC_NETTYPE_TEST)));
+    /* the header is the only user of its data */
+    TEST_ASSERT(hdr == gnrc_pktbuf_start_write(hdr));
+    gnrc_pktbuf_hold(hdr, 1);
+    TEST_ASSERT_NOT_NULL((hdr_copy = gnrc_pktbuf_start_write_snip(hdr)));
+    TEST_ASSERT(hdr_copy->data == hdr->data);
+    /* the copy keeps the header and thus the chunk of pkt alive */
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING16, hdr_copy->data, 16));
+    gnrc_pktbuf_release(hdr_copy);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+#endif
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -767,6 +1037,24 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_get_iovec__1_elem),
         new_TestFixture(test_pktbuf_get_iovec__3_elem),
         new_TestFixture(test_pktbuf_get_iovec__null),
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        new_TestFixture(test_pktbuf_add_headroom__size_0),
+        new_TestFixture(test_pktbuf_push__contiguous),
+        new_TestFixture(test_pktbuf_push__no_headroom),
+        new_TestFixture(test_pktbuf_push__realloc_data),
+        new_TestFixture(test_pktbuf_push__mark),
+        new_TestFixture(test_pktbuf_push__release_pkt_first),
+        new_TestFixture(test_pktbuf_push__start_write),
+#endif
+#ifdef MODULE_GNRC_PKTBUF_COW
+        new_TestFixture(test_pktbuf_start_write_snip__pkt_users_1),
+        new_TestFixture(test_pktbuf_start_write_snip__pkt_users_2),
+        new_TestFixture(test_pktbuf_start_write_snip__start_write),
+        new_TestFixture(test_pktbuf_start_write_snip__realloc_data),
+#ifdef MODULE_GNRC_PKTBUF_HEADROOM
+        new_TestFixture(test_pktbuf_start_write_snip__push),
+#endif
+#endif
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
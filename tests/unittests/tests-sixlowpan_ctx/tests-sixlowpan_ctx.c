@@ -156,6 +156,30 @@ static void test_sixlowpan_ctx_lookup_addr__other_addr_other_prefix(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+static void test_sixlowpan_ctx_lookup_addr__longest_prefix(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    /* OTHER_TEST_PREFIX shares the first 61 bits with DEFAULT_TEST_PREFIX */
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(OTHER_TEST_ID, &addr, 48,
+                                                   TEST_UINT16, true));
+    test_sixlowpan_ctx_update__success();
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr)));
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    /* shorten the longer context, so the other one becomes the longest */
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(DEFAULT_TEST_ID, &addr, 32,
+                                                   TEST_UINT16, true));
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr)));
+    TEST_ASSERT_EQUAL_INT(OTHER_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    gnrc_sixlowpan_ctx_remove(OTHER_TEST_ID);
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr)));
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_ID,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+}
+
 static void test_sixlowpan_ctx_lookup_id__empty(void)
 {
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_id(DEFAULT_TEST_ID));
@@ -195,6 +219,19 @@ static void test_sixlowpan_ctx_remove(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+static void test_sixlowpan_ctx_generation(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+    uint16_t gen = gnrc_sixlowpan_ctx_generation();
+
+    TEST_ASSERT_EQUAL_INT(gen, gnrc_sixlowpan_ctx_generation());
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_update(DEFAULT_TEST_ID, &addr, 0,
+                                               TEST_UINT16, true));
+    TEST_ASSERT_EQUAL_INT(gen, gnrc_sixlowpan_ctx_generation());
+    test_sixlowpan_ctx_update__success();
+    TEST_ASSERT(gen != gnrc_sixlowpan_ctx_generation());
+}
+
 Test *tests_sixlowpan_ctx_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -207,10 +244,12 @@ Test *tests_sixlowpan_ctx_tests(void)
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__same_addr),
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__other_addr_same_prefix),
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__other_addr_other_prefix),
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr__longest_prefix),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__empty),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__wrong_id),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__success),
         new_TestFixture(test_sixlowpan_ctx_remove),
+        new_TestFixture(test_sixlowpan_ctx_generation),
     };
 
     EMB_UNIT_TESTCALLER(sixlowpan_ctx_tests, NULL, tear_down, fixtures);
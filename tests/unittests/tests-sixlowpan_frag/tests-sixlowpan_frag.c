@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag.h"
+#include "net/sixlowpan.h"
+#include "rbuf.h"
+#include "xtimer.h"
+
+#include "tests-sixlowpan_frag.h"
+
+#define DATAGRAM_SIZE   (64U)
+#define TAG             (0x1234)
+
+static uint32_t netif_buf[(sizeof(gnrc_netif_hdr_t) + 4 + 3) / 4];
+static gnrc_netif_hdr_t *netif_hdr = (gnrc_netif_hdr_t *)netif_buf;
+static gnrc_sixlowpan_frag_stats_t stats;
+
+/* statistics since set_up() */
+#define COMPLETE    (gnrc_sixlowpan_frag_stats()->complete - stats.complete)
+#define DROPS       (gnrc_sixlowpan_frag_stats()->drops - stats.drops)
+#define EVICTIONS   (gnrc_sixlowpan_frag_stats()->evictions - stats.evictions)
+#define TIMEOUTS    (gnrc_sixlowpan_frag_stats()->timeouts - stats.timeouts)
+
+/* receives the fragment of len bytes at offset of a datagram */
+static void _add(uint16_t size, uint16_t tag, uint16_t offset, uint16_t len)
+{
+    size_t hdr_len = (offset == 0) ? (sizeof(sixlowpan_frag_t) + 1) :
+                                     sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, hdr_len + len,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+    sixlowpan_frag_n_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    memset(pkt->data, offset / 8, pkt->size);
+    hdr = pkt->data;
+    hdr->disp_size = byteorder_htons(size);
+    hdr->tag = byteorder_htons(tag);
+    if (offset == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        ((uint8_t *)pkt->data)[sizeof(sixlowpan_frag_t)] = SIXLOWPAN_UNCOMP;
+        rbuf_add(netif_hdr, pkt, pkt->size - sizeof(sixlowpan_frag_t), offset);
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = offset / 8;
+        rbuf_add(netif_hdr, pkt, pkt->size - sizeof(sixlowpan_frag_n_t), offset);
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+static void set_up(void)
+{
+    uint8_t src[] = { 0x00, 0x01 }, dst[] = { 0x00, 0x02 };
+
+    gnrc_pktbuf_init();
+    gnrc_netif_hdr_init(netif_hdr, sizeof(src), sizeof(dst));
+    gnrc_netif_hdr_set_src_addr(netif_hdr, src, sizeof(src));
+    gnrc_netif_hdr_set_dst_addr(netif_hdr, dst, sizeof(dst));
+    memcpy(&stats, gnrc_sixlowpan_frag_stats(), sizeof(stats));
+}
+
+static void tear_down(void)
+{
+    rbuf_reset();
+}
+
+static void test_rbuf_add__complete(void)
+{
+    _add(DATAGRAM_SIZE, TAG, 0, 32);
+    TEST_ASSERT_EQUAL_INT(0, COMPLETE);
+    _add(DATAGRAM_SIZE, TAG, 32, 32);
+    TEST_ASSERT_EQUAL_INT(1, COMPLETE);
+    TEST_ASSERT_EQUAL_INT(0, DROPS);
+    /* the datagram has no receivers, so it is released right away */
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf_add__complete_unordered(void)
+{
+    _add(DATAGRAM_SIZE, TAG, 48, 16);
+    _add(DATAGRAM_SIZE, TAG, 16, 32);
+    _add(DATAGRAM_SIZE, TAG, 0, 16);
+    TEST_ASSERT_EQUAL_INT(1, COMPLETE);
+    TEST_ASSERT_EQUAL_INT(0, DROPS);
+}
+
+static void test_rbuf_add__duplicate(void)
+{
+    _add(DATAGRAM_SIZE, TAG, 0, 32);
+    _add(DATAGRAM_SIZE, TAG, 0, 32);
+    _add(DATAGRAM_SIZE, TAG, 32, 32);
+    TEST_ASSERT_EQUAL_INT(1, COMPLETE);
+    TEST_ASSERT_EQUAL_INT(0, DROPS);
+}
+
+static void test_rbuf_add__duplicate_last(void)
+{
+    /* the last fragment ends within a unit */
+    _add(DATAGRAM_SIZE - 4, TAG, 32, 28);
+    _add(DATAGRAM_SIZE - 4, TAG, 32, 28);
+    TEST_ASSERT_EQUAL_INT(0, DROPS);
+    _add(DATAGRAM_SIZE - 4, TAG, 0, 32);
+    TEST_ASSERT_EQUAL_INT(1, COMPLETE);
+}
+
+static void test_rbuf_add__overlap(void)
+{
+    _add(DATAGRAM_SIZE, TAG, 0, 32);
+    /* overlaps the first fragment partially: the reassembly starts anew
+     * with this fragment */
+    _add(DATAGRAM_SIZE, TAG, 24, 24);
+    TEST_ASSERT_EQUAL_INT(1, DROPS);
+    _add(DATAGRAM_SIZE, TAG, 48, 16);
+    TEST_ASSERT_EQUAL_INT(0, COMPLETE);
+    _add(DATAGRAM_SIZE, TAG, 0, 24);
+    TEST_ASSERT_EQUAL_INT(1, COMPLETE);
+}
+
+static void test_rbuf_add__overlap_same_units(void)
+{
+    _add(DATAGRAM_SIZE, TAG, 32, 32);
+    /* same offset and same 8 byte units, but shorter */
+    _add(DATAGRAM_SIZE, TAG, 32, 28);
+    TEST_ASSERT_EQUAL_INT(1, DROPS);
+    /* the shorter fragment leaves a gap */
+    _add(DATAGRAM_SIZE, TAG, 0, 32);
+    TEST_ASSERT_EQUAL_INT(0, COMPLETE);
+}
+
+static void test_rbuf_add__evict_oldest(void)
+{
+    for (unsigned i = 0; i <= RBUF_SIZE; i++) {
+        _add(DATAGRAM_SIZE, TAG + i, 0, 32);
+    }
+    TEST_ASSERT_EQUAL_INT(1, EVICTIONS);
+    for (unsigned i = RBUF_SIZE; i > 0; i--) {
+        _add(DATAGRAM_SIZE, TAG + i, 32, 32);
+    }
+    TEST_ASSERT_EQUAL_INT(RBUF_SIZE, COMPLETE);
+    /* the oldest datagram is gone, its fragment starts a new reassembly */
+    _add(DATAGRAM_SIZE, TAG, 32, 32);
+    TEST_ASSERT_EQUAL_INT(RBUF_SIZE, COMPLETE);
+    TEST_ASSERT_EQUAL_INT(1, EVICTIONS);
+}
+
+static void test_rbuf_add__evict_budget(void)
+{
+    const uint16_t size = (RBUF_MEM_BUDGET / 2) + 8;
+
+    _add(size, TAG, 0, 32);
+    _add(size, TAG + 1, 0, 32);
+    TEST_ASSERT_EQUAL_INT(1, EVICTIONS);
+    _add(size, TAG + 1, 32, size - 32);
+    TEST_ASSERT_EQUAL_INT(1, COMPLETE);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rbuf_add__timeout(void)
+{
+    _add(DATAGRAM_SIZE, TAG, 0, 32);
+    xtimer_usleep(RBUF_TIMEOUT + (RBUF_TIMEOUT / 2));
+    _add(DATAGRAM_SIZE, TAG + 1, 0, 32);
+    TEST_ASSERT_EQUAL_INT(1, TIMEOUTS);
+    /* a late fragment starts a new reassembly */
+    _add(DATAGRAM_SIZE, TAG, 32, 32);
+    TEST_ASSERT_EQUAL_INT(0, COMPLETE);
+    _add(DATAGRAM_SIZE, TAG + 1, 32, 32);
+    TEST_ASSERT_EQUAL_INT(1, COMPLETE);
+}
+
+Test *tests_sixlowpan_frag_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rbuf_add__complete),
+        new_TestFixture(test_rbuf_add__complete_unordered),
+        new_TestFixture(test_rbuf_add__duplicate),
+        new_TestFixture(test_rbuf_add__duplicate_last),
+        new_TestFixture(test_rbuf_add__overlap),
+        new_TestFixture(test_rbuf_add__overlap_same_units),
+        new_TestFixture(test_rbuf_add__evict_oldest),
+        new_TestFixture(test_rbuf_add__evict_budget),
+        new_TestFixture(test_rbuf_add__timeout),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlowpan_frag_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&sixlowpan_frag_tests;
+}
+
+void tests_sixlowpan_frag(void)
+{
+    TESTS_RUN(tests_sixlowpan_frag_tests());
+}
+/** @} */
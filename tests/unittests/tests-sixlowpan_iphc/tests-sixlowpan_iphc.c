@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+
+#include "unittests-constants.h"
+#include "tests-sixlowpan_iphc.h"
+
+#define TEST_IFACE          (6)
+#define TEST_PAYLOAD_LEN    (4)
+#define TEST_LTIME          (UINT16_MAX)
+
+#define IPHC1_IDX           (0U)
+#define IPHC2_IDX           (1U)
+#define CID_EXT_IDX         (2U)
+
+/* the IIDs derived from these are ::1 and ::2 */
+static uint8_t _src_l2[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static uint8_t _dst_l2[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 };
+static const uint8_t _payload[TEST_PAYLOAD_LEN] = { 0xde, 0xad, 0xbe, 0xef };
+
+static uint8_t _iphc[64];
+static size_t _iphc_len;
+static ipv6_hdr_t _dec;
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    gnrc_sixlowpan_iphc_cache_flush();
+#endif
+}
+
+static void tear_down(void)
+{
+    gnrc_sixlowpan_ctx_reset();
+}
+
+static void _init_hdr(ipv6_hdr_t *hdr, const char *src, const char *dst)
+{
+    memset(hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(TEST_PAYLOAD_LEN);
+    hdr->nh = PROTNUM_IPV6_NONXT;
+    hdr->hl = 64;
+    TEST_ASSERT_NOT_NULL(ipv6_addr_from_str(&hdr->src, src));
+    TEST_ASSERT_NOT_NULL(ipv6_addr_from_str(&hdr->dst, dst));
+}
+
+/* encodes hdr, then decodes the frame into a header that is not zeroed before.
+ * The IPHC header is kept in _iphc, the decoded header in _dec */
+static void _round_trip(ipv6_hdr_t *hdr)
+{
+    uint8_t garbage[GNRC_SIXLOWPAN_IPHC_DEC_HDR_LEN];
+    gnrc_pktsnip_t *pkt, *netif, *frame, *dec_hdr, *ipv6;
+    size_t nh_len = 0;
+
+    pkt = gnrc_pktbuf_add(NULL, (void *)_payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    pkt = gnrc_pktbuf_add(pkt, hdr, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(pkt);
+    netif = gnrc_netif_hdr_build(_src_l2, sizeof(_src_l2),
+                                 _dst_l2, sizeof(_dst_l2));
+    TEST_ASSERT_NOT_NULL(netif);
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = TEST_IFACE;
+    netif->next = pkt;
+
+    TEST_ASSERT(gnrc_sixlowpan_iphc_encode(netif));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_SIXLOWPAN, netif->next->type);
+    TEST_ASSERT(netif->next->size <= sizeof(_iphc));
+    _iphc_len = netif->next->size;
+    memcpy(_iphc, netif->next->data, _iphc_len);
+
+    /* received frame: IPHC header and payload in one snip */
+    frame = gnrc_pktbuf_add(NULL, NULL, gnrc_pkt_len(netif->next),
+                            GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(frame);
+    memcpy(frame->data, _iphc, _iphc_len);
+    memcpy((uint8_t *)frame->data + _iphc_len, _payload, sizeof(_payload));
+    gnrc_pktbuf_release(netif->next);
+    netif->next = NULL;
+    frame->next = netif;
+
+    memset(garbage, 0xff, sizeof(garbage));
+    dec_hdr = gnrc_pktbuf_add(NULL, garbage, sizeof(garbage), GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(dec_hdr);
+    TEST_ASSERT_EQUAL_INT(_iphc_len,
+                          gnrc_sixlowpan_iphc_decode(&dec_hdr, frame, 0, 0,
+                                                     &nh_len));
+    ipv6 = gnrc_pktsnip_search_type(dec_hdr, GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    memcpy(&_dec, ipv6->data, sizeof(ipv6_hdr_t));
+
+    gnrc_pktbuf_release(dec_hdr);
+    gnrc_pktbuf_release(frame);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_iphc_round_trip__flow_label(void)
+{
+    ipv6_hdr_t hdr;
+
+    _init_hdr(&hdr, "fe80::1", "fe80::2");
+    ipv6_hdr_set_fl(&hdr, 0x12345);
+    _round_trip(&hdr);
+    /* ECN + flow label, the last byte of the flow label was dropped */
+    TEST_ASSERT_EQUAL_INT(0x08, _iphc[IPHC1_IDX] & SIXLOWPAN_IPHC1_TF);
+    TEST_ASSERT_EQUAL_INT(0x12345, ipv6_hdr_get_fl(&_dec));
+    TEST_ASSERT(memcmp(&hdr, &_dec, sizeof(ipv6_hdr_t)) == 0);
+}
+
+static void test_iphc_round_trip__flow_label_tc(void)
+{
+    ipv6_hdr_t hdr;
+
+    _init_hdr(&hdr, "fe80::1", "fe80::2");
+    ipv6_hdr_set_tc(&hdr, 0xb9);
+    ipv6_hdr_set_fl(&hdr, 0xabcde);
+    _round_trip(&hdr);
+    /* ECN + DSCP + flow label */
+    TEST_ASSERT_EQUAL_INT(0x00, _iphc[IPHC1_IDX] & SIXLOWPAN_IPHC1_TF);
+    TEST_ASSERT_EQUAL_INT(0xb9, ipv6_hdr_get_tc(&_dec));
+    TEST_ASSERT_EQUAL_INT(0xabcde, ipv6_hdr_get_fl(&_dec));
+    TEST_ASSERT(memcmp(&hdr, &_dec, sizeof(ipv6_hdr_t)) == 0);
+}
+
+static void test_iphc_round_trip__src_non_comp_ctx(void)
+{
+    ipv6_addr_t prefix;
+    ipv6_hdr_t hdr;
+
+    /* a context only valid for decompression must not be used to compress,
+     * and without SAC the address would be decoded as link-local */
+    ipv6_addr_from_str(&prefix, "2001:db8::");
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(0, &prefix, 64, TEST_LTIME,
+                                                   false));
+    _init_hdr(&hdr, "2001:db8::1", "fe80::2");
+    _round_trip(&hdr);
+    TEST_ASSERT_EQUAL_INT(0, _iphc[IPHC2_IDX] & (SIXLOWPAN_IPHC2_SAC |
+                                                 SIXLOWPAN_IPHC2_SAM));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.src, &_dec.src));
+    TEST_ASSERT(memcmp(&hdr, &_dec, sizeof(ipv6_hdr_t)) == 0);
+}
+
+static void test_iphc_round_trip__ctx_overlaps_iid(void)
+{
+    ipv6_addr_t prefix;
+    ipv6_hdr_t hdr;
+
+    /* the context covers the first 16 bits of the IID, the rest is derived
+     * from the link-layer address */
+    ipv6_addr_from_str(&prefix, "2001:db8::1234:0:0:0");
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(0, &prefix, 80, TEST_LTIME,
+                                                   true));
+    _init_hdr(&hdr, "2001:db8::1234:0:0:1", "fe80::2");
+    _round_trip(&hdr);
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_IPHC2_SAC | SIXLOWPAN_IPHC2_SAM,
+                          _iphc[IPHC2_IDX] & (SIXLOWPAN_IPHC2_SAC |
+                                              SIXLOWPAN_IPHC2_SAM));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.src, &_dec.src));
+    TEST_ASSERT(memcmp(&hdr, &_dec, sizeof(ipv6_hdr_t)) == 0);
+}
+
+static void test_iphc_round_trip__ucast_prefix_mcast(void)
+{
+    ipv6_addr_t prefix;
+    ipv6_hdr_t hdr;
+
+    /* source and destination use different contexts, the one of the
+     * destination needs the CID extension */
+    ipv6_addr_from_str(&prefix, "2001:db8:1::");
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(0, &prefix, 64, TEST_LTIME,
+                                                   true));
+    ipv6_addr_from_str(&prefix, "2001:db8:2::");
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(3, &prefix, 64, TEST_LTIME,
+                                                   true));
+    _init_hdr(&hdr, "2001:db8:1::1", "ff3e:40:2001:db8:2:0:1234:5678");
+    _round_trip(&hdr);
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_IPHC2_CID_EXT, _iphc[IPHC2_IDX] &
+                          SIXLOWPAN_IPHC2_CID_EXT);
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_IPHC2_M | SIXLOWPAN_IPHC2_DAC,
+                          _iphc[IPHC2_IDX] & (SIXLOWPAN_IPHC2_M |
+                                              SIXLOWPAN_IPHC2_DAC |
+                                              SIXLOWPAN_IPHC2_DAM));
+    TEST_ASSERT_EQUAL_INT(0x03, _iphc[CID_EXT_IDX]);
+    /* dispatch, CID, next header, flags and scope, reserved, group ID */
+    TEST_ASSERT_EQUAL_INT(2 + 1 + 1 + 2 + 4, _iphc_len);
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &_dec.dst));
+    TEST_ASSERT(memcmp(&hdr, &_dec, sizeof(ipv6_hdr_t)) == 0);
+}
+
+static void test_iphc_round_trip__ctx_short_prefix(void)
+{
+    ipv6_addr_t prefix;
+    ipv6_hdr_t hdr;
+
+    /* the bits between the prefix and the IID must be decoded as 0 */
+    ipv6_addr_from_str(&prefix, "2001:db8::");
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(0, &prefix, 32, TEST_LTIME,
+                                                   true));
+    _init_hdr(&hdr, "2001:db8::1", "2001:db8::5:6:7:8");
+    _round_trip(&hdr);
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_IPHC2_SAC | SIXLOWPAN_IPHC2_SAM,
+                          _iphc[IPHC2_IDX] & (SIXLOWPAN_IPHC2_SAC |
+                                              SIXLOWPAN_IPHC2_SAM));
+    TEST_ASSERT_EQUAL_INT(SIXLOWPAN_IPHC2_DAC | 0x01,
+                          _iphc[IPHC2_IDX] & (SIXLOWPAN_IPHC2_M |
+                                              SIXLOWPAN_IPHC2_DAC |
+                                              SIXLOWPAN_IPHC2_DAM));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.src, &_dec.src));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &_dec.dst));
+    TEST_ASSERT(memcmp(&hdr, &_dec, sizeof(ipv6_hdr_t)) == 0);
+}
+
+Test *tests_sixlowpan_iphc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_iphc_round_trip__flow_label),
+        new_TestFixture(test_iphc_round_trip__flow_label_tc),
+        new_TestFixture(test_iphc_round_trip__src_non_comp_ctx),
+        new_TestFixture(test_iphc_round_trip__ctx_overlaps_iid),
+        new_TestFixture(test_iphc_round_trip__ucast_prefix_mcast),
+        new_TestFixture(test_iphc_round_trip__ctx_short_prefix),
+    };
+
+    EMB_UNIT_TESTCALLER(sixlowpan_iphc_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&sixlowpan_iphc_tests;
+}
+
+void tests_sixlowpan_iphc(void)
+{
+    TESTS_RUN(tests_sixlowpan_iphc_tests());
+}
+/** @} */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "tsrb.h"
+#include "tests-tsrb.h"
+
+#define BUF_SIZE    (16U)
+
+static char _mem[BUF_SIZE];
+static tsrb_t _rb;
+
+static void set_up(void)
+{
+    memset(_mem, 0, sizeof(_mem));
+    tsrb_init(&_rb, _mem, sizeof(_mem));
+}
+
+static void test_tsrb_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_avail(&_rb));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, tsrb_free(&_rb));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_get_one(&_rb));
+}
+
+static void test_tsrb_add_one__get_one(void)
+{
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_rb, (char)(0xf0 + i)));
+    }
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_add_one(&_rb, 'x'));
+    for (unsigned i = 0; i < BUF_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0xf0 + i, tsrb_get_one(&_rb));
+    }
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_rb));
+}
+
+static void test_tsrb_add__get_wrap(void)
+{
+    const char data[] = "0123456789abcdef";
+    char out[BUF_SIZE];
+
+    /* move read and write position to the middle of the buffer */
+    TEST_ASSERT_EQUAL_INT(10, tsrb_add(&_rb, data, 10));
+    TEST_ASSERT_EQUAL_INT(10, tsrb_get(&_rb, out, 10));
+
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, tsrb_add(&_rb, data, BUF_SIZE + 1));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_add(&_rb, data, 1));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, tsrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, out, BUF_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_get(&_rb, out, sizeof(out)));
+}
+
+static void test_tsrb_add_reserve__commit(void)
+{
+    char *ptr;
+    char out[BUF_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(12, tsrb_add(&_rb, "0123456789ab", 12));
+    TEST_ASSERT_EQUAL_INT(8, tsrb_get(&_rb, out, 8));
+
+    /* only the region up to the end of the buffer is contiguous */
+    TEST_ASSERT_EQUAL_INT(4, tsrb_add_reserve(&_rb, &ptr));
+    TEST_ASSERT(ptr == &_mem[12]);
+    memcpy(ptr, "cdef", 4);
+    tsrb_add_commit(&_rb, 4);
+    TEST_ASSERT_EQUAL_INT(8, tsrb_avail(&_rb));
+
+    TEST_ASSERT_EQUAL_INT(8, tsrb_add_reserve(&_rb, &ptr));
+    TEST_ASSERT(ptr == &_mem[0]);
+    memcpy(ptr, "gh", 2);
+    tsrb_add_commit(&_rb, 2);
+
+    TEST_ASSERT_EQUAL_INT(10, tsrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("89abcdefgh", out, 10));
+}
+
+static void test_tsrb_get_reserve__commit(void)
+{
+    char *ptr;
+    char out[BUF_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_get_reserve(&_rb, &ptr));
+    TEST_ASSERT_EQUAL_INT(14, tsrb_add(&_rb, "0123456789abcd", 14));
+    TEST_ASSERT_EQUAL_INT(10, tsrb_get(&_rb, out, 10));
+    TEST_ASSERT_EQUAL_INT(6, tsrb_add(&_rb, "efghij", 6));
+
+    TEST_ASSERT_EQUAL_INT(6, tsrb_get_reserve(&_rb, &ptr));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("abcdef", ptr, 6));
+    tsrb_get_commit(&_rb, 3);
+    TEST_ASSERT_EQUAL_INT(3, tsrb_get_reserve(&_rb, &ptr));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("def", ptr, 3));
+    tsrb_get_commit(&_rb, 3);
+    TEST_ASSERT_EQUAL_INT(4, tsrb_get_reserve(&_rb, &ptr));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("ghij", ptr, 4));
+    tsrb_get_commit(&_rb, 4);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_rb));
+}
+
+Test *tests_tsrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tsrb_init),
+        new_TestFixture(test_tsrb_add_one__get_one),
+        new_TestFixture(test_tsrb_add__get_wrap),
+        new_TestFixture(test_tsrb_add_reserve__commit),
+        new_TestFixture(test_tsrb_get_reserve__commit),
+    };
+
+    EMB_UNIT_TESTCALLER(tsrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tsrb_tests;
+}
+
+void tests_tsrb(void)
+{
+    TESTS_RUN(tests_tsrb_tests());
+}
+/** @} */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       xtimer insertion/removal benchmark
+ *
+ * Arms 1k to 10k timers with pseudo-random offsets, removes them again in a
+ * different order and prints the average and worst case duration of
+ * xtimer_set() and xtimer_remove(). The worst case roughly corresponds to the
+ * longest window xtimer runs with interrupts disabled.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "benchmark.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define MAX_TIMERS      (10000U)
+/* timers are set far enough in the future to never fire during a run */
+#define MIN_OFFSET      (10U * SEC_IN_USEC)
+#define OFFSET_RANGE    (100U * SEC_IN_USEC)
+/* removes with a stride co-prime to numof to not just pop list heads */
+#define REMOVE_STRIDE   (7919U)
+
+static const unsigned numofs[] = { 1000, 2000, 5000, 10000 };
+
+static xtimer_t timers[MAX_TIMERS];
+static uint32_t offsets[MAX_TIMERS];
+static uint32_t worst;
+
+static void _callback(void *arg)
+{
+    printf("ERROR: timer %u fired\n", (unsigned)(uintptr_t)arg);
+}
+
+static void _update_worst(uint32_t start)
+{
+    uint32_t diff = xtimer_now() - start;
+
+    if (diff > worst) {
+        worst = diff;
+    }
+}
+
+static void _set(unsigned i)
+{
+    uint32_t start = xtimer_now();
+
+    xtimer_set(&timers[i], offsets[i]);
+    _update_worst(start);
+}
+
+static void _remove(unsigned i)
+{
+    uint32_t start = xtimer_now();
+
+    xtimer_remove(&timers[i]);
+    _update_worst(start);
+}
+
+static void _run(unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        timers[i].callback = _callback;
+        timers[i].arg = (void *)(uintptr_t)i;
+        timers[i].target = timers[i].long_target = 0;
+        offsets[i] = random_uint32_range(MIN_OFFSET, MIN_OFFSET + OFFSET_RANGE);
+    }
+
+    printf("%u timers:\n", numof);
+    worst = 0;
+    BENCHMARK_FUNC("set", numof, _set(i));
+    printf("%14s worst case %" PRIu32 " us\n", "set", worst);
+    worst = 0;
+    BENCHMARK_FUNC("remove", numof, _remove((i * REMOVE_STRIDE) % numof));
+    printf("%14s worst case %" PRIu32 " us\n", "remove", worst);
+}
+
+int main(void)
+{
+#ifdef MODULE_XTIMER_WHEEL
+    puts("xtimer benchmark (timing wheel backend)");
+#else
+    puts("xtimer benchmark (sorted list backend)");
+#endif
+
+    for (unsigned i = 0; i < sizeof(numofs) / sizeof(numofs[0]); i++) {
+        _run(numofs[i]);
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -38,6 +38,7 @@ int main(void)
         msg_t msg[NUMOF];
         for (unsigned int i = 0; i < NUMOF; i++) {
             msg[i].type = i;
+            timers[i].target = timers[i].long_target = 0;
             xtimer_set_msg(&timers[i], 100000*(i+1), &msg[i], me);
         }
 